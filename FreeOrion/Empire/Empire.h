@@ -3,6 +3,7 @@
 #define _Empire_h_
 
 #include "ResourcePool.h"
+#include "SupplyPropagator.h"
 #include "../util/Export.h"
 #include "../universe/Meter.h"
 
@@ -657,6 +658,7 @@ private:
     std::map<int, std::set<int> >   m_pending_system_exit_lanes;            ///< pending updates to m_available_system_exit_lanes
     std::set<int>                   m_fleet_supplyable_system_ids;          ///< ids of systems where fleets can remain for a turn to be resupplied.
     std::set<std::set<int> >        m_resource_supply_groups;               ///< sets of system ids that are connected by supply lines and are able to share resources between systems or between objects in systems
+    SupplyPropagator                m_supply_propagator;                    ///< keeps the reach of supply sources between calls to UpdateSupply, so unchanged parts of the supply network needn't be propagated again
 
     friend class boost::serialization::access;
     Empire();
@@ -0,0 +1,250 @@
+#include "SupplyPropagator.h"
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+#include <deque>
+
+namespace {
+    /** Disjoint sets of system ids, for merging systems that can share
+      * resources into groups. */
+    class SystemUnionFind {
+    public:
+        void    Add(int system_id)
+        { m_parents.insert(std::make_pair(system_id, system_id)); }
+
+        int     Find(int system_id) {
+            int root = system_id;
+            while (m_parents[root] != root)
+                root = m_parents[root];
+            // point everything on the way directly at the root
+            while (m_parents[system_id] != root) {
+                int next = m_parents[system_id];
+                m_parents[system_id] = root;
+                system_id = next;
+            }
+            return root;
+        }
+
+        void    Union(int system1_id, int system2_id) {
+            int root1 = Find(system1_id);
+            int root2 = Find(system2_id);
+            if (root1 != root2)
+                m_parents[root2] = root1;
+        }
+
+        /** Returns the sets of systems that have been joined together. */
+        std::set<std::set<int> >    Groups() {
+            std::map<int, std::set<int> > groups_by_root;
+            for (boost::unordered_map<int, int>::const_iterator it = m_parents.begin(); it != m_parents.end(); ++it)
+                groups_by_root[Find(it->first)].insert(it->first);
+
+            std::set<std::set<int> > retval;
+            for (std::map<int, std::set<int> >::const_iterator it = groups_by_root.begin(); it != groups_by_root.end(); ++it)
+                retval.insert(it->second);
+            return retval;
+        }
+
+    private:
+        boost::unordered_map<int, int> m_parents;
+    };
+
+    /** Inserts into \a changed_systems the ids of systems that are in only one
+      * of \a lhs and \a rhs. */
+    void InsertChangedSystems(const std::set<int>& lhs, const std::set<int>& rhs,
+                              boost::unordered_set<int>& changed_systems)
+    {
+        std::set<int>::const_iterator lhs_it = lhs.begin(), rhs_it = rhs.begin();
+        while (lhs_it != lhs.end() || rhs_it != rhs.end()) {
+            if (rhs_it == rhs.end() || (lhs_it != lhs.end() && *lhs_it < *rhs_it)) {
+                changed_systems.insert(*lhs_it++);
+            } else if (lhs_it == lhs.end() || *rhs_it < *lhs_it) {
+                changed_systems.insert(*rhs_it++);
+            } else {
+                ++lhs_it;
+                ++rhs_it;
+            }
+        }
+    }
+
+    /** Inserts into \a changed_systems the ids of systems whose starlanes
+      * differ between \a lhs and \a rhs. */
+    void InsertChangedSystems(const std::map<int, std::set<int> >& lhs, const std::map<int, std::set<int> >& rhs,
+                              boost::unordered_set<int>& changed_systems)
+    {
+        std::map<int, std::set<int> >::const_iterator lhs_it = lhs.begin(), rhs_it = rhs.begin();
+        while (lhs_it != lhs.end() || rhs_it != rhs.end()) {
+            if (rhs_it == rhs.end() || (lhs_it != lhs.end() && lhs_it->first < rhs_it->first)) {
+                changed_systems.insert((lhs_it++)->first);
+            } else if (lhs_it == lhs.end() || rhs_it->first < lhs_it->first) {
+                changed_systems.insert((rhs_it++)->first);
+            } else {
+                if (lhs_it->second != rhs_it->second)
+                    changed_systems.insert(lhs_it->first);
+                ++lhs_it;
+                ++rhs_it;
+            }
+        }
+    }
+}
+
+void SupplyPropagator::Update(const std::map<int, int>& supply_system_ranges,
+                              const std::set<int>& unobstructed_systems,
+                              const std::map<int, std::set<int> >& starlanes,
+                              std::set<std::pair<int, int> >& traversals,
+                              std::set<std::pair<int, int> >& obstructed_traversals,
+                              std::set<int>& fleet_supplyable_systems,
+                              std::set<std::set<int> >& resource_supply_groups)
+{
+    // Please also update PythonEmpireWrapper.cpp:CalculateSupplyUpdate if there is a change to the supply propagation rules:
+    // (i) there is a set of supply sources in systems, (ii) propagating supply drops one per starlane jump, (iii) propagation is blocked
+    // into and out of any systems not in SupplyUnobstructedSystems, and (iv) a system gets the highest supply thus available to it.
+
+    traversals.clear();
+    obstructed_traversals.clear();
+    fleet_supplyable_systems.clear();
+    resource_supply_groups.clear();
+
+    // find systems whose obstruction or starlanes changed since the last
+    // update, which may change the reach of sources that considered them
+    boost::unordered_set<int> changed_systems;
+    InsertChangedSystems(m_unobstructed_systems, unobstructed_systems, changed_systems);
+    InsertChangedSystems(m_starlanes, starlanes, changed_systems);
+    if (!changed_systems.empty()) {
+        m_unobstructed_systems = unobstructed_systems;
+        m_starlanes = starlanes;
+    }
+
+    // supply range of each system that has any, after propagation.  sources
+    // in obstructed systems don't propagate supply, and have no range
+    std::map<int, int> propagated_ranges;
+    std::map<int, SourceReach> source_reaches;
+    for (std::map<int, int>::const_iterator it = supply_system_ranges.begin();
+         it != supply_system_ranges.end(); ++it)
+    {
+        int source_id = it->first;
+        if (unobstructed_systems.find(source_id) == unobstructed_systems.end()) {
+            propagated_ranges.insert(std::make_pair(source_id, 0));
+            continue;
+        }
+
+        // reuse the reach from the previous update if nothing it depends on changed
+        SourceReach& reach = source_reaches[source_id];
+        std::map<int, SourceReach>::iterator cached_it = m_source_reaches.find(source_id);
+        bool cached = cached_it != m_source_reaches.end() && cached_it->second.range == it->second;
+        if (cached) {
+            const std::vector<int>& considered_systems = cached_it->second.considered_systems;
+            for (std::vector<int>::const_iterator sys_it = considered_systems.begin();
+                 cached && sys_it != considered_systems.end(); ++sys_it)
+            { cached = changed_systems.find(*sys_it) == changed_systems.end(); }
+        }
+        if (cached)
+            std::swap(reach, cached_it->second);
+        else
+            CalculateReach(source_id, it->second, unobstructed_systems, starlanes, reach);
+
+        for (std::vector<std::pair<int, int> >::const_iterator sys_it = reach.system_ranges.begin();
+             sys_it != reach.system_ranges.end(); ++sys_it)
+        {
+            std::map<int, int>::iterator range_it = propagated_ranges.find(sys_it->first);
+            if (range_it == propagated_ranges.end())
+                propagated_ranges.insert(range_it, *sys_it);
+            else if (range_it->second < sys_it->second)
+                range_it->second = sys_it->second;
+        }
+    }
+    // forget sources that no longer exist
+    m_source_reaches.swap(source_reaches);
+
+    // every system with supply can share resources within itself, and with
+    // other systems it is connected to by supply traversals
+    SystemUnionFind supply_groups;
+    for (std::map<int, int>::const_iterator it = propagated_ranges.begin(); it != propagated_ranges.end(); ++it)
+        supply_groups.Add(it->first);
+
+    for (std::map<int, int>::const_iterator it = propagated_ranges.begin(); it != propagated_ranges.end(); ++it) {
+        int sys_id = it->first;
+        int range = it->second;
+        if (range <= 0)
+            continue;   // can't propagate supply out a system that has no range
+
+        // any system with nonzero fleet supply range can provide fleet supply
+        fleet_supplyable_systems.insert(sys_id);
+
+        std::map<int, std::set<int> >::const_iterator system_it = starlanes.find(sys_id);
+        if (system_it == starlanes.end())
+            continue;   // no starlanes out of this system
+
+        for (std::set<int>::const_iterator lane_it = system_it->second.begin();
+             lane_it != system_it->second.end(); ++lane_it)
+        {
+            int lane_end_sys_id = *lane_it;
+            if (unobstructed_systems.find(lane_end_sys_id) == unobstructed_systems.end()) {
+                obstructed_traversals.insert(std::make_pair(sys_id, lane_end_sys_id));
+                continue;
+            }
+
+            // can supply fleets here
+            fleet_supplyable_systems.insert(lane_end_sys_id);
+
+            // supply reached the next system from this one with one less
+            // range, so it has a range.  traversals towards systems with the
+            // same or less range show redundancies in the supply network
+            std::map<int, int>::const_iterator lane_end_it = propagated_ranges.find(lane_end_sys_id);
+            if (lane_end_it == propagated_ranges.end() || lane_end_it->second > range)
+                continue;
+            traversals.insert(std::make_pair(sys_id, lane_end_sys_id));
+            supply_groups.Union(sys_id, lane_end_sys_id);
+        }
+    }
+
+    resource_supply_groups = supply_groups.Groups();
+}
+
+void SupplyPropagator::Clear() {
+    m_source_reaches.clear();
+    m_unobstructed_systems.clear();
+    m_starlanes.clear();
+}
+
+void SupplyPropagator::CalculateReach(int source_id, int range, const std::set<int>& unobstructed_systems,
+                                      const std::map<int, std::set<int> >& starlanes, SourceReach& reach) const
+{
+    reach = SourceReach();
+    reach.range = range;
+
+    // breadth first search out from the source, until the range runs out
+    boost::unordered_map<int, int> ranges;
+    std::deque<int> systems_to_propagate_from;
+    ranges[source_id] = range;
+    reach.system_ranges.push_back(std::make_pair(source_id, range));
+    reach.considered_systems.push_back(source_id);
+    systems_to_propagate_from.push_back(source_id);
+
+    while (!systems_to_propagate_from.empty()) {
+        int cur_sys_id = systems_to_propagate_from.front();
+        systems_to_propagate_from.pop_front();
+        int cur_sys_range = ranges[cur_sys_id];
+        if (cur_sys_range <= 0)
+            continue;
+
+        std::map<int, std::set<int> >::const_iterator system_it = starlanes.find(cur_sys_id);
+        if (system_it == starlanes.end())
+            continue;
+
+        for (std::set<int>::const_iterator lane_it = system_it->second.begin();
+             lane_it != system_it->second.end(); ++lane_it)
+        {
+            int lane_end_sys_id = *lane_it;
+            if (ranges.find(lane_end_sys_id) != ranges.end())
+                continue;   // already reached with at least as much range
+            reach.considered_systems.push_back(lane_end_sys_id);
+            if (unobstructed_systems.find(lane_end_sys_id) == unobstructed_systems.end())
+                continue;
+
+            ranges[lane_end_sys_id] = cur_sys_range - 1;
+            reach.system_ranges.push_back(std::make_pair(lane_end_sys_id, cur_sys_range - 1));
+            systems_to_propagate_from.push_back(lane_end_sys_id);
+        }
+    }
+}
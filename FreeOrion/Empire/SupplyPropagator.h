@@ -0,0 +1,64 @@
+// -*- C++ -*-
+#ifndef _SupplyPropagator_h_
+#define _SupplyPropagator_h_
+
+#include "../util/Export.h"
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+/** Propagates supply for an empire from the systems that are sources of
+  * supply to the systems in range of them, along starlanes and through
+  * systems that don't obstruct supply.
+  *
+  * How far supply propagates from each source depends only on that source's
+  * range and the starlanes and obstruction of the systems near it, and the
+  * supply range of a system is the largest range left from any source that
+  * reaches it.  The reach of each source is kept between updates, and is only
+  * recomputed if the source's range changed, or the starlanes or obstruction
+  * of any of the systems it considered changed. */
+class FO_COMMON_API SupplyPropagator {
+public:
+    /** Calculates the results of propagating supply from the sources in
+      * \a supply_system_ranges, along \a starlanes, through the systems in
+      * \a unobstructed_systems.  The previous contents of the result
+      * parameters are replaced:
+      *  - \a traversals: directed starlane traversals along which supply flows
+      *  - \a obstructed_traversals: traversals along which supply would flow
+      *    if the destination system didn't obstruct it
+      *  - \a fleet_supplyable_systems: systems in which fleets are supplied
+      *  - \a resource_supply_groups: sets of systems that can share resources */
+    void    Update(const std::map<int, int>& supply_system_ranges,
+                   const std::set<int>& unobstructed_systems,
+                   const std::map<int, std::set<int> >& starlanes,
+                   std::set<std::pair<int, int> >& traversals,
+                   std::set<std::pair<int, int> >& obstructed_traversals,
+                   std::set<int>& fleet_supplyable_systems,
+                   std::set<std::set<int> >& resource_supply_groups);
+
+    /** Forgets the reach of all sources. */
+    void    Clear();
+
+private:
+    /** The systems supply from a source reaches, with the range left in each,
+      * and the ids of the systems whose starlanes or obstruction determined
+      * that reach. */
+    struct SourceReach {
+        SourceReach() : range(0) {}
+
+        int                                 range;
+        std::vector<std::pair<int, int> >   system_ranges;
+        std::vector<int>                    considered_systems;
+    };
+
+    void    CalculateReach(int source_id, int range, const std::set<int>& unobstructed_systems,
+                           const std::map<int, std::set<int> >& starlanes, SourceReach& reach) const;
+
+    std::map<int, SourceReach>      m_source_reaches;       ///< reach of each unobstructed source, indexed by system id
+    std::set<int>                   m_unobstructed_systems; ///< unobstructed systems as of the previous update
+    std::map<int, std::set<int> >   m_starlanes;            ///< starlanes as of the previous update
+};
+
+#endif // _SupplyPropagator_h_
@@ -6,6 +6,7 @@
 #include "../../util/OptionsDB.h"
 #include "../../util/Directories.h"
 #include "../../util/Serialize.h"
+#include "../../util/ScopedTimer.h"
 #include "../../network/Message.h"
 #include "../util/Random.h"
 
@@ -152,6 +153,7 @@ void AIClientApp::HandleMessage(const Message& msg) {
             bool state_string_available;    // ignored, as save_state_string is sent even if not set by ExtractMessageData
             std::string save_state_string;
             m_player_status.clear();
+            m_last_turn_update.clear(); // the first turn update of a game is never delta encoded
 
             ExtractMessageData(msg,                     single_player_game,     m_empire_id,
                                m_current_turn,          m_empires,              m_universe,
@@ -238,12 +240,24 @@ void AIClientApp::HandleMessage(const Message& msg) {
 
     case Message::TURN_UPDATE: {
         if (msg.SendingPlayer() == Networking::INVALID_PLAYER_ID) {
-            //Logger().debugStream() << "AIClientApp::HandleMessage : extracting turn update message data";
-            ExtractMessageData(msg,                     m_empire_id,        m_current_turn,
-                               m_empires,               m_universe,         GetSpeciesManager(),
-                               GetCombatLogManager(),   m_player_info);
+            {
+                // measures the latency from receiving the turn update until
+                // the AI can start generating orders
+                ScopedTimer timer("AI turn start", true);
+                //Logger().debugStream() << "AIClientApp::HandleMessage : extracting turn update message data";
+                try {
+                    ExtractMessageData(msg,                     m_empire_id,        m_current_turn,
+                                       m_empires,               m_universe,         GetSpeciesManager(),
+                                       GetCombatLogManager(),   m_player_info,      m_last_turn_update);
+                } catch (...) {
+                    m_last_turn_update.clear();
+                    // orders are generated once the server has resent the update in full
+                    Networking().SendMessage(RequestFullTurnUpdateMessage(PlayerID()));
+                    break;
+                }
+                GetUniverse().InitializeSystemGraph(m_empire_id);
+            }
             //Logger().debugStream() << "AIClientApp::HandleMessage : generating orders";
-            GetUniverse().InitializeSystemGraph(m_empire_id);
             m_AI->GenerateOrders();
             //Logger().debugStream() << "AIClientApp::HandleMessage : done handling turn update message";
         }
@@ -31,6 +31,7 @@ int wmain(int argc, wchar_t* argv[], wchar_t* envp[]) {
         GetOptionsDB().SetFromCommandLine(args);
 
         parse::init();
+        parse::preload_content();
 
         AIClientApp g_app(args);
 
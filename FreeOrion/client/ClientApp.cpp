@@ -110,6 +110,9 @@ const std::map<int, Message::PlayerStatus>& ClientApp::PlayerStatus() const
 std::map<int, Message::PlayerStatus>& ClientApp::PlayerStatus()
 { return m_player_status; }
 
+std::string& ClientApp::LastTurnUpdate()
+{ return m_last_turn_update; }
+
 void ClientApp::SetPlayerStatus(int player_id, Message::PlayerStatus status) {
     if (player_id == Networking::INVALID_PLAYER_ID)
         return;
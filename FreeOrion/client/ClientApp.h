@@ -62,6 +62,7 @@ public:
     std::map<int, PlayerInfo>&  Players();      ///< returns the map, indexed by player ID, of PlayerInfo structs containing info about players in the game
     std::map<int, Message::PlayerStatus>&
                                 PlayerStatus(); ///< returns the map, indexed by player ID, of the latest known PlayerStatus for each player in the game
+    std::string&                LastTurnUpdate();   ///< returns the contents of the last turn update received, against which the next one may be delta-encoded
 
     void SetEmpireID(int id);                   ///< sets the empire ID of this client
     void SetCurrentTurn(int turn);              ///< sets the current game turn
@@ -95,6 +96,7 @@ protected:
     std::map<int, PlayerInfo>   m_player_info;      ///< indexed by player id, contains info about all players in the game
     std::map<int, Message::PlayerStatus>
                                 m_player_status;    ///< indexed by player id, the last known PlayerStatus for each player
+    std::string                 m_last_turn_update; ///< contents of the last turn update received from the server
 
 private:
     const ClientApp& operator=(const ClientApp&); // disabled
@@ -542,6 +542,7 @@ boost::statechart::result WaitingForGameStart::react(const GameStart& msg) {
     int empire_id = ALL_EMPIRES;
     int current_turn = INVALID_GAME_TURN;
     Client().PlayerStatus().clear();
+    Client().LastTurnUpdate().clear();  // the first turn update of a game is never delta encoded
 
     ExtractMessageData(msg.m_message,       single_player_game,             empire_id,
                        current_turn,        Empires(),                      GetUniverse(),
@@ -604,9 +605,11 @@ boost::statechart::result WaitingForTurnData::react(const TurnUpdate& msg) {
     try {
         ExtractMessageData(msg.m_message,           Client().EmpireID(),    current_turn,
                            Empires(),               GetUniverse(),          GetSpeciesManager(),
-                           GetCombatLogManager(),   Client().Players());
+                           GetCombatLogManager(),   Client().Players(),     Client().LastTurnUpdate());
     } catch (...) {
         Client().GetClientUI()->GetMessageWnd()->HandleLogMessage(UserString("ERROR_PROCESSING_SERVER_MESSAGE") + "\n");
+        // keep waiting for the turn data, which the server resends in full
+        Client().Networking().SendMessage(RequestFullTurnUpdateMessage(Client().PlayerID()));
         return discard_event();
     }
 
@@ -76,7 +76,11 @@ CombatInfo::CombatInfo(int system_id_, int turn_) :
 
     // now that all participants in the battle have been found, loop through
     // objects again to assemble each participant empire's latest
-    // known information about all objects in this battle
+    // known information about all objects in this battle.  the objects are
+    // the universe's latest known objects themselves, so that what empires
+    // learn during the battle is updated in place.  latest known objects may
+    // be shared between empires, so they are unshared first, so that each
+    // empire's knowledge is updated only for that empire
 
     // system
     for (std::set<int>::const_iterator empire_it = empire_ids.begin();
@@ -85,6 +89,7 @@ CombatInfo::CombatInfo(int system_id_, int turn_) :
         int empire_id = *empire_it;
         if (empire_id == ALL_EMPIRES)
             continue;
+        GetUniverse().EmpireKnownObjects(empire_id).UnsharedObject(system->ID(), empire_id);
         empire_known_objects[empire_id].Insert(GetEmpireKnownSystem(system->ID(), empire_id));
     }
 
@@ -112,7 +117,10 @@ CombatInfo::CombatInfo(int system_id_, int turn_) :
                        (empire_id == ALL_EMPIRES ||
                         fleet->Unowned() ||
                         Empires().GetDiplomaticStatus(empire_id, fleet->Owner()) == DIPLO_WAR)))
-            { empire_known_objects[empire_id].Insert(GetEmpireKnownShip(ship->ID(), empire_id));}
+            {
+                GetUniverse().EmpireKnownObjects(empire_id).UnsharedObject(ship_id, empire_id);
+                empire_known_objects[empire_id].Insert(GetEmpireKnownShip(ship->ID(), empire_id));
+            }
         }
     }
 
@@ -128,6 +136,7 @@ CombatInfo::CombatInfo(int system_id_, int turn_) :
             if (empire_id == ALL_EMPIRES)
                 continue;
             if (GetUniverse().GetObjectVisibilityByEmpire(planet_id, empire_id) >= VIS_BASIC_VISIBILITY) {
+                GetUniverse().EmpireKnownObjects(empire_id).UnsharedObject(planet_id, empire_id);
                 empire_known_objects[empire_id].Insert(GetEmpireKnownPlanet(planet->ID(), empire_id));
             }
         }
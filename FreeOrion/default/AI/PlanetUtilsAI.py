@@ -151,8 +151,8 @@ def get_populated_planet_ids(planet_ids):
     :param planet_ids: list of planets ids
     :return: list of planets ids
     """
-    universe = fo.getUniverse()
-    return [pid for pid in planet_ids if universe.getPlanet(pid).currentMeterValue(fo.meterType.population) > 0]
+    population = fo.getUniverse().currentMeterValues(planet_ids, fo.meterType.population)
+    return [pid for pid in planet_ids if pid in population and population[pid] > 0]
 
 
 def get_systems(planet_ids):
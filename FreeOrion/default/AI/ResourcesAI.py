@@ -32,16 +32,21 @@ def _fill_data_dicts(planet_ids):
     currentFocus.clear()
     currentOutput.clear()
     planets = [(pid, planetMap[pid]) for pid in planet_ids]
+    # meters are fetched for all planets at once, rather than planet by planet
+    industry = universe.currentMeterValues(planet_ids, fo.meterType.industry)
+    research = universe.currentMeterValues(planet_ids, fo.meterType.research)
     for pid, planet in planets:
         currentFocus[pid] = planet.focus
-        currentOutput.setdefault(pid, {})[IFocus] = planet.currentMeterValue(fo.meterType.industry)
-        currentOutput[pid][RFocus] = planet.currentMeterValue(fo.meterType.research)
+        currentOutput.setdefault(pid, {})[IFocus] = industry[pid]
+        currentOutput[pid][RFocus] = research[pid]
         if IFocus in planet.availableFoci and planet.focus !=IFocus:
             fo.issueChangeFocusOrder(pid, IFocus)  # may not be able to take, but try
     universe.updateMeterEstimates(planet_ids)
+    target_industry = universe.currentMeterValues(planet_ids, fo.meterType.targetIndustry)
+    target_research = universe.currentMeterValues(planet_ids, fo.meterType.targetResearch)
     for pid, planet in planets:
-        itarget = planet.currentMeterValue(fo.meterType.targetIndustry)
-        rtarget = planet.currentMeterValue(fo.meterType.targetResearch)
+        itarget = target_industry[pid]
+        rtarget = target_research[pid]
         if planet.focus == IFocus:
             newTargets.setdefault(pid, {})[IFocus] = (itarget, rtarget)
             newTargets.setdefault(pid, {})[GFocus] = [0, rtarget]
@@ -53,10 +58,13 @@ def _fill_data_dicts(planet_ids):
         if RFocus in planet.availableFoci and planet.focus != RFocus:
             fo.issueChangeFocusOrder(pid, RFocus)  # may not be able to take, but try
     universe.updateMeterEstimates(planet_ids)
+    target_population = universe.currentMeterValues(planet_ids, fo.meterType.targetPopulation)
+    target_industry = universe.currentMeterValues(planet_ids, fo.meterType.targetIndustry)
+    target_research = universe.currentMeterValues(planet_ids, fo.meterType.targetResearch)
     for pid, planet in planets:
-        can_focus = planet.currentMeterValue(fo.meterType.targetPopulation) > 0
-        itarget = planet.currentMeterValue(fo.meterType.targetIndustry)
-        rtarget = planet.currentMeterValue(fo.meterType.targetResearch)
+        can_focus = target_population[pid] > 0
+        itarget = target_industry[pid]
+        rtarget = target_research[pid]
         if planet.focus == RFocus:
             newTargets.setdefault(pid, {})[RFocus] = (itarget, rtarget)
             newTargets[pid][GFocus][0] = itarget
@@ -69,8 +77,11 @@ def _fill_data_dicts(planet_ids):
 
 
 def get_resource_target_totals(empirePlanetIDs):#+
-    pp = sum(x.currentMeterValue(fo.meterType.targetIndustry) for x in planetMap.values())
-    rp = sum(x.currentMeterValue(fo.meterType.targetResearch) for x in planetMap.values())
+    universe = fo.getUniverse()
+    target_industry = universe.currentMeterValues(planetMap.keys(), fo.meterType.targetIndustry)
+    target_research = universe.currentMeterValues(planetMap.keys(), fo.meterType.targetResearch)
+    pp = sum(target_industry[pid] for pid in planetMap)
+    rp = sum(target_research[pid] for pid in planetMap)
     _fill_data_dicts(empirePlanetIDs)
     return pp, rp
 
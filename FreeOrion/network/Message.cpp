@@ -5,6 +5,7 @@
 #include "../combat/CombatLogManager.h"
 #include "../Empire/EmpireManager.h"
 #include "../Empire/Diplomacy.h"
+#include "../util/Compression.h"
 #include "../util/Logger.h"
 #include "../util/MultiplayerCommon.h"
 #include "../util/ModeratorAction.h"
@@ -28,8 +29,6 @@
 #include <boost/serialization/weak_ptr.hpp>
 #include <boost/timer.hpp>
 
-#include <zlib.h>
-
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
@@ -39,6 +38,21 @@
 namespace {
     const std::string DUMMY_EMPTY_MESSAGE = "Lathanda";
     const std::string ACKNOWLEDGEMENT = "ACK";
+
+    /** Returns \a text compressed, if compression is enabled.  Used for
+      * messages that contain (a part of) the universe. */
+    std::string CompressedMessageText(const std::string& text) {
+        std::string compressed;
+        CompressData(text, compressed);
+        return compressed;
+    }
+
+    /** Returns the text of \a msg, decompressed if necessary. */
+    std::string DecompressedMessageText(const Message& msg) {
+        std::string text = msg.Text();
+        std::string decompressed;
+        return DecompressData(text, decompressed) ? decompressed : text;
+    }
 }
 
 ////////////////////////////////////////////////
@@ -231,7 +245,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
            << BOOST_SERIALIZATION_NVP(loaded_game_data);
         oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, CompressedMessageText(os.str()));
 }
 
 Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
@@ -265,7 +279,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
         oa << BOOST_SERIALIZATION_NVP(save_state_string_available);
         oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, CompressedMessageText(os.str()));
 }
 
 Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
@@ -299,7 +313,7 @@ Message GameStartMessage(int player_id, bool single_player_game, int empire_id,
             oa << boost::serialization::make_nvp("save_state_string", *save_state_string);
         oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
     }
-    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::GAME_START, Networking::INVALID_PLAYER_ID, player_id, CompressedMessageText(os.str()));
 }
 
 Message HostSPAckMessage(int player_id)
@@ -339,23 +353,57 @@ Message PlayerStatusMessage(int player_id, int about_player_id, Message::PlayerS
     return Message(Message::PLAYER_STATUS, Networking::INVALID_PLAYER_ID, player_id, os.str());
 }
 
+namespace {
+    std::string SerializedTurnUpdate(int empire_id, int current_turn,
+                                     const EmpireManager& empires, const Universe& universe,
+                                     const SpeciesManager& species, const CombatLogManager& combat_logs,
+                                     const std::map<int, PlayerInfo>& players)
+    {
+        std::ostringstream os;
+        {
+            freeorion_oarchive oa(os);
+            GetUniverse().EncodingEmpire() = empire_id;
+            oa << BOOST_SERIALIZATION_NVP(current_turn)
+               << BOOST_SERIALIZATION_NVP(empires)
+               << BOOST_SERIALIZATION_NVP(species)
+               << BOOST_SERIALIZATION_NVP(combat_logs);
+            Serialize(oa, universe);
+            oa << BOOST_SERIALIZATION_NVP(players);
+        }
+        return os.str();
+    }
+
+    void DeserializeTurnUpdate(std::istream& is, int empire_id, int& current_turn,
+                               EmpireManager& empires, Universe& universe,
+                               SpeciesManager& species, CombatLogManager& combat_logs,
+                               std::map<int, PlayerInfo>& players)
+    {
+        freeorion_iarchive ia(is);
+        GetUniverse().EncodingEmpire() = empire_id;
+        ia >> BOOST_SERIALIZATION_NVP(current_turn)
+           >> BOOST_SERIALIZATION_NVP(empires)
+           >> BOOST_SERIALIZATION_NVP(species)
+           >> BOOST_SERIALIZATION_NVP(combat_logs);
+        Deserialize(ia, universe);
+        ia >> BOOST_SERIALIZATION_NVP(players);
+    }
+}
+
 Message TurnUpdateMessage(int player_id, int empire_id, int current_turn,
                           const EmpireManager& empires, const Universe& universe,
                           const SpeciesManager& species, const CombatLogManager& combat_logs,
-                          const std::map<int, PlayerInfo>& players)
+                          const std::map<int, PlayerInfo>& players,
+                          std::string& previous_update)
 {
-    std::ostringstream os;
-    {
-        freeorion_oarchive oa(os);
-        GetUniverse().EncodingEmpire() = empire_id;
-        oa << BOOST_SERIALIZATION_NVP(current_turn)
-           << BOOST_SERIALIZATION_NVP(empires)
-           << BOOST_SERIALIZATION_NVP(species)
-           << BOOST_SERIALIZATION_NVP(combat_logs);
-        Serialize(oa, universe);
-        oa << BOOST_SERIALIZATION_NVP(players);
-    }
-    return Message(Message::TURN_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    std::string update = SerializedTurnUpdate(empire_id, current_turn, empires, universe,
+                                               species, combat_logs, players);
+    std::string text;
+    if (previous_update.empty())
+        text = update;
+    else
+        EncodeDelta(previous_update, update, text);
+    previous_update.swap(update);
+    return Message(Message::TURN_UPDATE, Networking::INVALID_PLAYER_ID, player_id, CompressedMessageText(text));
 }
 
 Message TurnPartialUpdateMessage(int player_id, int empire_id, const Universe& universe) {
@@ -365,7 +413,7 @@ Message TurnPartialUpdateMessage(int player_id, int empire_id, const Universe& u
         GetUniverse().EncodingEmpire() = empire_id;
         Serialize(oa, universe);
     }
-    return Message(Message::TURN_PARTIAL_UPDATE, Networking::INVALID_PLAYER_ID, player_id, os.str());
+    return Message(Message::TURN_PARTIAL_UPDATE, Networking::INVALID_PLAYER_ID, player_id, CompressedMessageText(os.str()));
 }
 
 Message ClientSaveDataMessage(int sender, const OrderSet& orders, const SaveGameUIData& ui_data) {
@@ -425,6 +473,9 @@ Message DispatchDesignIDMessage(int player_id, int new_id) {
                    boost::lexical_cast<std::string>(new_id), true);
 }
 
+Message RequestFullTurnUpdateMessage(int sender)
+{ return Message(Message::REQUEST_FULL_TURN_UPDATE, sender, Networking::INVALID_PLAYER_ID, DUMMY_EMPTY_MESSAGE); }
+
 Message HostSaveGameMessage(int sender, const std::string& filename)
 { return Message(Message::SAVE_GAME, sender, Networking::INVALID_PLAYER_ID, filename); }
 
@@ -628,7 +679,7 @@ void ExtractMessageData(const Message& msg, bool& single_player_game, int& empir
                         std::string& save_state_string, GalaxySetupData& galaxy_setup_data)
 {
     try {
-        std::istringstream is(msg.Text());
+        std::istringstream is(DecompressedMessageText(msg));
         freeorion_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(single_player_game)
            >> BOOST_SERIALIZATION_NVP(empire_id)
@@ -708,25 +759,28 @@ void ExtractMessageData(const Message& msg, OrderSet& orders) {
 void ExtractMessageData(const Message& msg, int empire_id, int& current_turn,
                         EmpireManager& empires, Universe& universe,
                         SpeciesManager& species, CombatLogManager& combat_logs,
-                        std::map<int, PlayerInfo>& players)
+                        std::map<int, PlayerInfo>& players, std::string& previous_update)
 {
     try {
         ScopedTimer timer("Turn Update Unpacking", true);
-        std::istringstream is(msg.Text());
-        freeorion_iarchive ia(is);
-        GetUniverse().EncodingEmpire() = empire_id;
-        ia >> BOOST_SERIALIZATION_NVP(current_turn)
-           >> BOOST_SERIALIZATION_NVP(empires)
-           >> BOOST_SERIALIZATION_NVP(species)
-           >> BOOST_SERIALIZATION_NVP(combat_logs);
-        Deserialize(ia, universe);
-        ia >> BOOST_SERIALIZATION_NVP(players);
+        std::string update = DecompressedMessageText(msg);
+        std::string decoded;
+        if (DecodeDelta(previous_update, update, decoded))
+            update.swap(decoded);
+        {
+            std::istringstream is(update);
+            DeserializeTurnUpdate(is, empire_id, current_turn, empires, universe, species, combat_logs, players);
+        }
+        previous_update.swap(update);
     } catch (const std::exception& err) {
         Logger().errorStream() << "ExtractMessageData(const Message& msg, int empire_id, int& "
                                << "current_turn, EmpireManager& empires, Universe& universe, "
                                << "std::map<int, PlayerInfo>& players) failed!  Message:\n"
                                << msg.Text() << "\n"
                                << "Error: " << err.what();
+        // the server's delta base is no longer known to match, so only a
+        // complete update can be applied next
+        previous_update.clear();
         throw err;
     }
 }
@@ -734,7 +788,7 @@ void ExtractMessageData(const Message& msg, int empire_id, int& current_turn,
 void ExtractMessageData(const Message& msg, int empire_id, Universe& universe) {
     try {
         ScopedTimer timer("Mid Turn Update Unpacking", true);
-        std::istringstream is(msg.Text());
+        std::istringstream is(DecompressedMessageText(msg));
         freeorion_iarchive ia(is);
         GetUniverse().EncodingEmpire() = empire_id;
         Deserialize(ia, universe);
@@ -95,7 +95,8 @@ public:
         MODERATOR_ACTION,       ///< sent by client to server when a moderator edits the universe
         SHUT_DOWN_SERVER,       ///< sent by host client to server to kill the server process
         REQUEST_SAVE_PREVIEWS,  ///< sent by client to request previews of available savegames
-        DISPATCH_SAVE_PREVIEWS  ///< sent by host to client to provide the savegame previews
+        DISPATCH_SAVE_PREVIEWS, ///< sent by host to client to provide the savegame previews
+        REQUEST_FULL_TURN_UPDATE///< sent by client to server when it couldn't apply a TURN_UPDATE, requesting the current one without delta encoding
     )
 
     GG_CLASS_ENUM(TurnProgressPhase,
@@ -247,12 +248,16 @@ FO_COMMON_API Message TurnProgressMessage(Message::TurnProgressPhase phase_id, i
 /** creates a PLAYER_STATUS message. */
 FO_COMMON_API Message PlayerStatusMessage(int player_id, int about_player_id, Message::PlayerStatus player_status);
 
-/** creates a TURN_UPDATE message. */
+/** creates a TURN_UPDATE message.  \a previous_update holds the contents of
+  * the previous turn update sent to the player; if it is not empty, the
+  * message contains only the differences to it.  \a previous_update is
+  * replaced by the contents of the new turn update. */
 FO_COMMON_API Message TurnUpdateMessage(int player_id, int empire_id, int current_turn,
                                         const EmpireManager& empires, const Universe& universe,
                                         const SpeciesManager& species,
                                         const CombatLogManager& combat_logs,
-                                        const std::map<int, PlayerInfo>& players);
+                                        const std::map<int, PlayerInfo>& players,
+                                        std::string& previous_update);
 
 /** create a TURN_PARTIAL_UPDATE message. */
 FO_COMMON_API Message TurnPartialUpdateMessage(int player_id, int empire_id, const Universe& universe);
@@ -282,6 +287,11 @@ FO_COMMON_API Message RequestNewDesignIDMessage(int sender);
   * client who is waiting for a new design ID */
 FO_COMMON_API Message DispatchDesignIDMessage(int player_id, int new_id);
 
+/** creates a REQUEST_FULL_TURN_UPDATE message.  The server discards the
+  * previous turn update it sent to the player and answers with a complete
+  * TURN_UPDATE for the current turn. */
+FO_COMMON_API Message RequestFullTurnUpdateMessage(int sender);
+
 /** creates a SAVE_GAME request message.  This message should only be sent by
   * the host player.*/
 FO_COMMON_API Message HostSaveGameMessage(int sender, const std::string& filename);
@@ -398,9 +408,15 @@ FO_COMMON_API void ExtractMessageData(const Message& msg, std::string& player_na
 
 FO_COMMON_API void ExtractMessageData(const Message& msg, OrderSet& orders);
 
+/** Extracts the data from a TURN_UPDATE message.  \a previous_update holds
+  * the contents of the previous turn update received, which the message may
+  * contain the differences to, and is replaced by the contents of this one.
+  * If the message can't be extracted, \a previous_update is cleared, so that
+  * the complete update requested with RequestFullTurnUpdateMessage() can be
+  * applied. */
 FO_COMMON_API void ExtractMessageData(const Message& msg, int empire_id, int& current_turn, EmpireManager& empires,
                         Universe& universe, SpeciesManager& species, CombatLogManager& combat_logs,
-                        std::map<int, PlayerInfo>& players);
+                        std::map<int, PlayerInfo>& players, std::string& previous_update);
 
 FO_COMMON_API void ExtractMessageData(const Message& msg, int empire_id, Universe& universe);
 
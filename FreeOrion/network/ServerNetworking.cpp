@@ -184,6 +184,7 @@ namespace {
         case Message::MODERATOR_ACTION:     return "Moderator Action";
         case Message::SHUT_DOWN_SERVER:     return "Shut Down Server";
         case Message::REQUEST_SAVE_PREVIEWS:return "Request save previews";
+        case Message::REQUEST_FULL_TURN_UPDATE: return "Request Full Turn Update";
         default:                            return "Unknown Type";
         };
     }
@@ -0,0 +1,260 @@
+#include "ContentCache.h"
+
+#include "ParseImpl.h"
+
+#include "../universe/Building.h"
+#include "../universe/ShipDesign.h"
+#include "../universe/Species.h"
+#include "../util/Directories.h"
+#include "../util/i18n.h"
+#include "../util/Logger.h"
+#include "../util/OptionsDB.h"
+#include "../util/Version.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/thread/once.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = boost::filesystem;
+
+namespace {
+    void AddOptions(OptionsDB& db)
+    { db.Add("content-cache", UserStringNop("OPTIONS_DB_CONTENT_CACHE_DESC"), true, Validator<bool>()); }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    // increment when the serialized form of cached content changes
+    const int CONTENT_CACHE_FORMAT = 2;
+
+    const std::string CACHE_FILE_EXTENSION = ".bin";
+
+    fs::path CacheDir()
+    { return GetUserDir() / "content_cache"; }
+
+    /** Returns the 64 bit FNV-1a hash of \a text, starting from \a hash. */
+    boost::uint64_t Hash(const std::string& text, boost::uint64_t hash = 14695981039346656037ULL) {
+        for (std::string::const_iterator it = text.begin(); it != text.end(); ++it) {
+            hash ^= static_cast<unsigned char>(*it);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    std::string HexString(boost::uint64_t value) {
+        std::ostringstream oss;
+        oss << std::hex << std::setw(16) << std::setfill('0') << value;
+        return oss.str();
+    }
+
+    std::string build_identity;
+    boost::once_flag build_identity_once = BOOST_ONCE_INIT;
+
+    void InitBuildIdentity() {
+        std::ostringstream oss;
+        oss << __DATE__ << " " << __TIME__ << "\n";
+        // the executables and libraries are all built into the binary
+        // directory, so any rebuild changes the size or time of one of them
+        try {
+            std::vector<std::string> entries;
+            for (fs::directory_iterator it(GetBinDir()); it != fs::directory_iterator(); ++it) {
+                std::string name = PathString(it->path().filename());
+                if (name.find("freeorion") == std::string::npos || !fs::is_regular_file(it->path()))
+                    continue;
+                std::ostringstream entry;
+                entry << name << " " << fs::file_size(it->path()) << " " << fs::last_write_time(it->path()) << "\n";
+                entries.push_back(entry.str());
+            }
+            std::sort(entries.begin(), entries.end());
+            for (std::vector<std::string>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+                oss << *it;
+        } catch (const std::exception& e) {
+            Logger().errorStream() << "Unable to identify build for content cache: " << e.what();
+        }
+        build_identity = oss.str();
+    }
+
+    /** Returns a string that differs between builds, even between builds with
+      * the same version string, as serialized content may differ between them.
+      * Parse workers call this concurrently, so it is computed only once. */
+    const std::string& BuildIdentity() {
+        boost::call_once(&InitBuildIdentity, build_identity_once);
+        return build_identity;
+    }
+
+    /** Returns the start of the names of all cache files for the file named
+      * \a filename, whatever its contents. */
+    std::string CacheFilePrefix(const std::string& filename)
+    { return PathString(fs::path(filename).filename()) + "-" + HexString(Hash(filename)) + "-"; }
+
+    fs::path CacheFilePath(const std::string& filename, const std::string& file_contents) {
+        std::ostringstream key;
+        key << CONTENT_CACHE_FORMAT << " " << FreeOrionVersionString() << "\n" << BuildIdentity();
+        return CacheDir() / (CacheFilePrefix(filename) + HexString(Hash(file_contents, Hash(key.str()))) + CACHE_FILE_EXTENSION);
+    }
+
+    /** Removes the cache files for earlier contents of the file named
+      * \a filename, which will never be read again, but not the current cache
+      * file at \a keep_path. */
+    void RemoveStaleCacheFiles(const std::string& filename, const fs::path& keep_path) {
+        std::string prefix = CacheFilePrefix(filename);
+        std::vector<fs::path> stale_paths;
+        for (fs::directory_iterator it(CacheDir()); it != fs::directory_iterator(); ++it) {
+            std::string cache_filename = PathString(it->path().filename());
+            if (boost::algorithm::starts_with(cache_filename, prefix) &&
+                boost::algorithm::ends_with(cache_filename, CACHE_FILE_EXTENSION) &&
+                it->path() != keep_path)
+            { stale_paths.push_back(it->path()); }
+        }
+        for (std::vector<fs::path>::const_iterator it = stale_paths.begin(); it != stale_paths.end(); ++it)
+            fs::remove(*it);
+    }
+
+    template <typename T>
+    void SerializeContent(freeorion_oarchive& oa, const std::map<std::string, T*>& content)
+    { Serialize(oa, content); }
+
+    template <typename T>
+    void DeserializeContent(freeorion_iarchive& ia, std::map<std::string, T*>& content) {
+        // read everything before adding any of it, so that nothing is added
+        // if the cache can't be read
+        std::map<std::string, T*> cached_content;
+        Deserialize(ia, cached_content);
+        content.insert(cached_content.begin(), cached_content.end());
+    }
+}
+
+namespace parse { namespace detail {
+    bool read_content_cache(const std::string& filename, const std::string& file_contents,
+                            const boost::function<void (freeorion_iarchive&)>& read)
+    {
+        if (file_contents.empty() || !GetOptionsDB().Get<bool>("content-cache"))
+            return false;
+
+        fs::path cache_path = CacheFilePath(filename, file_contents);
+        try {
+            if (!fs::exists(cache_path))
+                return false;
+            fs::ifstream ifs(cache_path, std::ios_base::binary);
+            if (!ifs)
+                return false;
+            freeorion_iarchive ia(ifs);
+            read(ia);
+        } catch (const std::exception& e) {
+            Logger().errorStream() << "Unable to read cached content for " << filename
+                                   << " from " << PathString(cache_path) << ": " << e.what();
+            return false;
+        }
+
+        Logger().debugStream() << "Read cached content for " << filename << " from " << PathString(cache_path);
+        return true;
+    }
+
+    void write_content_cache(const std::string& filename, const std::string& file_contents,
+                             const boost::function<void (freeorion_oarchive&)>& write)
+    {
+        if (file_contents.empty() || !GetOptionsDB().Get<bool>("content-cache"))
+            return;
+
+        // write to a temporary file first, so that a cache file is either
+        // complete or absent, even if another process is writing it too
+        fs::path cache_path = CacheFilePath(filename, file_contents);
+        fs::path temp_path = cache_path.string() + "." +
+            boost::posix_time::to_iso_string(boost::posix_time::microsec_clock::universal_time()) + ".tmp";
+        try {
+            if (!fs::exists(CacheDir()))
+                fs::create_directories(CacheDir());
+            {
+                fs::ofstream ofs(temp_path, std::ios_base::binary);
+                if (!ofs)
+                    throw std::runtime_error("unable to open " + PathString(temp_path));
+                freeorion_oarchive oa(ofs);
+                write(oa);
+            }
+            fs::rename(temp_path, cache_path);
+            RemoveStaleCacheFiles(filename, cache_path);
+        } catch (const std::exception& e) {
+            Logger().errorStream() << "Unable to cache content for " << filename
+                                   << " in " << PathString(cache_path) << ": " << e.what();
+            boost::system::error_code ec;
+            fs::remove(temp_path, ec);
+        }
+    }
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, BuildingType*>& building_types)
+    {
+        return read_content_cache(filename, file_contents,
+                                  boost::bind(&DeserializeContent<BuildingType>, _1, boost::ref(building_types)));
+    }
+
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, BuildingType*>& building_types)
+    {
+        write_content_cache(filename, file_contents,
+                            boost::bind(&SerializeContent<BuildingType>, _1, boost::cref(building_types)));
+    }
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, Species*>& species)
+    {
+        return read_content_cache(filename, file_contents,
+                                  boost::bind(&DeserializeContent<Species>, _1, boost::ref(species)));
+    }
+
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, Species*>& species)
+    {
+        write_content_cache(filename, file_contents,
+                            boost::bind(&SerializeContent<Species>, _1, boost::cref(species)));
+    }
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, PartType*>& parts)
+    {
+        return read_content_cache(filename, file_contents,
+                                  boost::bind(&DeserializeContent<PartType>, _1, boost::ref(parts)));
+    }
+
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, PartType*>& parts)
+    {
+        write_content_cache(filename, file_contents,
+                            boost::bind(&SerializeContent<PartType>, _1, boost::cref(parts)));
+    }
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, HullType*>& hulls)
+    {
+        return read_content_cache(filename, file_contents,
+                                  boost::bind(&DeserializeContent<HullType>, _1, boost::ref(hulls)));
+    }
+
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, HullType*>& hulls)
+    {
+        write_content_cache(filename, file_contents,
+                            boost::bind(&SerializeContent<HullType>, _1, boost::cref(hulls)));
+    }
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, ShipDesign*>& designs)
+    {
+        return read_content_cache(filename, file_contents,
+                                  boost::bind(&DeserializeContent<ShipDesign>, _1, boost::ref(designs)));
+    }
+
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, ShipDesign*>& designs)
+    {
+        write_content_cache(filename, file_contents,
+                            boost::bind(&SerializeContent<ShipDesign>, _1, boost::cref(designs)));
+    }
+} }
@@ -0,0 +1,27 @@
+// -*- C++ -*-
+#ifndef _ContentCache_h_
+#define _ContentCache_h_
+
+#include "../util/Serialize.h"
+
+#include <boost/function.hpp>
+
+#include <string>
+
+
+namespace parse { namespace detail {
+    /** Calls \a read with an archive of the content that was cached after
+      * parsing a file named \a filename with the same (macro-expanded)
+      * \a file_contents, if there is any.  Returns true iff the cached
+      * content was read without errors. */
+    bool read_content_cache(const std::string& filename, const std::string& file_contents,
+                            const boost::function<void (freeorion_iarchive&)>& read);
+
+    /** Calls \a write with an archive that is cached as the content parsed
+      * from a file named \a filename with contents \a file_contents, and
+      * removes anything cached for earlier contents of that file. */
+    void write_content_cache(const std::string& filename, const std::string& file_contents,
+                             const boost::function<void (freeorion_oarchive&)>& write);
+} }
+
+#endif
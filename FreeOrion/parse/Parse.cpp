@@ -9,6 +9,7 @@
 #include "ValueRefParser.h"
 
 #include "../universe/Effect.h"
+#include "../universe/ValueRef.h"
 #include "../util/Logger.h"
 
 #include <boost/xpressive/xpressive.hpp>
@@ -16,6 +17,8 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/spirit/include/phoenix.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 
 #define DEBUG_PARSERS 0
 
@@ -412,6 +415,29 @@ namespace parse {
         return true;
     }
 
+    namespace {
+        boost::mutex                        s_included_files_mutex;
+        bool                                s_cache_included_files = false;
+        std::map<std::string, std::string>  s_included_files;
+
+        bool read_included_file(const boost::filesystem::path& path, std::string& file_contents) {
+            boost::mutex::scoped_lock lock(s_included_files_mutex);
+            if (!s_cache_included_files)
+                return read_file(path, file_contents);
+
+            std::map<std::string, std::string>::const_iterator it = s_included_files.find(path.string());
+            if (it == s_included_files.end()) {
+                if (!read_file(path, file_contents))
+                    return false;
+                it = s_included_files.insert(std::make_pair(path.string(), file_contents)).first;
+            }
+            file_contents = it->second;
+            return true;
+        }
+
+        boost::mutex s_rules_construction_mutex;
+    }
+
     const sregex FILENAME_TEXT = -+_;   // any character, one or more times, not greedy
     const sregex FILENAME_INSERTION = "include" >> *space >> "\"" >> (s1 = FILENAME_TEXT) >> "\"" >> *space >> _n;
 
@@ -430,7 +456,7 @@ namespace parse {
                 // read file to insert
                 boost::filesystem::path insert_file_path = file_search_path / filename;
                 std::string insert_file_contents;
-                bool read_success = read_file(insert_file_path, insert_file_contents);
+                bool read_success = read_included_file(insert_file_path, insert_file_contents);
                 if (!read_success) {
                     Logger().errorStream() << "File parsing include substitution failed to read file at path: " << insert_file_path.string();
                     continue;
@@ -471,6 +497,16 @@ namespace parse {
             return rules.start;
         }
 
+        void cache_included_files(bool cache) {
+            boost::mutex::scoped_lock lock(s_included_files_mutex);
+            s_cache_included_files = cache;
+            if (!cache)
+                s_included_files.clear();
+        }
+
+        boost::mutex& rules_construction_mutex()
+        { return s_rules_construction_mutex; }
+
         void parse_file_common(const boost::filesystem::path& path, const parse::lexer& l,
                                std::string& filename, std::string& file_contents,
                                parse::text_iterator& first, parse::token_iterator& it)
@@ -492,11 +528,18 @@ namespace parse {
             first = parse::text_iterator(file_contents.begin());
             parse::text_iterator last(file_contents.end());
 
-            parse::detail::s_text_it = &first;
-            parse::detail::s_begin = first;
-            parse::detail::s_end = last;
-            parse::detail::s_filename = filename.c_str();
+            text_being_parsed& text = current_text();
+            text.text_it = &first;
+            text.begin = first;
+            text.end = last;
+            text.filename = filename.c_str();
             it = l.begin(first, last);
         }
+
+        void report_folded_operations(const std::string& filename, unsigned int folded_before) {
+            unsigned int folded = ValueRef::FoldedOperations() - folded_before;
+            if (folded)
+                Logger().debugStream() << "Folded " << folded << " constant ValueRef operations in " << filename;
+        }
     }
 }
@@ -28,6 +28,13 @@ struct Encyclopedia;
 namespace parse {
     FO_PARSE_API void init();
 
+    /** Parses the techs, species, buildings, specials, ship parts, ship hulls,
+      * fields and predefined ship designs in the resource directory, several
+      * files at once, and keeps the results until the content managers parse
+      * the same files, which then returns the kept results instead.  Call
+      * after init(), before any of the content managers are created. */
+    FO_PARSE_API void preload_content();
+
     FO_PARSE_API bool buildings(const boost::filesystem::path& path,
                                 std::map<std::string,
                                 BuildingType*>& building_types);
@@ -4,15 +4,25 @@
 
 #include "ReportParseError.h"
 #include "../universe/Tech.h"
+#include "../universe/ValueRef.h"
+#include "../util/ScopedTimer.h"
 
 #include <boost/filesystem/path.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/spirit/include/qi.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <GG/Clr.h>
 
 namespace qi = boost::spirit::qi;
 namespace phoenix = boost::phoenix;
 
+class BuildingType;
+class HullType;
+class PartType;
+class ShipDesign;
+class Species;
+
 namespace parse { namespace detail {
 
     typedef boost::spirit::qi::rule<
@@ -60,9 +70,135 @@ namespace parse { namespace detail {
                            text_iterator& first,
                            token_iterator& it);
 
+    /** Sets whether included files are read only once and their contents
+      * kept, while preload_content() parses several files that include the
+      * same ones. */
+    void cache_included_files(bool cache);
+
+    /** Locked while rules are constructed.  Rules of the different kinds of
+      * content share rules that are constructed on first use, so they must
+      * not be constructed in several threads at once. */
+    boost::mutex& rules_construction_mutex();
+
+    template <typename Rules>
+    Rules& rules_instance() {
+        boost::mutex::scoped_lock lock(rules_construction_mutex());
+        static Rules rules;
+        return rules;
+    }
+
+    /** Content that preload_content() parsed from a file before it was asked
+      * for, with whether parsing was successful. */
+    struct preloaded_content_base {
+        preloaded_content_base() : success(false) {}
+        virtual ~preloaded_content_base() {}
+        bool success;
+    };
+
+    template <typename Arg1>
+    struct preloaded_content : preloaded_content_base {
+        Arg1 arg1;
+    };
+
+    template <typename Arg1, typename Arg2, typename Arg3>
+    struct preloaded_content_3 : preloaded_content_base {
+        Arg1 arg1;
+        Arg2 arg2;
+        Arg3 arg3;
+    };
+
+    /** Stores \a content parsed from \a path, until it is taken. */
+    void store_preloaded_content(const boost::filesystem::path& path,
+                                 const boost::shared_ptr<preloaded_content_base>& content);
+
+    /** Removes and returns the content preloaded from \a path, or a null
+      * pointer if there is none. */
+    boost::shared_ptr<preloaded_content_base> take_preloaded_content(const boost::filesystem::path& path);
+
+    /** Adds the content preloaded from \a path to \a arg1, and sets
+      * \a success to whether it was parsed successfully.  Returns false if
+      * no content was preloaded from \a path. */
+    template <typename Arg1>
+    bool take_preloaded_content(const boost::filesystem::path& path, Arg1& arg1, bool& success) {
+        boost::shared_ptr<preloaded_content<Arg1> > content =
+            boost::dynamic_pointer_cast<preloaded_content<Arg1> >(take_preloaded_content(path));
+        if (!content)
+            return false;
+        arg1.insert(content->arg1.begin(), content->arg1.end());
+        success = content->success;
+        return true;
+    }
+
+    template <typename Arg1, typename Arg2, typename Arg3>
+    bool take_preloaded_content(const boost::filesystem::path& path, Arg1& arg1, Arg2& arg2, Arg3& arg3, bool& success) {
+        boost::shared_ptr<preloaded_content_3<Arg1, Arg2, Arg3> > content =
+            boost::dynamic_pointer_cast<preloaded_content_3<Arg1, Arg2, Arg3> >(take_preloaded_content(path));
+        if (!content)
+            return false;
+        arg1.insert(content->arg1.begin(), content->arg1.end());
+        arg2.insert(content->arg2.begin(), content->arg2.end());
+        arg3.insert(content->arg3.begin(), content->arg3.end());
+        success = content->success;
+        return true;
+    }
+
+    /** Logs how many constant ValueRef operations were folded while parsing
+      * \a filename, given the number folded before parsing started. */
+    void report_folded_operations(const std::string& filename, unsigned int folded_before);
+
+    /** Reads the content that was cached after parsing a file named
+      * \a filename with the same (macro-expanded) \a file_contents into
+      * \a arg1, and returns true iff there was any.  Only the kinds of content
+      * that have overloads below are cached. */
+    template <typename Arg1>
+    bool load_cached_content(const std::string& filename, const std::string& file_contents, Arg1& arg1)
+    { return false; }
+
+    /** Caches \a arg1 as the content parsed from a file named \a filename
+      * with contents \a file_contents. */
+    template <typename Arg1>
+    void save_cached_content(const std::string& filename, const std::string& file_contents, const Arg1& arg1)
+    {}
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, BuildingType*>& building_types);
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, BuildingType*>& building_types);
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, Species*>& species);
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, Species*>& species);
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, PartType*>& parts);
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, PartType*>& parts);
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, HullType*>& hulls);
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, HullType*>& hulls);
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             std::map<std::string, ShipDesign*>& designs);
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const std::map<std::string, ShipDesign*>& designs);
+
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             TechManager::TechContainer& techs);
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const TechManager::TechContainer& techs);
+
     template <typename Rules, typename Arg1>
     bool parse_file(const boost::filesystem::path& path, Arg1& arg1)
     {
+        bool preloaded_success = false;
+        if (take_preloaded_content(path, arg1, preloaded_success))
+            return preloaded_success;
+
+        ScopedTimer timer("Loading content from " + path.string());
+
         std::string filename;
         std::string file_contents;
         text_iterator first;
@@ -72,15 +208,27 @@ namespace parse { namespace detail {
 
         parse_file_common(path, l, filename, file_contents, first, it);
 
+        // reading content back from the cache is much faster than parsing it
+        // again, and is only done if the file and its inclusions are unchanged
+        if (load_cached_content(filename, file_contents, arg1))
+            return true;
+
         boost::spirit::qi::in_state_type in_state;
 
-        static Rules rules;
+        Rules& rules = rules_instance<Rules>();
+
+        unsigned int folded_before = ValueRef::FoldedOperations();
 
         bool success = boost::spirit::qi::phrase_parse(it, l.end(), rules.start(boost::phoenix::ref(arg1)), in_state("WS")[l.self]);
 
-        std::ptrdiff_t distance = std::distance(first, parse::detail::s_end);
+        report_folded_operations(filename, folded_before);
+
+        std::ptrdiff_t distance = std::distance(first, current_text().end);
 
-        return success && (!distance || distance == 1 && *first == '\n');
+        success = success && (!distance || distance == 1 && *first == '\n');
+        if (success)
+            save_cached_content(filename, file_contents, arg1);
+        return success;
     }
 } }
 
@@ -0,0 +1,153 @@
+#include "Parse.h"
+
+#include "ParseImpl.h"
+
+#include "../universe/ShipDesign.h"
+#include "../util/Directories.h"
+#include "../util/i18n.h"
+#include "../util/Logger.h"
+#include "../util/OptionsDB.h"
+#include "../util/RunQueue.h"
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+
+namespace fs = boost::filesystem;
+
+namespace {
+    void AddOptions(OptionsDB& db)
+    { db.Add("content-parse-threads", UserStringNop("OPTIONS_DB_CONTENT_PARSE_THREADS_DESC"), 4, RangedValidator<int>(1, 32)); }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    boost::mutex s_preloaded_content_mutex;
+    std::map<std::string, boost::shared_ptr<parse::detail::preloaded_content_base> > s_preloaded_content;
+
+    typedef std::vector<std::pair<fs::path, boost::shared_ptr<parse::detail::preloaded_content_base> > >
+        PreloadedContentVec;
+
+    class PreloadContentWorkItem {
+    public:
+        PreloadContentWorkItem(const boost::function<bool ()>& parse, const fs::path& path, bool& success) :
+            m_parse(parse),
+            m_path(path),
+            m_success(success)
+        {}
+
+        void operator ()() {
+            try {
+                m_success = m_parse();
+            } catch (const std::exception& e) {
+                Logger().errorStream() << "Exception caught parsing " << m_path.string() << ": " << e.what();
+                m_success = false;
+            }
+        }
+
+    private:
+        boost::function<bool ()>    m_parse;
+        fs::path                    m_path;
+        bool&                       m_success;
+    };
+
+    template <typename Arg1>
+    void AddPreloadWork(RunQueue<PreloadContentWorkItem>& run_queue, PreloadedContentVec& preloaded,
+                        bool (*parse)(const fs::path&, Arg1&), const fs::path& path)
+    {
+        boost::shared_ptr<parse::detail::preloaded_content<Arg1> > content(new parse::detail::preloaded_content<Arg1>);
+        run_queue.AddWork(new PreloadContentWorkItem(boost::bind(parse, path, boost::ref(content->arg1)),
+                                                     path, content->success));
+        preloaded.push_back(std::make_pair(path, content));
+    }
+
+    template <typename Arg1, typename Arg2, typename Arg3>
+    void AddPreloadWork(RunQueue<PreloadContentWorkItem>& run_queue, PreloadedContentVec& preloaded,
+                        bool (*parse)(const fs::path&, Arg1&, Arg2&, Arg3&), const fs::path& path)
+    {
+        boost::shared_ptr<parse::detail::preloaded_content_3<Arg1, Arg2, Arg3> > content(
+            new parse::detail::preloaded_content_3<Arg1, Arg2, Arg3>);
+        run_queue.AddWork(new PreloadContentWorkItem(boost::bind(parse, path, boost::ref(content->arg1),
+                                                                 boost::ref(content->arg2), boost::ref(content->arg3)),
+                                                     path, content->success));
+        preloaded.push_back(std::make_pair(path, content));
+    }
+
+    /** Waits for the work on \a run_queue, then stores the content it parsed
+      * for the parse:: functions to return when they are called with the
+      * same paths. */
+    void StorePreloadedContent(RunQueue<PreloadContentWorkItem>& run_queue, const PreloadedContentVec& preloaded) {
+        run_queue.Wait();
+        for (PreloadedContentVec::const_iterator it = preloaded.begin(); it != preloaded.end(); ++it)
+            parse::detail::store_preloaded_content(it->first, it->second);
+    }
+}
+
+namespace parse {
+    void preload_content() {
+        ScopedTimer timer("parse::preload_content", true);
+
+        // the lexer builds its state machine on first use, which must not
+        // happen in several threads at once
+        const lexer& l = lexer::instance();
+        const std::string no_text;
+        text_iterator first = no_text.begin();
+        l.begin(first, no_text.end());
+
+        detail::cache_included_files(true);
+
+        unsigned int num_threads = static_cast<unsigned int>(std::max(1, GetOptionsDB().Get<int>("content-parse-threads")));
+        const fs::path dir = GetResourceDir();
+
+        // these must use the same paths as the content managers do, for the
+        // managers to find the preloaded content
+        {
+            RunQueue<PreloadContentWorkItem> run_queue(num_threads);
+            PreloadedContentVec preloaded;
+            AddPreloadWork(run_queue, preloaded, &techs, dir / "techs.txt");
+            AddPreloadWork(run_queue, preloaded, &species, dir / "species.txt");
+            AddPreloadWork(run_queue, preloaded, &buildings, dir / "buildings.txt");
+            AddPreloadWork(run_queue, preloaded, &specials, dir / "specials.txt");
+            AddPreloadWork(run_queue, preloaded, &ship_parts, dir / "ship_parts.txt");
+            AddPreloadWork(run_queue, preloaded, &ship_hulls, dir / "ship_hulls.txt");
+            AddPreloadWork(run_queue, preloaded, &fields, dir / "fields.txt");
+            StorePreloadedContent(run_queue, preloaded);
+        }
+
+        // ship designs look up their hull and parts when they are created, so
+        // those are published to their managers before designs are parsed
+        GetPartTypeManager();
+        GetHullTypeManager();
+        {
+            RunQueue<PreloadContentWorkItem> run_queue(num_threads);
+            PreloadedContentVec preloaded;
+            AddPreloadWork(run_queue, preloaded, &ship_designs, dir / "premade_ship_designs.txt");
+            AddPreloadWork(run_queue, preloaded, &ship_designs, dir / "space_monsters.txt");
+            StorePreloadedContent(run_queue, preloaded);
+        }
+
+        detail::cache_included_files(false);
+    }
+
+    namespace detail {
+        void store_preloaded_content(const boost::filesystem::path& path,
+                                     const boost::shared_ptr<preloaded_content_base>& content)
+        {
+            boost::mutex::scoped_lock lock(s_preloaded_content_mutex);
+            s_preloaded_content[path.string()] = content;
+        }
+
+        boost::shared_ptr<preloaded_content_base> take_preloaded_content(const boost::filesystem::path& path) {
+            boost::mutex::scoped_lock lock(s_preloaded_content_mutex);
+            boost::shared_ptr<preloaded_content_base> retval;
+            std::map<std::string, boost::shared_ptr<preloaded_content_base> >::iterator it =
+                s_preloaded_content.find(path.string());
+            if (it != s_preloaded_content.end()) {
+                retval = it->second;
+                s_preloaded_content.erase(it);
+            }
+            return retval;
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include "../util/Logger.h"
 
 #include <boost/algorithm/string/classification.hpp>
+#include <boost/thread/tss.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/xpressive/xpressive.hpp>
 
@@ -90,10 +91,15 @@ void parse::detail::pretty_print(std::ostream& os, boost::spirit::info const& wh
 void parse::detail::default_send_error_string(const std::string& str)
 { Logger().errorStream() << str; }
 
-const char* parse::detail::s_filename = 0;
-parse::text_iterator* parse::detail::s_text_it = 0;
-parse::text_iterator parse::detail::s_begin;
-parse::text_iterator parse::detail::s_end;
+namespace {
+    boost::thread_specific_ptr<parse::detail::text_being_parsed> s_current_text;
+}
+
+parse::detail::text_being_parsed& parse::detail::current_text() {
+    if (!s_current_text.get())
+        s_current_text.reset(new text_being_parsed);
+    return *s_current_text;
+}
 
 boost::function<void (const std::string&)> parse::report_error_::send_error_string =
     &detail::default_send_error_string;
@@ -103,13 +109,14 @@ namespace {
         //Logger().debugStream() << "line starts start";
         using namespace parse;
 
+        const detail::text_being_parsed& text = detail::current_text();
         std::vector<text_iterator> retval;
 
-        text_iterator it = detail::s_begin;
+        text_iterator it = text.begin;
         retval.push_back(it);   // first line
 
         // find subsequent lines
-        while (it != detail::s_end) {
+        while (it != text.end) {
             bool eol = false;
             text_iterator temp;
 
@@ -118,21 +125,21 @@ namespace {
                 eol = true;
                 temp = ++it;
             }
-            if (it != detail::s_end && *it == '\n') {
+            if (it != text.end && *it == '\n') {
                 eol = true;
                 temp = ++it;
             }
 
-            if (eol && temp != detail::s_end)
+            if (eol && temp != text.end)
                 retval.push_back(temp);
-            else if (it != detail::s_end)
+            else if (it != text.end)
                 ++it;
         }
 
         //Logger().debugStream() << "line starts end.  num lines: " << retval.size();
         //for (unsigned int i = 0; i < retval.size(); ++i) {
         //    text_iterator line_end = retval[i];
-        //    while (line_end != detail::s_end && *line_end != '\r' && *line_end != '\n')
+        //    while (line_end != text.end && *line_end != '\r' && *line_end != '\n')
         //        ++line_end;
         //    Logger().debugStream() << " line " << i+1 << ": " << std::string(retval[i], line_end);
         //}
@@ -142,8 +149,9 @@ namespace {
 
 std::pair<parse::text_iterator, unsigned int> parse::report_error_::line_start_and_line_number(text_iterator error_position) const {
     //Logger().debugStream() << "line_start_and_line_number start ... looking for: " << std::string(error_position, error_position + 20);
-    if (error_position == detail::s_begin)
-        return std::make_pair(detail::s_begin, 1);
+    const detail::text_being_parsed& text = detail::current_text();
+    if (error_position == text.begin)
+        return std::make_pair(text.begin, 1);
 
     std::vector<parse::text_iterator> line_starts = LineStarts();
 
@@ -158,12 +166,13 @@ std::pair<parse::text_iterator, unsigned int> parse::report_error_::line_start_a
     }
 
     //Logger().debugStream() << "line_start_and_line_number end";
-    return std::make_pair(detail::s_begin, 1);
+    return std::make_pair(text.begin, 1);
 }
 
 std::string parse::report_error_::get_line(text_iterator line_start) const {
+    const detail::text_being_parsed& text = detail::current_text();
     text_iterator line_end = line_start;
-    while (line_end != detail::s_end && *line_end != '\r' && *line_end != '\n')
+    while (line_end != text.end && *line_end != '\r' && *line_end != '\n')
         ++line_end;
     return std::string(line_start, line_end);
 }
@@ -218,7 +227,7 @@ std::string parse::report_error_::get_lines_after(text_iterator line_start) cons
     if (retval_first_line + NUM_LINES < all_line_starts.size())
         retval_last_line = retval_first_line + NUM_LINES - 1;
 
-    text_iterator last_it = detail::s_end;
+    text_iterator last_it = detail::current_text().end;
     if (retval_last_line < all_line_starts.size())
         last_it = all_line_starts[retval_last_line];
 
@@ -232,23 +241,24 @@ void parse::report_error_::generate_error_string(const token_iterator& first,
                                                  std::string& str) const
 {
     //Logger().debugStream() << "generate_error_string";
+    const detail::text_being_parsed& text = detail::current_text();
     std::stringstream is;
 
     text_iterator line_start;
     unsigned int line_number;
     text_iterator text_it = it->matched().begin();
     if (it->matched().begin() == it->matched().end()) {
-        text_it = *detail::s_text_it;
-        if (text_it != detail::s_end)
+        text_it = *text.text_it;
+        if (text_it != text.end)
             ++text_it;
     }
 
     {
         text_iterator text_it_copy = text_it;
-        while (text_it_copy != detail::s_end && boost::algorithm::is_space()(*text_it_copy)) {
+        while (text_it_copy != text.end && boost::algorithm::is_space()(*text_it_copy)) {
             ++text_it_copy;
         }
-        if (text_it_copy != detail::s_end)
+        if (text_it_copy != text.end)
             text_it = text_it_copy;
     }
 
@@ -256,7 +266,7 @@ void parse::report_error_::generate_error_string(const token_iterator& first,
     std::size_t column_number = std::distance(line_start, text_it);
     //Logger().debugStream() << "generate_error_string found line number: " << line_number << " column number: " << column_number;
 
-    is << detail::s_filename << ":" << line_number << ":" << column_number << ": "
+    is << text.filename << ":" << line_number << ":" << column_number << ": "
        << "Parse error.  Expected";
 
     {
@@ -267,7 +277,7 @@ void parse::report_error_::generate_error_string(const token_iterator& first,
         is << regex_replace(os.str(), regex, "$&, ...");
     }
 
-    if (text_it == detail::s_end) {
+    if (text_it == text.end) {
         is << " before end of input.\n";
     } else {
         is << " here:\n";
@@ -33,10 +33,19 @@ namespace parse {
 
         void default_send_error_string(const std::string& str);
 
-        extern const char*      s_filename;
-        extern text_iterator*   s_text_it;
-        extern text_iterator    s_begin;
-        extern text_iterator    s_end;
+        /** The text that is being parsed, for locating parse errors in it. */
+        struct text_being_parsed {
+            text_being_parsed() : filename(0), text_it(0) {}
+
+            const char*     filename;
+            text_iterator*  text_it;
+            text_iterator   begin;
+            text_iterator   end;
+        };
+
+        /** Returns the text that is being parsed in the calling thread.  Files
+          * may be parsed in several threads at once, so each has its own. */
+        text_being_parsed& current_text();
     }
 
     struct report_error_ {
@@ -1,10 +1,12 @@
 #include "Label.h"
+#include "ContentCache.h"
 #include "EnumParser.h"
 #include "ValueRefParser.h"
 #include "ParseImpl.h"
 #include "Parse.h"
 #include "../universe/Species.h"
 
+#include <boost/bind.hpp>
 #include <boost/spirit/include/phoenix.hpp>
 
 #define DEBUG_PARSERS 0
@@ -248,12 +250,43 @@ namespace {
     };
 }
 
+namespace {
+    void SerializeTechs(freeorion_oarchive& oa, const TechManager::TechContainer& techs) {
+        std::vector<const Tech*> tech_vec(techs.begin(), techs.end());
+        Serialize(oa, tech_vec, *g_categories, *g_categories_seen);
+    }
+
+    void DeserializeTechs(freeorion_iarchive& ia, TechManager::TechContainer& techs) {
+        std::vector<const Tech*> cached_techs;
+        std::map<std::string, TechCategory*> cached_categories;
+        std::set<std::string> cached_categories_seen;
+        Deserialize(ia, cached_techs, cached_categories, cached_categories_seen);
+        techs.insert(cached_techs.begin(), cached_techs.end());
+        g_categories->insert(cached_categories.begin(), cached_categories.end());
+        g_categories_seen->insert(cached_categories_seen.begin(), cached_categories_seen.end());
+    }
+}
+
+namespace parse { namespace detail {
+    bool load_cached_content(const std::string& filename, const std::string& file_contents,
+                             TechManager::TechContainer& techs)
+    { return read_content_cache(filename, file_contents, boost::bind(&DeserializeTechs, _1, boost::ref(techs))); }
+
+    void save_cached_content(const std::string& filename, const std::string& file_contents,
+                             const TechManager::TechContainer& techs)
+    { write_content_cache(filename, file_contents, boost::bind(&SerializeTechs, _1, boost::cref(techs))); }
+} }
+
 namespace parse {
     bool techs(const boost::filesystem::path& path,
                TechManager::TechContainer& techs_,
                std::map<std::string, TechCategory*>& categories,
                std::set<std::string>& categories_seen)
     {
+        bool preloaded_success = false;
+        if (detail::take_preloaded_content(path, techs_, categories, categories_seen, preloaded_success))
+            return preloaded_success;
+
         g_categories_seen = &categories_seen;
         g_categories = &categories;
         return detail::parse_file<rules, TechManager::TechContainer>(path, techs_);
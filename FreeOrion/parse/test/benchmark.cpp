@@ -0,0 +1,384 @@
+#include "test.h"
+
+#include "../ConditionParser.h"
+#include "../EffectParser.h"
+#include "../Parse.h"
+#include "../ParseImpl.h"
+#include "../ReportParseError.h"
+#include "../Empire/Empire.h"
+#include "../universe/ValueRef.h"
+#include "../util/OptionsDB.h"
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/function.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+
+namespace {
+    void send_error_string(const std::string& str)
+    { std::cerr << str; }
+
+    void print_benchmark_help() {
+        std::cout << "Usage: benchmark_parsers [-n iterations] lexer|double_value_ref_parser|string_value_ref_parser|planet_size_value_ref_parser|planet_type_value_ref_parser|planet_environment_value_ref_parser|star_type_value_ref_parser|condition_parser|effect_parser|buildings_parser|specials_parser|species_parser|techs_parser|items_parser|ship_parts_parser|ship_hulls_parser|ship_designs_parser|fleet_plans_parser|monster_fleet_plans_parser|alignments_parser <filename>...\n"
+                  << "       benchmark_parsers [-n iterations] content <directory>" << std::endl;
+    }
+
+    test_type test_type_from_string(const std::string& test_str) {
+#define CASE(x) if (test_str == #x) return x
+        CASE(lexer);
+        CASE(double_value_ref_parser);
+        CASE(string_value_ref_parser);
+        CASE(planet_size_value_ref_parser);
+        CASE(planet_type_value_ref_parser);
+        CASE(planet_environment_value_ref_parser);
+        CASE(star_type_value_ref_parser);
+        CASE(condition_parser);
+        CASE(effect_parser);
+        CASE(buildings_parser);
+        CASE(specials_parser);
+        CASE(species_parser);
+        CASE(techs_parser);
+        CASE(items_parser);
+        CASE(ship_parts_parser);
+        CASE(ship_hulls_parser);
+        CASE(ship_designs_parser);
+        CASE(fleet_plans_parser);
+        CASE(monster_fleet_plans_parser);
+        CASE(alignments_parser);
+#undef CASE
+        return unknown;
+    }
+
+    std::string read_text(const boost::filesystem::path& path) {
+        std::ifstream ifs(path.string().c_str(), std::ios_base::binary);
+        std::string retval;
+        std::getline(ifs, retval, '\0');
+        return retval;
+    }
+
+    /** The non-empty lines of \a text, which the grammars that don't parse
+      * whole files are run on one at a time, as in test_parsers. */
+    std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> all_lines;
+        boost::algorithm::split(all_lines, text, boost::algorithm::is_any_of("\n\r"), boost::algorithm::token_compress_on);
+        std::vector<std::string> retval;
+        for (std::size_t i = 0; i < all_lines.size(); ++i)
+            if (!all_lines[i].empty())
+                retval.push_back(all_lines[i]);
+        return retval;
+    }
+
+    void begin_text(const std::string& text, parse::text_iterator& first, const char* filename) {
+        first = text.begin();
+        parse::detail::text_being_parsed& current_text = parse::detail::current_text();
+        current_text.text_it = &first;
+        current_text.begin = first;
+        current_text.end = text.end();
+        current_text.filename = filename;
+    }
+
+    /** Runs the lexer over \a text and returns the number of tokens it
+      * produces, not counting whitespace and comments. */
+    std::size_t lex(const std::string& text) {
+        const parse::lexer& l = parse::lexer::instance();
+        boost::spirit::qi::in_state_type in_state;
+        boost::spirit::qi::token_type token;
+
+        std::size_t tokens = 0;
+        parse::text_iterator first;
+        const parse::text_iterator last = text.end();
+        begin_text(text, first, "lexer");
+        parse::token_iterator it = l.begin(first, last);
+        boost::spirit::qi::phrase_parse(it, l.end(), *token[++boost::phoenix::ref(tokens)], in_state("WS")[l.self]);
+        return tokens;
+    }
+
+    std::size_t lex_lines(const std::vector<std::string>& lines_) {
+        std::size_t retval = 0;
+        for (std::size_t i = 0; i < lines_.size(); ++i)
+            retval += lex(lines_[i]);
+        return retval;
+    }
+
+    bool run_lexer(const std::vector<std::string>& lines_) {
+        lex_lines(lines_);
+        return true;
+    }
+
+    template <typename Rule>
+    bool parse_line(const Rule& rule, const std::string& line) {
+        const parse::lexer& l = parse::lexer::instance();
+        boost::spirit::qi::in_state_type in_state;
+
+        parse::text_iterator first;
+        const parse::text_iterator last = line.end();
+        begin_text(line, first, "benchmark");
+        parse::token_iterator it = l.begin(first, last);
+        const parse::token_iterator end_it = l.end();
+        return boost::spirit::qi::phrase_parse(it, end_it, rule, in_state("WS")[l.self]) && it == end_it;
+    }
+
+    bool parse_lines(test_type test, const std::vector<std::string>& lines_) {
+        bool success = true;
+        for (std::size_t i = 0; i < lines_.size(); ++i) {
+            const std::string& line = lines_[i];
+            switch (test) {
+            case double_value_ref_parser:               success = parse_line(parse::value_ref_parser<double>(), line) && success; break;
+            case string_value_ref_parser:               success = parse_line(parse::value_ref_parser<std::string>(), line) && success; break;
+            case planet_size_value_ref_parser:          success = parse_line(parse::value_ref_parser<PlanetSize>(), line) && success; break;
+            case planet_type_value_ref_parser:          success = parse_line(parse::value_ref_parser<PlanetType>(), line) && success; break;
+            case planet_environment_value_ref_parser:   success = parse_line(parse::value_ref_parser<PlanetEnvironment>(), line) && success; break;
+            case star_type_value_ref_parser:            success = parse_line(parse::value_ref_parser<StarType>(), line) && success; break;
+            case condition_parser:                      success = parse_line(parse::condition_parser(), line) && success; break;
+            case effect_parser:                         success = parse_line(parse::effect_parser(), line) && success; break;
+            default: break;
+            }
+        }
+        return success;
+    }
+
+    template <typename T>
+    void delete_content(std::map<std::string, T*>& content) {
+        for (typename std::map<std::string, T*>::iterator it = content.begin(); it != content.end(); ++it)
+            delete it->second;
+    }
+
+    template <typename T>
+    void delete_content(std::vector<T*>& content) {
+        for (typename std::vector<T*>::iterator it = content.begin(); it != content.end(); ++it)
+            delete *it;
+    }
+
+    /** Parses the file at \a path with the file parser for \a test, and
+      * deletes what it parsed again, so that each iteration does the same. */
+    bool parse_file(test_type test, const boost::filesystem::path& path) {
+        bool success = false;
+        switch (test) {
+        case buildings_parser: {
+            std::map<std::string, BuildingType*> building_types;
+            success = parse::buildings(path, building_types);
+            delete_content(building_types);
+            break;
+        }
+        case specials_parser: {
+            std::map<std::string, Special*> specials;
+            success = parse::specials(path, specials);
+            delete_content(specials);
+            break;
+        }
+        case species_parser: {
+            std::map<std::string, Species*> species;
+            success = parse::species(path, species);
+            delete_content(species);
+            break;
+        }
+        case techs_parser: {
+            TechManager::TechContainer techs;
+            std::map<std::string, TechCategory*> tech_categories;
+            std::set<std::string> categories_seen_in_techs;
+            success = parse::techs(path, techs, tech_categories, categories_seen_in_techs);
+            for (TechManager::TechContainer::iterator it = techs.begin(); it != techs.end(); ++it)
+                delete *it;
+            delete_content(tech_categories);
+            break;
+        }
+        case items_parser: {
+            std::vector<ItemSpec> items;
+            success = parse::items(path, items);
+            break;
+        }
+        case ship_parts_parser: {
+            std::map<std::string, PartType*> parts;
+            success = parse::ship_parts(path, parts);
+            delete_content(parts);
+            break;
+        }
+        case ship_hulls_parser: {
+            std::map<std::string, HullType*> hulls;
+            success = parse::ship_hulls(path, hulls);
+            delete_content(hulls);
+            break;
+        }
+        case ship_designs_parser: {
+            std::map<std::string, ShipDesign*> designs;
+            success = parse::ship_designs(path, designs);
+            delete_content(designs);
+            break;
+        }
+        case fleet_plans_parser: {
+            std::vector<FleetPlan*> fleet_plans;
+            success = parse::fleet_plans(path, fleet_plans);
+            delete_content(fleet_plans);
+            break;
+        }
+        case monster_fleet_plans_parser: {
+            std::vector<MonsterFleetPlan*> monster_fleet_plans;
+            success = parse::monster_fleet_plans(path, monster_fleet_plans);
+            delete_content(monster_fleet_plans);
+            break;
+        }
+        case alignments_parser: {
+            std::vector<Alignment> alignments;
+            std::vector<boost::shared_ptr<const Effect::EffectsGroup> > effects_groups;
+            success = parse::alignments(path, alignments, effects_groups);
+            break;
+        }
+        default:
+            break;
+        }
+        return success;
+    }
+
+    /** Returns \a path's contents as the file parsers see them, after
+      * inclusions and macros are substituted. */
+    std::string expanded_text(const boost::filesystem::path& path) {
+        std::string filename;
+        std::string file_contents;
+        parse::text_iterator first;
+        parse::token_iterator it;
+        parse::detail::parse_file_common(path, parse::lexer::instance(), filename, file_contents, first, it);
+        return file_contents;
+    }
+
+    bool expand(const boost::filesystem::path& path)
+    { return !expanded_text(path).empty(); }
+
+    double milliseconds_since(const boost::posix_time::ptime& start)
+    { return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1000.0; }
+
+    /** Runs \a run \a iterations times, and prints the time taken by the
+      * first run, which includes constructing the rules used, the mean time
+      * of the others, and the throughput of those in tokens per second.
+      * Returns whether all runs were successful. */
+    bool measure(const std::string& grammar, const std::string& source, std::size_t bytes, std::size_t tokens,
+                 unsigned int iterations, const boost::function<bool ()>& run)
+    {
+        boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+        bool success = run();
+        double first_ms = milliseconds_since(start);
+
+        double mean_ms = first_ms;
+        if (1 < iterations) {
+            start = boost::posix_time::microsec_clock::universal_time();
+            for (unsigned int i = 1; i < iterations; ++i)
+                success = run() && success;
+            mean_ms = milliseconds_since(start) / (iterations - 1);
+        }
+
+        std::cout << std::left << std::setw(36) << grammar << " " << std::setw(32) << source << std::right
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(10) << bytes << " bytes "
+                  << std::setw(8) << tokens << " tokens "
+                  << std::setw(10) << first_ms << " ms first "
+                  << std::setw(10) << mean_ms << " ms mean "
+                  << std::setprecision(0) << std::setw(12) << (mean_ms > 0.0 ? tokens / mean_ms * 1000.0 : 0.0) << " tokens/s"
+                  << (success ? "" : " FAILED") << std::endl;
+        return success;
+    }
+
+    /** Benchmarks \a test on the fixture or content file at \a path. */
+    bool benchmark(test_type test, const std::string& grammar, const boost::filesystem::path& path, unsigned int iterations) {
+        const std::string source = path.filename().string();
+
+        if (buildings_parser <= test && test <= alignments_parser) {
+            std::string text = expanded_text(path);
+            bool success = measure("macro expansion", source, text.size(), 0, iterations, boost::bind(&expand, path));
+            return measure(grammar, source, text.size(), lex(text), iterations, boost::bind(&parse_file, test, path)) && success;
+        }
+
+        std::vector<std::string> lines_ = lines(read_text(path));
+        std::size_t bytes = 0;
+        for (std::size_t i = 0; i < lines_.size(); ++i)
+            bytes += lines_[i].size();
+        std::size_t tokens = lex_lines(lines_);
+        if (test == lexer)
+            return measure(grammar, source, bytes, tokens, iterations, boost::bind(&run_lexer, boost::cref(lines_)));
+        return measure(grammar, source, bytes, tokens, iterations, boost::bind(&parse_lines, test, boost::cref(lines_)));
+    }
+
+    /** Benchmarks the lexer and the file parsers on the content in
+      * \a directory, such as default/. */
+    bool benchmark_content(const boost::filesystem::path& directory, unsigned int iterations) {
+        const std::pair<test_type, const char*> CONTENT[] = {
+            std::make_pair(techs_parser,                "techs.txt"),
+            std::make_pair(species_parser,              "species.txt"),
+            std::make_pair(buildings_parser,            "buildings.txt"),
+            std::make_pair(specials_parser,             "specials.txt"),
+            std::make_pair(ship_parts_parser,           "ship_parts.txt"),
+            std::make_pair(ship_hulls_parser,           "ship_hulls.txt"),
+            std::make_pair(ship_designs_parser,         "premade_ship_designs.txt"),
+            std::make_pair(ship_designs_parser,         "space_monsters.txt"),
+            std::make_pair(fleet_plans_parser,          "starting_fleets.txt"),
+            std::make_pair(monster_fleet_plans_parser,  "space_monster_spawn_fleets.txt"),
+            std::make_pair(items_parser,                "preunlocked_items.txt"),
+            std::make_pair(alignments_parser,           "alignments.txt")
+        };
+        const char* TEST_NAMES[] = {
+            "techs_parser", "species_parser", "buildings_parser", "specials_parser", "ship_parts_parser",
+            "ship_hulls_parser", "ship_designs_parser", "ship_designs_parser", "fleet_plans_parser",
+            "monster_fleet_plans_parser", "items_parser", "alignments_parser"
+        };
+        const std::size_t NUM_CONTENT_FILES = sizeof(CONTENT) / sizeof(CONTENT[0]);
+
+        bool success = true;
+        for (std::size_t i = 0; i < NUM_CONTENT_FILES; ++i) {
+            const boost::filesystem::path path = directory / CONTENT[i].second;
+            const std::vector<std::string> texts(1, expanded_text(path));
+            success = measure("lexer", CONTENT[i].second, texts[0].size(), lex_lines(texts), iterations,
+                              boost::bind(&run_lexer, boost::cref(texts))) && success;
+        }
+        for (std::size_t i = 0; i < NUM_CONTENT_FILES; ++i)
+            success = benchmark(CONTENT[i].first, TEST_NAMES[i], directory / CONTENT[i].second, iterations) && success;
+        return success;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    parse::report_error_::send_error_string = &send_error_string;
+
+    int arg = 1;
+    unsigned int iterations = 10;
+    if (arg + 1 < argc && std::string(argv[arg]) == "-n") {
+        try {
+            iterations = boost::lexical_cast<unsigned int>(argv[arg + 1]);
+        } catch (const boost::bad_lexical_cast&) {
+            print_benchmark_help();
+            exit(1);
+        }
+        arg += 2;
+    }
+
+    if (argc < arg + 2 || iterations < 1) {
+        print_benchmark_help();
+        exit(1);
+    }
+
+    const std::string grammar = argv[arg++];
+    const test_type test = test_type_from_string(grammar);
+    if (grammar != "content" && test == unknown) {
+        print_benchmark_help();
+        exit(1);
+    }
+
+    // every iteration should parse, instead of reading what the first cached
+    GetOptionsDB().Set("content-cache", false);
+
+    parse::init();
+
+    bool success = true;
+    if (grammar == "content") {
+        success = benchmark_content(argv[arg], iterations);
+    } else {
+        for (; arg < argc; ++arg)
+            success = benchmark(test, grammar, argv[arg], iterations) && success;
+    }
+
+    return success ? 0 : 1;
+}
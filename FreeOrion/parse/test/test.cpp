@@ -205,10 +205,11 @@ int main(int argc, char* argv[])
 
             bool success = false;
 
-            parse::detail::s_text_it = &first;
-            parse::detail::s_begin = first;
-            parse::detail::s_end = last;
-            parse::detail::s_filename = argc == 4 ? argv[3] : "command-line";
+            parse::detail::text_being_parsed& text = parse::detail::current_text();
+            text.text_it = &first;
+            text.begin = first;
+            text.end = last;
+            text.filename = argc == 4 ? argv[3] : "command-line";
             parse::token_iterator it = l.begin(first, last);
             const parse::token_iterator end_it = l.end();
 
@@ -348,7 +348,7 @@ namespace FreeOrionPython {
             .def("buildingTypeAvailable",           &Empire::BuildingTypeAvailable)
             .add_property("availableBuildingTypes", make_function(&Empire::AvailableBuildingTypes,  return_internal_reference<>()))
             .def("shipDesignAvailable",             &Empire::ShipDesignAvailable)
-            .add_property("allShipDesigns",         make_function(&Empire::ShipDesigns,             return_value_policy<return_by_value>()))
+            .add_property("allShipDesigns",         make_function(&Empire::ShipDesigns,             return_internal_reference<>()))
             .add_property("availableShipDesigns",   make_function(&Empire::AvailableShipDesigns,    return_value_policy<return_by_value>()))
             .add_property("productionQueue",        make_function(&Empire::GetProductionQueue,      return_internal_reference<>()))
             .def("productionCostAndTime",           make_function(
@@ -16,6 +16,7 @@
 
 #include <boost/mpl/vector.hpp>
 #include <boost/python.hpp>
+#include <boost/python/stl_iterator.hpp>
 #include <boost/python/suite/indexing/map_indexing_suite.hpp>
 
 namespace {
@@ -55,6 +56,32 @@ namespace {
     std::vector<int>        BuildingIDs(const Universe& universe)
     { return Objects().FindObjectIDs<Building>(); }
 
+    /** Returns the values of the meter of type \a meter_type, as returned by
+      * \a meter_value, of the objects with the ids in \a object_ids, indexed
+      * by object id.  \a object_ids may be any iterable Python object, and
+      * ids of objects that don't exist are skipped.  This lets the AI get a
+      * meter of many objects in one call, instead of one call per object. */
+    std::map<int, double>   MeterValues(const boost::python::object& object_ids, MeterType meter_type,
+                                        float (UniverseObject::*meter_value)(MeterType) const)
+    {
+        std::map<int, double> retval;
+        boost::python::stl_input_iterator<int> end;
+        for (boost::python::stl_input_iterator<int> it(object_ids); it != end; ++it) {
+            int object_id = *it;
+            TemporaryPtr<const UniverseObject> obj = ::GetUniverseObject(object_id);
+            if (!obj)
+                continue;
+            retval[object_id] = ((*obj).*meter_value)(meter_type);
+        }
+        return retval;
+    }
+    std::map<int, double>   CurrentMeterValues(const Universe& universe, const boost::python::object& object_ids, MeterType meter_type)
+    { return MeterValues(object_ids, meter_type, &UniverseObject::CurrentMeterValue); }
+    std::map<int, double>   InitialMeterValues(const Universe& universe, const boost::python::object& object_ids, MeterType meter_type)
+    { return MeterValues(object_ids, meter_type, &UniverseObject::InitialMeterValue); }
+    std::map<int, double>   NextTurnCurrentMeterValues(const Universe& universe, const boost::python::object& object_ids, MeterType meter_type)
+    { return MeterValues(object_ids, meter_type, &UniverseObject::NextTurnCurrentMeterValue); }
+
     std::vector<std::string>SpeciesFoci(const Species& species) {
         std::vector<std::string> retval;
         const std::vector<FocusType>& foci = species.Foci();
@@ -184,8 +211,9 @@ namespace {
     boost::function<std::vector<int> (const Universe&, int, int)> VisibilityTurnsFunc =         &VisibilityTurnsP;
 
     const Meter*            (UniverseObject::*ObjectGetMeter)(MeterType) const =                &UniverseObject::GetMeter;
-    const std::map<MeterType, Meter>&
-                            (UniverseObject::*ObjectMeters)(void) const =                       &UniverseObject::Meters;
+
+    std::map<MeterType, Meter> ObjectMeters(const UniverseObject& object)
+    { return object.Meters().ToMap(); }
 
     std::vector<std::string> ObjectSpecials(const UniverseObject& object) {
         std::vector<std::string> retval;
@@ -196,8 +224,9 @@ namespace {
     }
 
     const Meter*            (Ship::*ShipGetPartMeter)(MeterType, const std::string&) const =    &Ship::GetPartMeter;
-    const Ship::PartMeterMap&
-                            (Ship::*ShipPartMeters)(void) const =                               &Ship::PartMeters;
+
+    std::map<std::pair<MeterType, std::string>, Meter> ShipPartMeters(const Ship& ship)
+    { return ship.PartMeters().ToMap(); }
 
     bool                    (*ValidDesignHullAndParts)(const std::string& hull,
                                                        const std::vector<std::string>& parts) = &ShipDesign::ValidDesign;
@@ -294,6 +323,11 @@ namespace FreeOrionPython {
             .add_property("shipIDs",            make_function(ShipIDs,              return_value_policy<return_by_value>()))
             .add_property("buildingIDs",        make_function(BuildingIDs,          return_value_policy<return_by_value>()))
             .def("destroyedObjectIDs",          make_function(&Universe::EmpireKnownDestroyedObjectIDs,
+                                                                                    return_internal_reference<>()))
+
+            .def("currentMeterValues",          make_function(CurrentMeterValues,   return_value_policy<return_by_value>()))
+            .def("initialMeterValues",          make_function(InitialMeterValues,   return_value_policy<return_by_value>()))
+            .def("nextTurnCurrentMeterValues",  make_function(NextTurnCurrentMeterValues,
                                                                                     return_value_policy<return_by_value>()))
 
             .def("systemHasStarlane",           &Universe::SystemHasVisibleStarlanes)
@@ -346,10 +380,7 @@ namespace FreeOrionPython {
                                                     return_value_policy<return_by_value>()
                                                 ))
 
-            .def("getVisibilityTurnsMap",       make_function(
-                                                    &Universe::GetObjectVisibilityTurnMapByEmpire,
-                                                    return_value_policy<return_by_value>()
-                                                ))
+            .def("getVisibilityTurnsMap",       &Universe::GetObjectVisibilityTurnMapByEmpire)
 
             .def("getVisibilityTurns",          make_function(
                                                     VisibilityTurnsFunc,
@@ -389,14 +420,14 @@ namespace FreeOrionPython {
             .def("specialAddedOnTurn",          &UniverseObject::SpecialAddedOnTurn)
             .def("contains",                    &UniverseObject::Contains)
             .def("containedBy",                 &UniverseObject::ContainedBy)
-            .add_property("containedObjects",   make_function(&UniverseObject::ContainedObjectIDs,  return_value_policy<return_by_value>()))
+            .add_property("containedObjects",   make_function(&UniverseObject::ContainedObjectIDs,  return_internal_reference<>()))
             .add_property("containerObject",    &UniverseObject::ContainerObjectID)
             .def("currentMeterValue",           &UniverseObject::CurrentMeterValue)
             .def("initialMeterValue",           &UniverseObject::InitialMeterValue)
             .def("nextTurnCurrentMeterValue",   &UniverseObject::NextTurnCurrentMeterValue)
             .add_property("tags",               make_function(&UniverseObject::Tags,        return_value_policy<return_by_value>()))
             .def("hasTag",                      &UniverseObject::HasTag)
-            .add_property("meters",             make_function(ObjectMeters,                 return_internal_reference<>()))
+            .add_property("meters",             make_function(ObjectMeters,                 return_value_policy<return_by_value>()))
             .def("getMeter",                    make_function(ObjectGetMeter,               return_internal_reference<>()))
         ;
 
@@ -441,7 +472,7 @@ namespace FreeOrionPython {
             .add_property("orderedInvadePlanet",    &Ship::OrderedInvadePlanet)
             .def("initialPartMeterValue",           &Ship::InitialPartMeterValue)
             .def("currentPartMeterValue",           &Ship::CurrentPartMeterValue)
-            .add_property("partMeters",             make_function(ShipPartMeters,           return_internal_reference<>()))
+            .add_property("partMeters",             make_function(ShipPartMeters,           return_value_policy<return_by_value>()))
             .def("getMeter",                        make_function(ShipGetPartMeter,         return_internal_reference<>()))
         ;
 
@@ -572,11 +603,11 @@ namespace FreeOrionPython {
             .def("HasStarlaneToSystemID",       &System::HasStarlaneTo)
             .def("HasWormholeToSystemID",       &System::HasWormholeTo)
             .add_property("starlanesWormholes", make_function(&System::StarlanesWormholes,  return_value_policy<return_by_value>()))
-            .add_property("planetIDs",          make_function(&System::PlanetIDs,           return_value_policy<return_by_value>()))
-            .add_property("buildingIDs",        make_function(&System::BuildingIDs,         return_value_policy<return_by_value>()))
-            .add_property("fleetIDs",           make_function(&System::FleetIDs,            return_value_policy<return_by_value>()))
-            .add_property("shipIDs",            make_function(&System::ShipIDs,             return_value_policy<return_by_value>()))
-            .add_property("fieldIDs",           make_function(&System::FieldIDs,            return_value_policy<return_by_value>()))
+            .add_property("planetIDs",          make_function(&System::PlanetIDs,           return_internal_reference<>()))
+            .add_property("buildingIDs",        make_function(&System::BuildingIDs,         return_internal_reference<>()))
+            .add_property("fleetIDs",           make_function(&System::FleetIDs,            return_internal_reference<>()))
+            .add_property("shipIDs",            make_function(&System::ShipIDs,             return_internal_reference<>()))
+            .add_property("fieldIDs",           make_function(&System::FieldIDs,            return_internal_reference<>()))
             .add_property("lastTurnBattleHere", &System::LastTurnBattleHere)
         ;
 
@@ -619,7 +650,7 @@ namespace FreeOrionPython {
             .add_property("preferredFocus",     make_function(&Species::PreferredFocus, return_value_policy<copy_const_reference>()))
             .add_property("canColonize",        make_function(&Species::CanColonize,    return_value_policy<return_by_value>()))
             .add_property("canProduceShips",    make_function(&Species::CanProduceShips,return_value_policy<return_by_value>()))
-            .add_property("tags",               make_function(&Species::Tags,           return_value_policy<return_by_value>()))
+            .add_property("tags",               make_function(&Species::Tags,           return_internal_reference<>()))
             // TODO: const std::vector<FocusType>& Species::Foci()
             .def("getPlanetEnvironment",        &Species::GetPlanetEnvironment)
         ;
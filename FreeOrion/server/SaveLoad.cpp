@@ -10,6 +10,7 @@
 #include "../universe/ShipDesign.h"
 #include "../universe/System.h"
 #include "../universe/Species.h"
+#include "../util/Compression.h"
 #include "../util/Directories.h"
 #include "../util/i18n.h"
 #include "../util/Logger.h"
@@ -30,8 +31,10 @@
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include <fstream>
+#include <sstream>
 
 
 namespace fs = boost::filesystem;
@@ -91,6 +94,23 @@ namespace {
     }
 
     const std::string UNABLE_TO_OPEN_FILE("Unable to open file");
+
+    /** Returns the archive to read the save game data that follows the
+      * preview and galaxy setup data from.  Saves store that data in a
+      * separate, possibly compressed, archive, which is decompressed into
+      * \a data_stream and opened as \a data_archive.  Older saves continue
+      * in the archive \a ia, which is returned in that case. */
+    freeorion_iarchive& SaveGameDataArchive(std::istream& is, freeorion_iarchive& ia,
+                                            std::istringstream& data_stream,
+                                            boost::scoped_ptr<freeorion_iarchive>& data_archive)
+    {
+        std::string data;
+        if (!DecompressData(is, data))
+            return ia;
+        data_stream.str(data);
+        data_archive.reset(new freeorion_iarchive(data_stream));
+        return *data_archive;
+    }
 }
 
 void SaveGame(const std::string& filename, const ServerSaveGameData& server_save_game_data,
@@ -136,13 +156,24 @@ void SaveGame(const std::string& filename, const ServerSaveGameData& server_save
         freeorion_oarchive oa(ofs);
         oa << BOOST_SERIALIZATION_NVP(save_preview_data);
         oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
-        oa << BOOST_SERIALIZATION_NVP(server_save_game_data);
-        oa << BOOST_SERIALIZATION_NVP(player_save_game_data);
-        oa << BOOST_SERIALIZATION_NVP(empire_save_game_data);
-        oa << BOOST_SERIALIZATION_NVP(empire_manager);
-        oa << BOOST_SERIALIZATION_NVP(species_manager);
-        oa << BOOST_SERIALIZATION_NVP(combat_log_manager);
-        Serialize(oa, universe);
+
+        // the rest goes into a separate archive, which is compressed.  the
+        // preview and galaxy setup data stay uncompressed, so that save
+        // previews can be read without decompressing the whole save
+        std::ostringstream data_os;
+        {
+            freeorion_oarchive data_oa(data_os);
+            data_oa << BOOST_SERIALIZATION_NVP(server_save_game_data);
+            data_oa << BOOST_SERIALIZATION_NVP(player_save_game_data);
+            data_oa << BOOST_SERIALIZATION_NVP(empire_save_game_data);
+            data_oa << BOOST_SERIALIZATION_NVP(empire_manager);
+            data_oa << BOOST_SERIALIZATION_NVP(species_manager);
+            data_oa << BOOST_SERIALIZATION_NVP(combat_log_manager);
+            Serialize(data_oa, universe);
+        }
+        std::string compressed_data;
+        CompressData(data_os.str(), compressed_data);
+        ofs.write(compressed_data.data(), compressed_data.size());
     } catch (const std::exception& e) {
         Logger().errorStream() << UserString("UNABLE_TO_WRITE_SAVE_FILE") << " SaveGame exception: " << ": " << e.what();
         throw e;
@@ -189,21 +220,25 @@ void LoadGame(const std::string& filename, ServerSaveGameData& server_save_game_
         Logger().debugStream() << "LoadGame : Reading Galaxy Setup Data";
         ia >> BOOST_SERIALIZATION_NVP(galaxy_setup_data);
 
+        std::istringstream data_is;
+        boost::scoped_ptr<freeorion_iarchive> data_ia;
+        freeorion_iarchive& save_ia = SaveGameDataArchive(ifs, ia, data_is, data_ia);
+
         Logger().debugStream() << "LoadGame : Reading Server Save Game Data";
-        ia >> BOOST_SERIALIZATION_NVP(server_save_game_data);
+        save_ia >> BOOST_SERIALIZATION_NVP(server_save_game_data);
         Logger().debugStream() << "LoadGame : Reading Player Save Game Data";
-        ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
+        save_ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
 
         Logger().debugStream() << "LoadGame : Reading Empire Save Game Data (Ignored)";
-        ia >> BOOST_SERIALIZATION_NVP(ignored_save_game_empire_data);
+        save_ia >> BOOST_SERIALIZATION_NVP(ignored_save_game_empire_data);
         Logger().debugStream() << "LoadGame : Reading Empires Data";
-        ia >> BOOST_SERIALIZATION_NVP(empire_manager);
+        save_ia >> BOOST_SERIALIZATION_NVP(empire_manager);
         Logger().debugStream() << "LoadGame : Reading Species Data";
-        ia >> BOOST_SERIALIZATION_NVP(species_manager);
+        save_ia >> BOOST_SERIALIZATION_NVP(species_manager);
         Logger().debugStream() << "LoadGame : Reading Combat Logs";
-        ia >> BOOST_SERIALIZATION_NVP(combat_log_manager);
+        save_ia >> BOOST_SERIALIZATION_NVP(combat_log_manager);
         Logger().debugStream() << "LoadGame : Reading Universe Data";
-        Deserialize(ia, universe);
+        Deserialize(save_ia, universe);
     } catch (const std::exception& e) {
         Logger().errorStream() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadGame exception: " << ": " << e.what();
         throw e;
@@ -259,8 +294,12 @@ void LoadPlayerSaveGameData(const std::string& filename, std::vector<PlayerSaveG
         freeorion_iarchive ia(ifs);
         ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
         ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
-        ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
-        ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
+
+        std::istringstream data_is;
+        boost::scoped_ptr<freeorion_iarchive> data_ia;
+        freeorion_iarchive& save_ia = SaveGameDataArchive(ifs, ia, data_is, data_ia);
+        save_ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
+        save_ia >> BOOST_SERIALIZATION_NVP(player_save_game_data);
         // skipping additional deserialization which is not needed for this function
     } catch (const std::exception& e) {
         Logger().errorStream() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadPlayerSaveGameData exception: " << ": " << e.what();
@@ -291,9 +330,13 @@ void LoadEmpireSaveGameData(const std::string& filename, std::map<int, SaveGameE
         freeorion_iarchive ia(ifs);
         ia >> BOOST_SERIALIZATION_NVP(ignored_save_preview_data);
         ia >> BOOST_SERIALIZATION_NVP(ignored_galaxy_setup_data);
-        ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
-        ia >> BOOST_SERIALIZATION_NVP(ignored_player_save_game_data);
-        ia >> BOOST_SERIALIZATION_NVP(empire_save_game_data);
+
+        std::istringstream data_is;
+        boost::scoped_ptr<freeorion_iarchive> data_ia;
+        freeorion_iarchive& save_ia = SaveGameDataArchive(ifs, ia, data_is, data_ia);
+        save_ia >> BOOST_SERIALIZATION_NVP(ignored_server_save_game_data);
+        save_ia >> BOOST_SERIALIZATION_NVP(ignored_player_save_game_data);
+        save_ia >> BOOST_SERIALIZATION_NVP(empire_save_game_data);
         // skipping additional deserialization which is not needed for this function
     } catch (const std::exception& e) {
         Logger().errorStream() << UserString("UNABLE_TO_READ_SAVE_FILE") << " LoadEmpireSaveGameData exception: " << ": " << e.what();
@@ -25,6 +25,7 @@
 #include "../util/OptionsDB.h"
 #include "../util/Order.h"
 #include "../util/OrderSet.h"
+#include "../util/RunQueue.h"
 #include "../util/SaveGamePreviewUtils.h"
 #include "../util/SitRepEntry.h"
 #include "../util/ScopedTimer.h"
@@ -36,16 +37,97 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/functional/hash.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 
 
 #include <ctime>
+#include <deque>
 
 namespace fs = boost::filesystem;
 
 void Seed(unsigned int seed);
 
 namespace {
+    void AddOptions(OptionsDB& db) {
+        db.Add("turn-update-threads", UserStringNop("OPTIONS_DB_TURN_UPDATE_THREADS_DESC"), 4, RangedValidator<int>(1, 32));
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    /** Turn update messages that have been serialized, but not yet sent. */
+    struct CompletedTurnUpdates {
+        typedef std::pair<PlayerConnectionPtr, boost::shared_ptr<Message> > Update;
+
+        boost::mutex                mutex;
+        boost::condition_variable   update_completed;
+        std::deque<Update>          updates;    ///< player and message
+    };
+
+    /** Serializes the turn update for one player and adds it to the completed
+      * updates.  Several of these can run concurrently, as the encoding empire
+      * is set separately for each thread and serializing only reads the
+      * Universe (see Universe::GetObjectsToSerialize()).  If the update can't
+      * be delta encoded, a complete update is sent instead. */
+    class TurnUpdateWorkItem {
+    public:
+        TurnUpdateWorkItem(PlayerConnectionPtr player, int empire_id, int current_turn,
+                           const EmpireManager& empires, const Universe& universe,
+                           const std::map<int, PlayerInfo>& players, std::string& previous_update,
+                           CompletedTurnUpdates& completed) :
+            m_player(player),
+            m_empire_id(empire_id),
+            m_current_turn(current_turn),
+            m_empires(&empires),
+            m_universe(&universe),
+            m_players(&players),
+            m_previous_update(&previous_update),
+            m_completed(&completed)
+        {}
+
+        void operator ()() {
+            boost::shared_ptr<Message> message;
+            try {
+                message.reset(new Message(TurnUpdateMessage(m_player->PlayerID(), m_empire_id, m_current_turn,
+                                                             *m_empires, *m_universe, GetSpeciesManager(),
+                                                             GetCombatLogManager(), *m_players,
+                                                             *m_previous_update)));
+            } catch (const std::exception& e) {
+                Logger().errorStream() << "TurnUpdateWorkItem couldn't serialize turn update for player "
+                                       << m_player->PlayerID() << ": " << e.what() << "; sending a complete update instead";
+                m_previous_update->clear();
+                try {
+                    message.reset(new Message(TurnUpdateMessage(m_player->PlayerID(), m_empire_id, m_current_turn,
+                                                                 *m_empires, *m_universe, GetSpeciesManager(),
+                                                                 GetCombatLogManager(), *m_players,
+                                                                 *m_previous_update)));
+                } catch (const std::exception& e) {
+                    // without a turn update, the player can't continue the game
+                    Logger().errorStream() << "TurnUpdateWorkItem couldn't serialize complete turn update for player "
+                                           << m_player->PlayerID() << ": " << e.what();
+                    m_previous_update->clear();
+                    message.reset(new Message(ErrorMessage(m_player->PlayerID(), UserStringNop("SERVER_TURN_UPDATE_FAILED"), true)));
+                }
+            }
+            {
+                boost::unique_lock<boost::mutex> lock(m_completed->mutex);
+                m_completed->updates.push_back(std::make_pair(m_player, message));
+            }
+            m_completed->update_completed.notify_one();
+        }
+
+    private:
+        PlayerConnectionPtr                 m_player;
+        int                                 m_empire_id;
+        int                                 m_current_turn;
+        const EmpireManager*                m_empires;
+        const Universe*                     m_universe;
+        const std::map<int, PlayerInfo>*    m_players;
+        std::string*                        m_previous_update;
+        CompletedTurnUpdates*               m_completed;
+    };
+
     //If there's only one other empire, return their ID:
     int EnemyId(int empire_id, const std::set<int> &empire_ids) {
         if (empire_ids.size() == 2) {
@@ -135,6 +217,8 @@ ServerApp::ServerApp() :
 
     m_fsm->initiate();
 
+    m_universe.SetPrecomputeSystemJumps(true);
+
     GG::Connect(Empires().DiplomaticStatusChangedSignal,  &ServerApp::HandleDiplomaticStatusChange, this);
     GG::Connect(Empires().DiplomaticMessageChangedSignal, &ServerApp::HandleDiplomaticMessageChange,this);
 }
@@ -368,6 +452,7 @@ void ServerApp::HandleMessage(Message& msg, PlayerConnectionPtr player_connectio
     case Message::DIPLOMACY:                m_fsm->process_event(Diplomacy(msg, player_connection));        break;
     case Message::REQUEST_NEW_OBJECT_ID:    m_fsm->process_event(RequestObjectID(msg, player_connection));  break;
     case Message::REQUEST_NEW_DESIGN_ID:    m_fsm->process_event(RequestDesignID(msg, player_connection));  break;
+    case Message::REQUEST_FULL_TURN_UPDATE: m_fsm->process_event(RequestFullTurnUpdate(msg, player_connection));    break;
     case Message::MODERATOR_ACTION:         m_fsm->process_event(ModeratorAct(msg, player_connection));     break;
 
     // TODO: For prototyping only.
@@ -635,6 +720,7 @@ void ServerApp::NewGameInit(const GalaxySetupData& galaxy_setup_data,
     m_turn_sequence.clear();
     m_eliminated_players.clear();
     m_player_empire_ids.clear();
+    m_turn_updates_sent.clear();
 
 
     // set server state info for new game
@@ -1016,6 +1102,7 @@ void ServerApp::LoadGameInit(const std::vector<PlayerSaveGameData>& player_save_
     m_turn_sequence.clear();
     m_eliminated_players.clear();
     m_player_empire_ids.clear();
+    m_turn_updates_sent.clear();
 
 
     // restore server state info from save
@@ -2975,6 +3062,13 @@ void ServerApp::PostCombatProcessTurns() {
     m_networking.SendMessage(TurnProgressMessage(Message::DOWNLOADING));
 
 
+    Logger().debugStream() << "ServerApp::PostCombatProcessTurns Sending turn updates to players";
+    std::vector<PlayerConnectionPtr> recipients(m_networking.established_begin(), m_networking.established_end());
+    SendTurnUpdates(recipients);
+    Logger().debugStream() << "ServerApp::PostCombatProcessTurns done";
+}
+
+void ServerApp::SendTurnUpdates(const std::vector<PlayerConnectionPtr>& recipients) {
     // compile map of PlayerInfo, indexed by player ID
     std::map<int, PlayerInfo> players;
     for (ServerNetworking::const_established_iterator player_it = m_networking.established_begin();
@@ -2988,19 +3082,40 @@ void ServerApp::PostCombatProcessTurns() {
                                         m_networking.PlayerIsHost(player_id));
     }
 
-    Logger().debugStream() << "ServerApp::PostCombatProcessTurns Sending turn updates to players";
-    // send new-turn updates to all players
-    for (ServerNetworking::const_established_iterator player_it = m_networking.established_begin();
-         player_it != m_networking.established_end(); ++player_it)
+    // the updates are serialized concurrently and each is sent as soon as it
+    // is ready
+    m_universe.AuditEmpireLatestKnownObjects();
+    CompletedTurnUpdates completed; // create before run_queue, destroy after run_queue
+    unsigned int num_threads = static_cast<unsigned int>(std::max(1, GetOptionsDB().Get<int>("turn-update-threads")));
+    RunQueue<TurnUpdateWorkItem> run_queue(num_threads);
+    std::size_t num_updates = 0;
+    for (std::vector<PlayerConnectionPtr>::const_iterator player_it = recipients.begin();
+         player_it != recipients.end(); ++player_it)
     {
         PlayerConnectionPtr player = *player_it;
         int player_id = player->PlayerID();
-        player->SendMessage(TurnUpdateMessage(player_id,                PlayerEmpireID(player_id),
-                                              m_current_turn,           m_empires,
-                                              m_universe,               GetSpeciesManager(),
-                                              GetCombatLogManager(),    players));
+        run_queue.AddWork(new TurnUpdateWorkItem(player,                    PlayerEmpireID(player_id),
+                                                 m_current_turn,            m_empires,
+                                                 m_universe,                players,
+                                                 m_turn_updates_sent[player_id], completed));
+        ++num_updates;
+    }
+    for (std::size_t i = 0; i < num_updates; ++i) {
+        CompletedTurnUpdates::Update update;
+        {
+            boost::unique_lock<boost::mutex> lock(completed.mutex);
+            while (completed.updates.empty())
+                completed.update_completed.wait(lock);
+            update = completed.updates.front();
+            completed.updates.pop_front();
+        }
+        update.first->SendMessage(*update.second);
     }
-    Logger().debugStream() << "ServerApp::PostCombatProcessTurns done";
+}
+
+void ServerApp::SendFullTurnUpdate(PlayerConnectionPtr player) {
+    m_turn_updates_sent[player->PlayerID()].clear();
+    SendTurnUpdates(std::vector<PlayerConnectionPtr>(1, player));
 }
 
 void ServerApp::CheckForEmpireEliminationOrVictory() {
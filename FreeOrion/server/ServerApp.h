@@ -128,6 +128,14 @@ public:
       * eliminated or victorious empires / players, sends new turn updates. */
     void    PostCombatProcessTurns();
 
+    /** Serializes the turn updates for the current turn and sends them to the
+      * \a recipients. */
+    void    SendTurnUpdates(const std::vector<PlayerConnectionPtr>& recipients);
+
+    /** Sends the turn update for the current turn to \a player again, without
+      * delta encoding, for a client that couldn't apply the one it got. */
+    void    SendFullTurnUpdate(PlayerConnectionPtr player);
+
     /** Determines if any empires are eliminated (for the first time this turn,
       * skipping any which were also eliminated previously) and if any empires
       * are victorious.  Informs players of victories or eliminations, and
@@ -248,6 +256,8 @@ private:
     ServerNetworking        m_networking;
     ServerFSM*              m_fsm;
     std::map<int, int>      m_player_empire_ids;    ///< map from player id to empire id that the player controls.
+    std::map<int, std::string>
+                            m_turn_updates_sent;    ///< map from player id to the contents of the last turn update sent to the player, against which the next one is delta-encoded
     int                     m_current_turn;         ///< current turn number
     std::vector<Process>    m_ai_client_processes;  ///< AI client child processes
     bool                    m_single_player_game;   ///< true when the game being played is single-player
@@ -1256,6 +1256,14 @@ sc::result WaitingForTurnEnd::react(const RequestDesignID& msg) {
     return discard_event();
 }
 
+sc::result WaitingForTurnEnd::react(const RequestFullTurnUpdate& msg) {
+    if (TRACE_EXECUTION) Logger().debugStream() << "(ServerFSM) WaitingForTurnEnd.RequestFullTurnUpdate";
+    Logger().debugStream() << "WaitingForTurnEnd::react(RequestFullTurnUpdate) player " << msg.m_player_connection->PlayerID()
+                           << " couldn't apply its turn update; resending it in full";
+    Server().SendFullTurnUpdate(msg.m_player_connection);
+    return discard_event();
+}
+
 sc::result WaitingForTurnEnd::react(const CheckTurnEndConditions& c) {
     if (TRACE_EXECUTION) Logger().debugStream() << "(ServerFSM) WaitingForTurnEnd.CheckTurnEndConditions";
     ServerApp& server = Server();
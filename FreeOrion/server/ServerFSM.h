@@ -74,6 +74,7 @@ struct MessageEventBase {
     (ClientSaveData)                        \
     (RequestObjectID)                       \
     (RequestDesignID)                       \
+    (RequestFullTurnUpdate)                 \
     (PlayerChat)                            \
     (Diplomacy)                             \
     (ModeratorAct)
@@ -268,6 +269,7 @@ struct WaitingForTurnEnd : sc::state<WaitingForTurnEnd, PlayingGame, WaitingForT
         sc::custom_reaction<TurnOrders>,
         sc::custom_reaction<RequestObjectID>,
         sc::custom_reaction<RequestDesignID>,
+        sc::custom_reaction<RequestFullTurnUpdate>,
         sc::custom_reaction<CheckTurnEndConditions>
     > reactions;
 
@@ -277,6 +279,7 @@ struct WaitingForTurnEnd : sc::state<WaitingForTurnEnd, PlayingGame, WaitingForT
     sc::result react(const TurnOrders& msg);
     sc::result react(const RequestObjectID& msg);
     sc::result react(const RequestDesignID& msg);
+    sc::result react(const RequestFullTurnUpdate& msg);
     sc::result react(const CheckTurnEndConditions& c);
 
     std::string m_save_filename;
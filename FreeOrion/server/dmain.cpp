@@ -51,6 +51,7 @@ int wmain(int argc, wchar_t* argv[], wchar_t* envp[]) {
         }
 
         parse::init();
+        parse::preload_content();
 
         ServerApp g_app;
         g_app(); // Calls ServerApp::Run() to run app (intialization and main process loop)
@@ -173,6 +173,10 @@ private:
     const Condition::ConditionBase*                             m_enqueue_location;
     std::vector<boost::shared_ptr<const Effect::EffectsGroup> > m_effects;
     std::string                                                 m_icon;
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
 };
 
 /** Holds all FreeOrion building types.  Types may be looked up by name. */
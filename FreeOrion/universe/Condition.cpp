@@ -22,11 +22,31 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/st_connected.hpp>
 
+#include <deque>
+
 using boost::io::str;
 
 extern int g_indent;
 
 namespace {
+    /** Returns the dependencies of evaluating \a ref.  Only constant
+      * expressions are known not to depend on any game state. */
+    template <class T>
+    unsigned int ValueRefDependencies(const ValueRef::ValueRefBase<T>* ref) {
+        if (!ref || ValueRef::ConstantExpr(ref))
+            return Condition::DEPENDS_ON_NOTHING;
+        return Condition::DEPENDS_ON_ANYTHING;
+    }
+
+    template <class T>
+    unsigned int ValueRefDependencies(const std::vector<const ValueRef::ValueRefBase<T>*>& refs) {
+        unsigned int retval = Condition::DEPENDS_ON_NOTHING;
+        for (typename std::vector<const ValueRef::ValueRefBase<T>*>::const_iterator it = refs.begin();
+             it != refs.end(); ++it)
+        { retval |= ValueRefDependencies(*it); }
+        return retval;
+    }
+
     void AddAllObjectsSet(Condition::ObjectSet& condition_non_targets) {
         condition_non_targets.reserve(condition_non_targets.size() + Objects().NumExistingObjects());
         std::transform( Objects().ExistingObjectsBegin(), Objects().ExistingObjectsEnd(),
@@ -90,13 +110,36 @@ namespace {
                         boost::bind(&std::map< int, TemporaryPtr< UniverseObject > >::value_type::second,_1) );
     }
 
+    void AddObjectIndexSet(const std::map<int, TemporaryPtr<UniverseObject> >& index,
+                           Condition::ObjectSet& condition_non_targets)
+    {
+        condition_non_targets.reserve(condition_non_targets.size() + index.size());
+        std::transform( index.begin(), index.end(),
+                        std::back_inserter(condition_non_targets),
+                        boost::bind(&std::map< int, TemporaryPtr< UniverseObject > >::value_type::second,_1) );
+    }
+
+    /** Returns true and puts the values of \a refs into \a values if they are
+      * all constant expressions. */
+    template <class T>
+    bool ConstantValues(const std::vector<const ValueRef::ValueRefBase<T>*>& refs, std::vector<T>& values) {
+        for (typename std::vector<const ValueRef::ValueRefBase<T>*>::const_iterator it = refs.begin();
+             it != refs.end(); ++it)
+        {
+            if (!ValueRef::ConstantExpr(*it))
+                return false;
+            values.push_back((*it)->Eval());
+        }
+        return true;
+    }
+
     /** Attempts to cast \a obj to a Fleet pointer. If that fails, attempts to
       * cast \a obj to a Ship pointer, and then get the Fleet of the ship. If
       * both fail then returns a null object Fleet pointer. */
-    TemporaryPtr<const Fleet> FleetFromObject(TemporaryPtr<const UniverseObject> obj) {
-        TemporaryPtr<const Fleet> retval = boost::dynamic_pointer_cast<const Fleet>(obj);
+    ObjectHandle<const Fleet> FleetFromObject(ObjectHandle<const UniverseObject> obj) {
+        ObjectHandle<const Fleet> retval = boost::dynamic_pointer_cast<const Fleet>(obj);
         if (!retval) {
-            if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(obj))
+            if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(obj))
                 retval = GetFleet(ship->FleetID());
         }
         return retval;
@@ -229,7 +272,7 @@ struct Condition::ConditionBase::MatchHelper {
         m_parent_context(parent_context)
     {}
 
-    bool operator()(TemporaryPtr<const UniverseObject> candidate) const
+    bool operator()(ObjectHandle<const UniverseObject> candidate) const
     { return m_this->Match(ScriptingContext(m_parent_context, candidate)); }
 
     const Condition::ConditionBase* m_this;
@@ -273,7 +316,7 @@ void Condition::ConditionBase::Eval(Condition::ObjectSet& matches) const
 { Eval(ScriptingContext(), matches); }
 
 bool Condition::ConditionBase::Eval(const ScriptingContext& parent_context,
-                                    TemporaryPtr<const UniverseObject> candidate) const
+                                    ObjectHandle<const UniverseObject> candidate) const
 {
     if (!candidate)
         return false;
@@ -283,7 +326,7 @@ bool Condition::ConditionBase::Eval(const ScriptingContext& parent_context,
     return non_matches.empty(); // if candidate has been matched, non_matches will now be empty
 }
 
-bool Condition::ConditionBase::Eval(TemporaryPtr<const UniverseObject> candidate) const {
+bool Condition::ConditionBase::Eval(ObjectHandle<const UniverseObject> candidate) const {
     if (!candidate)
         return false;
     Condition::ObjectSet non_matches, matches;
@@ -372,7 +415,7 @@ void Condition::Number::Eval(const ScriptingContext& parent_context,
     // will match anything if the proper number of objects match the
     // subcondition.  So, the local context that is passed to the subcondition
     // needs to have a null local candidate.
-    TemporaryPtr<const UniverseObject> no_object;
+    ObjectHandle<const UniverseObject> no_object;
     ScriptingContext local_context(parent_context, no_object);
 
     if (!(
@@ -500,7 +543,7 @@ void Condition::Turn::Eval(const ScriptingContext& parent_context,
         // evaluate turn limits once, check range, and use result to match or
         // reject all the search domain, since the current turn doesn't change
         // from object to object, and neither do the range limits.
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         int low =  (m_low ? std::max(BEFORE_FIRST_TURN, m_low->Eval(local_context)) : BEFORE_FIRST_TURN);
         int high = (m_high ? std::min(m_high->Eval(local_context), IMPOSSIBLY_LARGE_TURN) : IMPOSSIBLY_LARGE_TURN);
@@ -679,7 +722,7 @@ namespace {
         }
 
         // get sort key values for all objects in from_set, and sort by inserting into map
-        std::multimap<float, TemporaryPtr<const UniverseObject> > sort_key_objects;
+        std::multimap<float, ObjectHandle<const UniverseObject> > sort_key_objects;
         for (Condition::ObjectSet::const_iterator it = from_set.begin(); it != from_set.end(); ++it) {
             float sort_value = sort_key->Eval(ScriptingContext(context, *it));
             sort_key_objects.insert(std::make_pair(sort_value, *it));
@@ -695,10 +738,10 @@ namespace {
         if (sorting_method == Condition::SORT_MIN) {
             // move (number) objects with smallest sort key (at start of map)
             // from the from_set into the to_set.
-            for (std::multimap<float, TemporaryPtr<const UniverseObject> >::const_iterator sorted_it = sort_key_objects.begin();
+            for (std::multimap<float, ObjectHandle<const UniverseObject> >::const_iterator sorted_it = sort_key_objects.begin();
                  sorted_it != sort_key_objects.end(); ++sorted_it)
             {
-                TemporaryPtr<const UniverseObject> object_to_transfer = sorted_it->second;
+                ObjectHandle<const UniverseObject> object_to_transfer = sorted_it->second;
                 Condition::ObjectSet::iterator from_it = std::find(from_set.begin(), from_set.end(), object_to_transfer);
                 if (from_it != from_set.end()) {
                     *from_it = from_set.back();
@@ -712,10 +755,10 @@ namespace {
         } else if (sorting_method == Condition::SORT_MAX) {
             // move (number) objects with largest sort key (at end of map)
             // from the from_set into the to_set.
-            for (std::multimap<float, TemporaryPtr<const UniverseObject> >::reverse_iterator sorted_it = sort_key_objects.rbegin();  // would use const_reverse_iterator but this causes a compile error in some compilers
+            for (std::multimap<float, ObjectHandle<const UniverseObject> >::reverse_iterator sorted_it = sort_key_objects.rbegin();  // would use const_reverse_iterator but this causes a compile error in some compilers
                  sorted_it != sort_key_objects.rend(); ++sorted_it)
             {
-                TemporaryPtr<const UniverseObject> object_to_transfer = sorted_it->second;
+                ObjectHandle<const UniverseObject> object_to_transfer = sorted_it->second;
                 Condition::ObjectSet::iterator from_it = std::find(from_set.begin(), from_set.end(), object_to_transfer);
                 if (from_it != from_set.end()) {
                     *from_it = from_set.back();
@@ -728,7 +771,7 @@ namespace {
         } else if (sorting_method == Condition::SORT_MODE) {
             // compile histogram of of number of times each sort key occurs
             std::map<float, unsigned int> histogram;
-            for (std::multimap<float, TemporaryPtr<const UniverseObject> >::const_iterator sorted_it = sort_key_objects.begin();
+            for (std::multimap<float, ObjectHandle<const UniverseObject> >::const_iterator sorted_it = sort_key_objects.begin();
                  sorted_it != sort_key_objects.end(); ++sorted_it)
             {
                 histogram[sorted_it->first]++;
@@ -749,15 +792,15 @@ namespace {
                 float cur_sort_key = inv_hist_it->second;
 
                 // get range of objects with the current sort key
-                std::pair<std::multimap<float, TemporaryPtr<const UniverseObject> >::const_iterator,
-                          std::multimap<float, TemporaryPtr<const UniverseObject> >::const_iterator> key_range =
+                std::pair<std::multimap<float, ObjectHandle<const UniverseObject> >::const_iterator,
+                          std::multimap<float, ObjectHandle<const UniverseObject> >::const_iterator> key_range =
                     sort_key_objects.equal_range(cur_sort_key);
 
                 // loop over range, selecting objects to transfer from from_set to to_set
-                for (std::multimap<float, TemporaryPtr<const UniverseObject> >::const_iterator sorted_it = key_range.first;
+                for (std::multimap<float, ObjectHandle<const UniverseObject> >::const_iterator sorted_it = key_range.first;
                      sorted_it != key_range.second; ++sorted_it)
                 {
-                    TemporaryPtr<const UniverseObject> object_to_transfer = sorted_it->second;
+                    ObjectHandle<const UniverseObject> object_to_transfer = sorted_it->second;
                     Condition::ObjectSet::iterator from_it = std::find(from_set.begin(), from_set.end(), object_to_transfer);
                     if (from_it != from_set.end()) {
                         *from_it = from_set.back();
@@ -797,7 +840,7 @@ void Condition::SortedNumberOf::Eval(const ScriptingContext& parent_context,
     // SortedNumberOf does not have a valid local candidate to be matched
     // before the subcondition is evaluated, so the local context that is
     // passed to the subcondition needs to have a null local candidate.
-    TemporaryPtr<const UniverseObject> no_object;
+    ObjectHandle<const UniverseObject> no_object;
     ScriptingContext local_context(parent_context, no_object);
 
     // which input matches match the subcondition?
@@ -839,7 +882,7 @@ void Condition::SortedNumberOf::Eval(const ScriptingContext& parent_context,
     if (search_domain == NON_MATCHES) {
         // put matched objects that are in subcondition_matching_non_matches into matches
         for (ObjectSet::const_iterator match_it = matched_objects.begin(); match_it != matched_objects.end(); ++match_it) {
-            TemporaryPtr<const UniverseObject> matched_object = *match_it;
+            ObjectHandle<const UniverseObject> matched_object = *match_it;
 
             // is this matched object in subcondition_matching_non_matches?
             ObjectSet::iterator smnt_it = std::find(subcondition_matching_non_matches.begin(), subcondition_matching_non_matches.end(), matched_object);
@@ -864,7 +907,7 @@ void Condition::SortedNumberOf::Eval(const ScriptingContext& parent_context,
     } else { /*(search_domain == MATCHES)*/
         // put matched objecs that are in subcondition_matching_matches back into matches
         for (ObjectSet::const_iterator match_it = matched_objects.begin(); match_it != matched_objects.end(); ++match_it) {
-            TemporaryPtr<const UniverseObject> matched_object = *match_it;
+            ObjectHandle<const UniverseObject> matched_object = *match_it;
 
             // is this matched object in subcondition_matching_matches?
             ObjectSet::iterator smt_it = std::find(subcondition_matching_matches.begin(), subcondition_matching_matches.end(), matched_object);
@@ -1044,7 +1087,7 @@ namespace {
             m_affiliation(affiliation)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate || candidate->Unowned())
                 return false;
 
@@ -1098,7 +1141,7 @@ void Condition::EmpireAffiliation::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int empire_id = m_empire_id ? m_empire_id->Eval(ScriptingContext(parent_context, no_object)) : ALL_EMPIRES;
         EvalImpl(matches, non_matches, search_domain, EmpireAffiliationSimpleMatch(empire_id, m_affiliation));
     } else {
@@ -1116,6 +1159,26 @@ bool Condition::EmpireAffiliation::TargetInvariant() const
 bool Condition::EmpireAffiliation::SourceInvariant() const
 { return m_empire_id ? m_empire_id->SourceInvariant() : true; }
 
+unsigned int Condition::EmpireAffiliation::Dependencies() const {
+    // enemies and allies depend on diplomatic statuses, which aren't tracked
+    if (m_affiliation != AFFIL_SELF && m_affiliation != AFFIL_ANY)
+        return DEPENDS_ON_ANYTHING;
+    return DEPENDS_ON_OWNER | ValueRefDependencies(m_empire_id);
+}
+
+void Condition::EmpireAffiliation::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                                     Condition::ObjectSet& condition_non_targets) const
+{
+    // objects owned by a fixed empire can be looked up directly
+    if (m_affiliation == AFFIL_SELF && m_empire_id && ValueRef::ConstantExpr(m_empire_id) &&
+        Objects().ObjectIndexesValid())
+    {
+        AddObjectIndexSet(Objects().ExistingObjectsOwnedBy(m_empire_id->Eval()), condition_non_targets);
+        return;
+    }
+    ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+}
+
 std::string Condition::EmpireAffiliation::Description(bool negated/* = false*/) const {
     std::string empire_str;
     if (m_empire_id) {
@@ -1162,7 +1225,7 @@ std::string Condition::EmpireAffiliation::Dump() const {
 }
 
 bool Condition::EmpireAffiliation::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "EmpireAffiliation::Match passed no candidate object";
         return false;
@@ -1282,13 +1345,13 @@ namespace {
             m_names(names)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a planet or a building on a planet?
-            TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-            TemporaryPtr<const ::Building> building;
+            ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+            ObjectHandle<const ::Building> building;
             if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
                 planet = GetPlanet(building->PlanetID());
             }
@@ -1423,15 +1486,15 @@ std::string Condition::Homeworld::Dump() const {
 }
 
 bool Condition::Homeworld::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Homeworld::Match passed no candidate object";
         return false;
     }
 
     // is it a planet or a building on a planet?
-    TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-    TemporaryPtr<const ::Building> building;
+    ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+    ObjectHandle<const ::Building> building;
     if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
         planet = GetPlanet(building->PlanetID());
     }
@@ -1488,7 +1551,7 @@ std::string Condition::Capital::Dump() const
 { return DumpIndent() + "Capital\n"; }
 
 bool Condition::Capital::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Capital::Match passed no candidate object";
         return false;
@@ -1524,13 +1587,13 @@ std::string Condition::Monster::Dump() const
 { return DumpIndent() + "Monster\n"; }
 
 bool Condition::Monster::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Monster::Match passed no candidate object";
         return false;
     }
 
-    if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
+    if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
         if (ship->IsMonster())
             return true;
 
@@ -1557,13 +1620,13 @@ std::string Condition::Armed::Dump() const
 { return DumpIndent() + "Armed\n"; }
 
 bool Condition::Armed::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Armed::Match passed no candidate object";
         return false;
     }
 
-    if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
+    if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
         if (ship->IsArmed())
             return true;
 
@@ -1595,7 +1658,7 @@ namespace {
             m_type(type)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -1648,6 +1711,9 @@ bool Condition::Type::TargetInvariant() const
 bool Condition::Type::SourceInvariant() const
 { return m_type->SourceInvariant(); }
 
+unsigned int Condition::Type::Dependencies() const
+{ return ValueRefDependencies(m_type); }
+
 std::string Condition::Type::Description(bool negated/* = false*/) const {
     std::string value_str = ValueRef::ConstantExpr(m_type) ?
                                 UserString(boost::lexical_cast<std::string>(m_type->Eval())) :
@@ -1679,7 +1745,7 @@ std::string Condition::Type::Dump() const {
 }
 
 bool Condition::Type::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Type::Match passed no candidate object";
         return false;
@@ -1768,12 +1834,12 @@ namespace {
             m_names(names)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a building?
-            TemporaryPtr<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
+            ObjectHandle<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
             if (!building)
                 return false;
 
@@ -1851,6 +1917,9 @@ bool Condition::Building::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::Building::Dependencies() const
+{ return ValueRefDependencies(m_names); }
+
 std::string Condition::Building::Description(bool negated/* = false*/) const {
     std::string values_str;
     for (unsigned int i = 0; i < m_names.size(); ++i) {
@@ -1887,17 +1956,28 @@ std::string Condition::Building::Dump() const {
 
 void Condition::Building::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                             Condition::ObjectSet& condition_non_targets) const
-{ AddBuildingSet(condition_non_targets); }
+{
+    std::vector<std::string> names;
+    if (!m_names.empty() && ConstantValues(m_names, names) && Objects().ObjectIndexesValid()) {
+        // buildings of fixed types can be looked up directly
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+            AddObjectIndexSet(Objects().ExistingBuildingsOfType(*it), condition_non_targets);
+        return;
+    }
+    AddBuildingSet(condition_non_targets);
+}
 
 bool Condition::Building::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Building::Match passed no candidate object";
         return false;
     }
 
     // is it a building?
-    TemporaryPtr<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
+    ObjectHandle<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
     if (building) {
         // match any building type?
         if (m_names.empty())
@@ -1948,7 +2028,7 @@ namespace {
             m_high_turn(high_turn)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -1979,7 +2059,7 @@ void Condition::HasSpecial::Eval(const ScriptingContext& parent_context,
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate turn limits once, pass to simple match for all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         int low = (m_since_turn_low ? m_since_turn_low->Eval(local_context) : BEFORE_FIRST_TURN);
         int high = (m_since_turn_high ? m_since_turn_high->Eval(local_context) : IMPOSSIBLY_LARGE_TURN);
@@ -2002,6 +2082,14 @@ bool Condition::HasSpecial::SourceInvariant() const
 { return ((!m_since_turn_low || m_since_turn_low->SourceInvariant()) &&
           (!m_since_turn_high || m_since_turn_high->SourceInvariant())); }
 
+unsigned int Condition::HasSpecial::Dependencies() const {
+    unsigned int retval = DEPENDS_ON_SPECIALS;
+    // the turn on which a special was added is compared to the current turn
+    if (m_since_turn_low || m_since_turn_high)
+        retval |= DEPENDS_ON_OTHER | ValueRefDependencies(m_since_turn_low) | ValueRefDependencies(m_since_turn_high);
+    return retval;
+}
+
 std::string Condition::HasSpecial::Description(bool negated/* = false*/) const {
     if (!m_since_turn_low && !m_since_turn_high) {
         return str(FlexibleFormat((!negated)
@@ -2042,7 +2130,7 @@ std::string Condition::HasSpecial::Dump() const {
 }
 
 bool Condition::HasSpecial::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "HasSpecial::Match passed no candidate object";
         return false;
@@ -2080,7 +2168,7 @@ std::string Condition::HasTag::Dump() const
 { return DumpIndent() + "HasTag name = \"" + m_name + "\"\n"; }
 
 bool Condition::HasTag::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "HasTag::Match passed no candidate object";
         return false;
@@ -2118,7 +2206,7 @@ namespace {
             m_high(high)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             int turn = candidate->CreationTurn();
@@ -2138,7 +2226,7 @@ void Condition::CreatedOnTurn::Eval(const ScriptingContext& parent_context,
                              (!m_high || m_high->LocalCandidateInvariant()) &&
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         int low = (m_low ? m_low->Eval(local_context) : BEFORE_FIRST_TURN);
         int high = (m_high ? m_high->Eval(local_context) : IMPOSSIBLY_LARGE_TURN);
@@ -2185,7 +2273,7 @@ std::string Condition::CreatedOnTurn::Dump() const {
 }
 
 bool Condition::CreatedOnTurn::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "CreatedOnTurn::Match passed no candidate object";
         return false;
@@ -2230,7 +2318,7 @@ namespace {
             m_subcondition_matches_ids.reserve(subcondition_matches.size());
             // gather the ids
             for (Condition::ObjectSet::const_iterator it = subcondition_matches.begin(); it != subcondition_matches.end(); ++it) {
-                TemporaryPtr<const UniverseObject> obj = *it;
+                ObjectHandle<const UniverseObject> obj = *it;
                 if (obj)
                 { m_subcondition_matches_ids.push_back(obj->ID()); }
             }
@@ -2238,7 +2326,7 @@ namespace {
             std::sort(m_subcondition_matches_ids.begin(), m_subcondition_matches_ids.end());
         }
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -2283,7 +2371,7 @@ void Condition::Contains::Eval(const ScriptingContext& parent_context,
     bool simple_eval_safe = parent_context.condition_root_candidate || RootCandidateInvariant();
     if (simple_eval_safe) {
         // evaluate contained objects once and check for all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         // get objects to be considering for matching against subcondition
@@ -2331,7 +2419,7 @@ void Condition::Contains::GetDefaultInitialCandidateObjects(const ScriptingConte
 }
 
 bool Condition::Contains::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Contains::Match passed no candidate object";
         return false;
@@ -2384,7 +2472,7 @@ namespace {
             m_subcondition_matches_ids.reserve(subcondition_matches.size());
             // gather the ids
             for (Condition::ObjectSet::const_iterator it = subcondition_matches.begin(); it != subcondition_matches.end(); ++it) {
-                TemporaryPtr<const UniverseObject> obj = *it;
+                ObjectHandle<const UniverseObject> obj = *it;
                 if (obj)
                 { m_subcondition_matches_ids.push_back(obj->ID()); }
             }
@@ -2392,7 +2480,7 @@ namespace {
             std::sort(m_subcondition_matches_ids.begin(), m_subcondition_matches_ids.end());
         }
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -2445,7 +2533,7 @@ void Condition::ContainedBy::Eval(const ScriptingContext& parent_context,
     if (simple_eval_safe) {
         // evaluate contained objects once and check for all candidates
 
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         // get subcondition matches
@@ -2484,7 +2572,7 @@ std::string Condition::ContainedBy::Dump() const {
 }
 
 bool Condition::ContainedBy::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "ContainedBy::Match passed no candidate object";
         return false;
@@ -2497,7 +2585,8 @@ bool Condition::ContainedBy::Match(const ScriptingContext& local_context) const
     if (candidate->ContainerObjectID() != INVALID_OBJECT_ID && candidate->ContainerObjectID() != candidate->SystemID())
         containers.insert(candidate->ContainerObjectID());
 
-    ObjectSet container_objects = Objects().FindObjects<const UniverseObject>(containers);
+    std::vector<TemporaryPtr<const UniverseObject> > containers_found = Objects().FindObjects<const UniverseObject>(containers);
+    ObjectSet container_objects(containers_found.begin(), containers_found.end());
     if (container_objects.empty())
         return false;
 
@@ -2531,7 +2620,7 @@ namespace {
             m_system_id(system_id)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             if (m_system_id == INVALID_OBJECT_ID)
@@ -2553,7 +2642,7 @@ void Condition::InSystem::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int system_id = (m_system_id ? m_system_id->Eval(ScriptingContext(parent_context, no_object)) : INVALID_OBJECT_ID);
         EvalImpl(matches, non_matches, search_domain, InSystemSimpleMatch(system_id));
     } else {
@@ -2603,7 +2692,7 @@ std::string Condition::InSystem::Dump() const {
 }
 
 bool Condition::InSystem::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "InSystem::Match passed no candidate object";
         return false;
@@ -2637,7 +2726,7 @@ namespace {
             m_object_id(object_id)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             return candidate &&
                 m_object_id != INVALID_OBJECT_ID &&
                 candidate->ID() == m_object_id;
@@ -2656,7 +2745,7 @@ void Condition::ObjectID::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int object_id = (m_object_id ? m_object_id->Eval(ScriptingContext(parent_context, no_object)) : INVALID_OBJECT_ID);
         EvalImpl(matches, non_matches, search_domain, ObjectIDSimpleMatch(object_id));
     } else {
@@ -2711,7 +2800,7 @@ void Condition::ObjectID::GetDefaultInitialCandidateObjects(const ScriptingConte
     }
 
     // simple case of a single specified id; can add just that object
-    TemporaryPtr<const UniverseObject> no_object;
+    ObjectHandle<const UniverseObject> no_object;
     int object_id = m_object_id->Eval(ScriptingContext(parent_context, no_object));
     if (object_id == INVALID_OBJECT_ID)
         return;
@@ -2722,7 +2811,7 @@ void Condition::ObjectID::GetDefaultInitialCandidateObjects(const ScriptingConte
 }
 
 bool Condition::ObjectID::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "ObjectID::Match passed no candidate object";
         return false;
@@ -2763,13 +2852,13 @@ namespace {
             m_types(types)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a planet or on a planet?
-            TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-            TemporaryPtr<const ::Building> building;
+            ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+            ObjectHandle<const ::Building> building;
             if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
                 planet = GetPlanet(building->PlanetID());
             }
@@ -2847,6 +2936,9 @@ bool Condition::PlanetType::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::PlanetType::Dependencies() const
+{ return DEPENDS_ON_OTHER | ValueRefDependencies(m_types); }
+
 std::string Condition::PlanetType::Description(bool negated/* = false*/) const {
     std::string values_str;
     for (unsigned int i = 0; i < m_types.size(); ++i) {
@@ -2889,14 +2981,14 @@ void Condition::PlanetType::GetDefaultInitialCandidateObjects(const ScriptingCon
 }
 
 bool Condition::PlanetType::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "PlanetType::Match passed no candidate object";
         return false;
     }
 
-    TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-    TemporaryPtr<const ::Building> building;
+    ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+    ObjectHandle<const ::Building> building;
     if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
         planet = GetPlanet(building->PlanetID());
     }
@@ -2943,13 +3035,13 @@ namespace {
             m_sizes(sizes)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a planet or on a planet? TODO: This concept should be generalized and factored out.
-            TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-            TemporaryPtr<const ::Building> building;
+            ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+            ObjectHandle<const ::Building> building;
             if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
                 planet = GetPlanet(building->PlanetID());
             }
@@ -3032,6 +3124,9 @@ bool Condition::PlanetSize::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::PlanetSize::Dependencies() const
+{ return DEPENDS_ON_OTHER | ValueRefDependencies(m_sizes); }
+
 std::string Condition::PlanetSize::Description(bool negated/* = false*/) const {
     std::string values_str;
     for (unsigned int i = 0; i < m_sizes.size(); ++i) {
@@ -3074,14 +3169,14 @@ void Condition::PlanetSize::GetDefaultInitialCandidateObjects(const ScriptingCon
 }
 
 bool Condition::PlanetSize::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "PlanetSize::Match passed no candidate object";
         return false;
     }
 
-    TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-    TemporaryPtr<const ::Building> building;
+    ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+    ObjectHandle<const ::Building> building;
     if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
         planet = GetPlanet(building->PlanetID());
     }
@@ -3126,13 +3221,13 @@ namespace {
             m_environments(environments)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a planet or on a planet? TODO: factor out
-            TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-            TemporaryPtr<const ::Building> building;
+            ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+            ObjectHandle<const ::Building> building;
             if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
                 planet = GetPlanet(building->PlanetID());
             }
@@ -3257,15 +3352,15 @@ void Condition::PlanetEnvironment::GetDefaultInitialCandidateObjects(const Scrip
 }
 
 bool Condition::PlanetEnvironment::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "PlanetEnvironment::Match passed no candidate object";
         return false;
     }
     
     // is it a planet or on a planet? TODO: factor out
-    TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-    TemporaryPtr<const ::Building> building;
+    ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+    ObjectHandle<const ::Building> building;
     if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
         planet = GetPlanet(building->PlanetID());
     }
@@ -3311,24 +3406,24 @@ namespace {
             m_names(names)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a population centre?
-            if (TemporaryPtr<const ::PopCenter> pop = boost::dynamic_pointer_cast<const ::PopCenter>(candidate)) {
+            if (ObjectHandle<const ::PopCenter> pop = boost::dynamic_pointer_cast<const ::PopCenter>(candidate)) {
                 const std::string& species_name = pop->SpeciesName();
                 // if the popcenter has a species and that species is one of those specified...
                 return !species_name.empty() && (m_names.empty() || (std::find(m_names.begin(), m_names.end(), species_name) != m_names.end()));
             }
             // is it a ship?
-            if (TemporaryPtr<const ::Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate)) {
+            if (ObjectHandle<const ::Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate)) {
                 // if the ship has a species and that species is one of those specified...
                 const std::string& species_name = ship->SpeciesName();
                 return !species_name.empty() && (m_names.empty() || (std::find(m_names.begin(), m_names.end(), species_name) != m_names.end()));
             }
             // is it a building on a planet?
-            if (TemporaryPtr<const ::Building> building = boost::dynamic_pointer_cast<const Building>(candidate)) {
+            if (ObjectHandle<const ::Building> building = boost::dynamic_pointer_cast<const Building>(candidate)) {
                 TemporaryPtr<const ::Planet> planet = GetPlanet(building->PlanetID());
                 const std::string& species_name = planet->SpeciesName();
                 // if the planet (which IS a popcenter) has a species and that species is one of those specified...
@@ -3402,6 +3497,27 @@ bool Condition::Species::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::Species::Dependencies() const
+{ return DEPENDS_ON_SPECIES | ValueRefDependencies(m_names); }
+
+void Condition::Species::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                           Condition::ObjectSet& condition_non_targets) const
+{
+    std::vector<std::string> names;
+    if (!m_names.empty() && ConstantValues(m_names, names) && Objects().ObjectIndexesValid()) {
+        // planets and ships of fixed species can be looked up directly.
+        // buildings match by the species of their planet, so all of them
+        // remain candidates.
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+            AddObjectIndexSet(Objects().ExistingObjectsOfSpecies(*it), condition_non_targets);
+        AddBuildingSet(condition_non_targets);
+        return;
+    }
+    ConditionBase::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+}
+
 std::string Condition::Species::Description(bool negated/* = false*/) const {
     std::string values_str;
     for (unsigned int i = 0; i < m_names.size(); ++i) {
@@ -3439,15 +3555,15 @@ std::string Condition::Species::Dump() const {
 }
 
 bool Condition::Species::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Species::Match passed no candidate object";
         return false;
     }
 
     // is it a planet or a building on a planet? TODO: factor out
-    TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
-    TemporaryPtr<const ::Building> building;
+    ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+    ObjectHandle<const ::Building> building;
     if (!planet && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
         planet = GetPlanet(building->PlanetID());
     }
@@ -3462,7 +3578,7 @@ bool Condition::Species::Match(const ScriptingContext& local_context) const {
         }
     }
     // is it a ship?
-    TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
+    ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
     if (ship) {
         if (m_names.empty()) {
             return !ship->SpeciesName().empty();    // match any species name
@@ -3550,7 +3666,7 @@ namespace {
             m_low(low),
             m_high(high)
         {}
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -3725,7 +3841,7 @@ std::string Condition::Enqueued::Dump() const {
 }
 
 bool Condition::Enqueued::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Enqueued::Match passed no candidate object";
         return false;
@@ -3769,13 +3885,13 @@ namespace {
             m_names(names)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a ResourceCenter or a Building on a Planet (that is a ResourceCenter)
-            TemporaryPtr<const ResourceCenter> res_center = boost::dynamic_pointer_cast<const ResourceCenter>(candidate);
-            TemporaryPtr<const ::Building> building;
+            ObjectHandle<const ResourceCenter> res_center = boost::dynamic_pointer_cast<const ResourceCenter>(candidate);
+            ObjectHandle<const ::Building> building;
             if (!res_center && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
                 if (TemporaryPtr<const Planet> planet = GetPlanet(building->PlanetID()))
                     res_center = boost::dynamic_pointer_cast<const ResourceCenter>(planet);
@@ -3854,6 +3970,9 @@ bool Condition::FocusType::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::FocusType::Dependencies() const
+{ return DEPENDS_ON_FOCUS | ValueRefDependencies(m_names); }
+
 std::string Condition::FocusType::Description(bool negated/* = false*/) const {
     std::string values_str;
     for (unsigned int i = 0; i < m_names.size(); ++i) {
@@ -3889,15 +4008,15 @@ std::string Condition::FocusType::Dump() const {
 }
 
 bool Condition::FocusType::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "FocusType::Match passed no candidate object";
         return false;
     }
 
     // is it a ResourceCenter or a Building on a Planet (that is a ResourceCenter)
-    TemporaryPtr<const ResourceCenter> res_center = boost::dynamic_pointer_cast<const ResourceCenter>(candidate);
-    TemporaryPtr<const ::Building> building;
+    ObjectHandle<const ResourceCenter> res_center = boost::dynamic_pointer_cast<const ResourceCenter>(candidate);
+    ObjectHandle<const ::Building> building;
     if (!res_center && (building = boost::dynamic_pointer_cast<const ::Building>(candidate))) {
         if (TemporaryPtr<const Planet> planet = GetPlanet(building->PlanetID()))
             res_center = boost::dynamic_pointer_cast<const ResourceCenter>(planet);
@@ -3943,11 +4062,11 @@ namespace {
             m_types(types)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
-            TemporaryPtr<const System> system = GetSystem(candidate->SystemID());
+            ObjectHandle<const System> system = GetSystem(candidate->SystemID());
             if (system || (system = boost::dynamic_pointer_cast<const System>(candidate)))
                 return !m_types.empty() && (std::find(m_types.begin(), m_types.end(), system->GetStarType()) != m_types.end());
 
@@ -4018,6 +4137,9 @@ bool Condition::StarType::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::StarType::Dependencies() const
+{ return DEPENDS_ON_LOCATION | DEPENDS_ON_OTHER | ValueRefDependencies(m_types); }
+
 std::string Condition::StarType::Description(bool negated/* = false*/) const {
     std::string values_str;
     for (unsigned int i = 0; i < m_types.size(); ++i) {
@@ -4053,13 +4175,13 @@ std::string Condition::StarType::Dump() const {
 }
 
 bool Condition::StarType::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "StarType::Match passed no candidate object";
         return false;
     }
 
-    TemporaryPtr<const System> system = GetSystem(candidate->SystemID());
+    ObjectHandle<const System> system = GetSystem(candidate->SystemID());
     if (system || (system = boost::dynamic_pointer_cast<const System>(candidate))) {
         for (unsigned int i = 0; i < m_types.size(); ++i) {
             if (m_types[i]->Eval(local_context) == system->GetStarType())
@@ -4097,13 +4219,13 @@ std::string Condition::DesignHasHull::Dump() const
 { return DumpIndent() + "DesignHasHull name = \"" + m_name + "\"\n"; }
 
 bool Condition::DesignHasHull::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "DesignHasHull::Match passed no candidate object";
         return false;
     }
 
-    if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
+    if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
         if (const ShipDesign* design = ship->Design())
             return (design->Hull() == m_name);
     return false;
@@ -4142,12 +4264,12 @@ namespace {
             m_name(name)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a ship?
-            TemporaryPtr<const ::Ship> ship = boost::dynamic_pointer_cast<const ::Ship>(candidate);
+            ObjectHandle<const ::Ship> ship = boost::dynamic_pointer_cast<const ::Ship>(candidate);
             if (!ship)
                 return false;
             // with a valid design?
@@ -4177,7 +4299,7 @@ void Condition::DesignHasPart::Eval(const ScriptingContext& parent_context,
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate number limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         int low =  std::max(0, m_low->Eval(local_context));
         int high = std::min(m_high->Eval(local_context), INT_MAX);
@@ -4222,7 +4344,7 @@ std::string Condition::DesignHasPart::Dump() const
 { return DumpIndent() + "DesignHasPart low = " + m_low->Dump() + " high = " + m_high->Dump() + " name = " + m_name; }
 
 bool Condition::DesignHasPart::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "DesignHasPart::Match passed no candidate object";
         return false;
@@ -4267,12 +4389,12 @@ namespace {
             m_part_class(part_class)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
             // is it a ship?
-            TemporaryPtr<const ::Ship> ship = boost::dynamic_pointer_cast<const ::Ship>(candidate);
+            ObjectHandle<const ::Ship> ship = boost::dynamic_pointer_cast<const ::Ship>(candidate);
             if (!ship)
                 return false;
             // with a valid design?
@@ -4306,7 +4428,7 @@ void Condition::DesignHasPartClass::Eval(const ScriptingContext& parent_context,
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate number limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         int low =  std::max(0, m_low->Eval(local_context));
         int high = std::min(m_high->Eval(local_context), IMPOSSIBLY_LARGE_TURN);
@@ -4351,7 +4473,7 @@ std::string Condition::DesignHasPartClass::Dump() const
 { return DumpIndent() + "DesignHasPartClass low = " + m_low->Dump() + " high = " + m_high->Dump() + " class = " + UserString(boost::lexical_cast<std::string>(m_class)); }
 
 bool Condition::DesignHasPartClass::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "DesignHasPartClass::Match passed no candidate object";
         return false;
@@ -4391,13 +4513,13 @@ std::string Condition::PredefinedShipDesign::Dump() const
 { return DumpIndent() + "PredefinedShipDesign name = \"" + m_name + "\"\n"; }
 
 bool Condition::PredefinedShipDesign::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "PredefinedShipDesign::Match passed no candidate object";
         return false;
     }
 
-    TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
+    ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
     if (!ship)
         return false;
     const ShipDesign* candidate_design = ship->Design();
@@ -4439,12 +4561,12 @@ namespace {
             m_design_id(design_id)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             if (m_design_id == ShipDesign::INVALID_DESIGN_ID)
                 return false;
-            if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
+            if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
                 if (ship->DesignID() == m_design_id)
                     return true;
             return false;
@@ -4463,7 +4585,7 @@ void Condition::NumberedShipDesign::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int design_id = m_design_id->Eval(ScriptingContext(parent_context, no_object));
         EvalImpl(matches, non_matches, search_domain, NumberedShipDesignSimpleMatch(design_id));
     } else {
@@ -4496,7 +4618,7 @@ std::string Condition::NumberedShipDesign::Dump() const
 { return DumpIndent() + "NumberedShipDesign design_id = " + m_design_id->Dump(); }
 
 bool Condition::NumberedShipDesign::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "NumberedShipDesign::Match passed no candidate object";
         return false;
@@ -4529,13 +4651,13 @@ namespace {
             m_empire_id(empire_id)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
-            if (TemporaryPtr<const ::Ship> ship = boost::dynamic_pointer_cast<const ::Ship>(candidate))
+            if (ObjectHandle<const ::Ship> ship = boost::dynamic_pointer_cast<const ::Ship>(candidate))
                 return ship->ProducedByEmpireID() == m_empire_id;
-            else if (TemporaryPtr<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate))
+            else if (ObjectHandle<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate))
                 return building->ProducedByEmpireID() == m_empire_id;
             return false;
         }
@@ -4553,7 +4675,7 @@ void Condition::ProducedByEmpire::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int empire_id = m_empire_id->Eval(ScriptingContext(parent_context, no_object));
         EvalImpl(matches, non_matches, search_domain, ProducedByEmpireSimpleMatch(empire_id));
     } else {
@@ -4593,7 +4715,7 @@ std::string Condition::ProducedByEmpire::Dump() const
 { return DumpIndent() + "ProducedByEmpire empire_id = " + m_empire_id->Dump(); }
 
 bool Condition::ProducedByEmpire::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "ProducedByEmpire::Match passed no candidate object";
         return false;
@@ -4627,7 +4749,7 @@ namespace {
             m_chance(chance)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const
         { return RandZeroToOne() <= m_chance; }
 
         float m_chance;
@@ -4643,7 +4765,7 @@ void Condition::Chance::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         float chance = std::max(0.0, std::min(1.0, m_chance->Eval(ScriptingContext(parent_context, no_object))));
         EvalImpl(matches, non_matches, search_domain, ChanceSimpleMatch(chance));
     } else {
@@ -4717,7 +4839,7 @@ namespace {
             m_meter_type(meter_type)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -4783,7 +4905,7 @@ void Condition::MeterValue::Eval(const ScriptingContext& parent_context,
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate number limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         float low = (m_low ? m_low->Eval(local_context) : -Meter::LARGE_VALUE);
         float high = (m_high ? m_high->Eval(local_context) : Meter::LARGE_VALUE);
@@ -4803,6 +4925,9 @@ bool Condition::MeterValue::TargetInvariant() const
 bool Condition::MeterValue::SourceInvariant() const
 { return (!m_low || m_low->SourceInvariant()) && (!m_high || m_high->SourceInvariant()); }
 
+unsigned int Condition::MeterValue::Dependencies() const
+{ return DEPENDS_ON_METERS | ValueRefDependencies(m_low) | ValueRefDependencies(m_high); }
+
 std::string Condition::MeterValue::Description(bool negated/* = false*/) const {
     std::string low_str = (m_low ? (ValueRef::ConstantExpr(m_low) ?
                                     boost::lexical_cast<std::string>(m_low->Eval()) :
@@ -4832,7 +4957,7 @@ std::string Condition::MeterValue::Dump() const {
 }
 
 bool Condition::MeterValue::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "MeterValue::Match passed no candidate object";
         return false;
@@ -4874,26 +4999,26 @@ namespace {
     struct ShipPartMeterValueSimpleMatch {
         ShipPartMeterValueSimpleMatch(const std::string& ship_part_name,
                                       MeterType meter, float low, float high) :
-            m_part_name(ship_part_name),
+            m_part_name_id(FindPartNameID(ship_part_name)),
             m_low(low),
             m_high(high),
             m_meter(meter)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
-            TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
+            ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
             if (!ship)
                 return false;
-            const Meter* meter = ship->GetPartMeter(m_meter, m_part_name);
+            const Meter* meter = ship->PartMeters().Get(m_meter, m_part_name_id);
             if (!meter)
                 return false;
             float meter_current = meter->Current();
             return (m_low <= meter_current && meter_current <= m_high);
         }
 
-        std::string m_part_name;
+        int         m_part_name_id;
         float      m_low;
         float      m_high;
         MeterType   m_meter;
@@ -4909,7 +5034,7 @@ void Condition::ShipPartMeterValue::Eval(const ScriptingContext& parent_context,
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate number limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         float low = (m_low ? m_low->Eval(local_context) : -Meter::LARGE_VALUE);
         float high = (m_high ? m_high->Eval(local_context) : Meter::LARGE_VALUE);
@@ -4966,7 +5091,7 @@ std::string Condition::ShipPartMeterValue::Dump() const {
 }
 
 bool Condition::ShipPartMeterValue::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "ShipPartMeterValue::Match passed no candidate object";
         return false;
@@ -5014,7 +5139,7 @@ namespace {
             m_meter(meter)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             const Empire* empire = Empires().Lookup(m_empire_id);
@@ -5044,7 +5169,7 @@ void Condition::EmpireMeterValue::Eval(const ScriptingContext& parent_context,
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate number limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         int empire_id = m_empire_id->Eval(local_context);   // if m_empire_id not set, default to local candidate's owner, which is not target invariant
         float low = (m_low ? m_low->Eval(local_context) : -Meter::LARGE_VALUE);
@@ -5116,7 +5241,7 @@ std::string Condition::EmpireMeterValue::Dump() const {
 }
 
 bool Condition::EmpireMeterValue::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "EmpireMeterValue::Match passed no candidate object";
         return false;
@@ -5162,7 +5287,7 @@ namespace {
             m_stockpile(stockpile)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -5195,7 +5320,7 @@ void Condition::EmpireStockpileValue::Eval(const ScriptingContext& parent_contex
                              (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate number limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
         float low = m_low->Eval(local_context);
         float high = m_high->Eval(local_context);
@@ -5243,7 +5368,7 @@ std::string Condition::EmpireStockpileValue::Dump() const {
 }
 
 bool Condition::EmpireStockpileValue::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "EmpireStockpileValue::Match passed no candidate object";
         return false;
@@ -5282,7 +5407,7 @@ std::string Condition::OwnerHasTech::Dump() const
 { return DumpIndent() + "OwnerHasTech name = \"" + m_name + "\"\n"; }
 
 bool Condition::OwnerHasTech::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "OwnerHasTech::Match passed no candidate object";
         return false;
@@ -5326,7 +5451,7 @@ std::string Condition::OwnerHasBuildingTypeAvailable::Dump() const
 { return DumpIndent() + "OwnerHasBuildingTypeAvailable name = \"" + m_name + "\"\n"; }
 
 bool Condition::OwnerHasBuildingTypeAvailable::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "OwnerHasBuildingTypeAvailable::Match passed no candidate object";
         return false;
@@ -5370,7 +5495,7 @@ std::string Condition::OwnerHasShipDesignAvailable::Dump() const
 { return DumpIndent() + "OwnerHasShipDesignAvailable id = \"" + boost::lexical_cast<std::string>(m_id) + "\"\n"; }
 
 bool Condition::OwnerHasShipDesignAvailable::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "OwnerHasShipDesignAvailable::Match passed no candidate object";
         return false;
@@ -5410,7 +5535,7 @@ namespace {
             m_empire_id(empire_id)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             return candidate->GetVisibility(m_empire_id) != VIS_NO_VISIBILITY;
@@ -5429,7 +5554,7 @@ void Condition::VisibleToEmpire::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int empire_id = m_empire_id->Eval(ScriptingContext(parent_context, no_object));
         EvalImpl(matches, non_matches, search_domain, VisibleToEmpireSimpleMatch(empire_id));
     } else {
@@ -5469,7 +5594,7 @@ std::string Condition::VisibleToEmpire::Dump() const
 { return DumpIndent() + "VisibleToEmpire empire_id = " + m_empire_id->Dump(); }
 
 bool Condition::VisibleToEmpire::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "VisibleToEmpire::Match passed no candidate object";
         return false;
@@ -5501,16 +5626,60 @@ bool Condition::WithinDistance::operator==(const Condition::ConditionBase& rhs)
 }
 
 namespace {
+    /** Number of objects from which on WithinDistance and WithinStarlaneJumps
+      * index the objects they measure from, instead of checking each
+      * candidate against each of these objects. */
+    const std::size_t MIN_INDEXED_FROM_OBJECTS = 16;
+
     struct WithinDistanceSimpleMatch {
-        WithinDistanceSimpleMatch(const Condition::ObjectSet& from_objects, double distance) :
+        WithinDistanceSimpleMatch(const Condition::ObjectSet& from_objects, double distance,
+                                  bool index_from_objects = false) :
             m_from_objects(from_objects),
-            m_distance2(distance*distance)
-        {}
+            m_distance2(distance*distance),
+            m_cell_size(std::max(distance, 1.0)),
+            m_grid()
+        {
+            if (!index_from_objects || distance < 0.0 || from_objects.size() < MIN_INDEXED_FROM_OBJECTS)
+                return;
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+            // sort positions into a uniform grid with cells at least as large
+            // as the distance, so that only the cell of a candidate and the
+            // cells next to it need to be checked
+            for (Condition::ObjectSet::const_iterator it = m_from_objects.begin();
+                 it != m_from_objects.end(); ++it)
+            {
+                std::vector<std::pair<double, double> >& cell = m_grid[Cell((*it)->X(), (*it)->Y())];
+                std::pair<double, double> position((*it)->X(), (*it)->Y());
+                if (std::find(cell.begin(), cell.end(), position) == cell.end())
+                    cell.push_back(position);
+            }
+        }
+
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
+            if (!m_grid.empty()) {
+                std::pair<int, int> candidate_cell = Cell(candidate->X(), candidate->Y());
+                for (int dx = -1; dx <= 1; ++dx) {
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        Grid::const_iterator cell_it =
+                            m_grid.find(std::make_pair(candidate_cell.first + dx, candidate_cell.second + dy));
+                        if (cell_it == m_grid.end())
+                            continue;
+                        for (std::vector<std::pair<double, double> >::const_iterator it = cell_it->second.begin();
+                             it != cell_it->second.end(); ++it)
+                        {
+                            double delta_x = candidate->X() - it->first;
+                            double delta_y = candidate->Y() - it->second;
+                            if (delta_x*delta_x + delta_y*delta_y <= m_distance2)
+                                return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
             // is candidate object close enough to any of the passed-in objects?
             for (Condition::ObjectSet::const_iterator it = m_from_objects.begin();
                  it != m_from_objects.end(); ++it)
@@ -5524,8 +5693,15 @@ namespace {
             return false;
         }
 
+        typedef std::map<std::pair<int, int>, std::vector<std::pair<double, double> > > Grid;
+
+        std::pair<int, int> Cell(double x, double y) const
+        { return std::make_pair(static_cast<int>(std::floor(x / m_cell_size)), static_cast<int>(std::floor(y / m_cell_size))); }
+
         const Condition::ObjectSet& m_from_objects;
         double m_distance2;
+        double m_cell_size;
+        Grid m_grid;    ///< distinct positions of m_from_objects by grid cell, if indexed
     };
 }
 
@@ -5538,7 +5714,7 @@ void Condition::WithinDistance::Eval(const ScriptingContext& parent_context,
     if (simple_eval_safe) {
         // evaluate contained objects once and check for all candidates
 
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         // get subcondition matches
@@ -5547,7 +5723,7 @@ void Condition::WithinDistance::Eval(const ScriptingContext& parent_context,
 
         double distance = m_distance->Eval(local_context);
 
-        EvalImpl(matches, non_matches, search_domain, WithinDistanceSimpleMatch(subcondition_matches, distance));
+        EvalImpl(matches, non_matches, search_domain, WithinDistanceSimpleMatch(subcondition_matches, distance, true));
     } else {
         // re-evaluate contained objects for each candidate object
         Condition::ConditionBase::Eval(parent_context, matches, non_matches, search_domain);
@@ -5563,6 +5739,9 @@ bool Condition::WithinDistance::TargetInvariant() const
 bool Condition::WithinDistance::SourceInvariant() const
 { return m_distance->SourceInvariant() && m_condition->SourceInvariant(); }
 
+unsigned int Condition::WithinDistance::Dependencies() const
+{ return DEPENDS_ON_LOCATION | ValueRefDependencies(m_distance) | m_condition->Dependencies(); }
+
 std::string Condition::WithinDistance::Description(bool negated/* = false*/) const {
     std::string value_str = ValueRef::ConstantExpr(m_distance) ?
                                 boost::lexical_cast<std::string>(m_distance->Eval()) :
@@ -5583,7 +5762,7 @@ std::string Condition::WithinDistance::Dump() const {
 }
 
 bool Condition::WithinDistance::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "WithinDistance::Match passed no candidate object";
         return false;
@@ -5623,7 +5802,7 @@ bool Condition::WithinStarlaneJumps::operator==(const Condition::ConditionBase&
 namespace {
     const int MANY_JUMPS(999999);
 
-    int JumpsBetweenObjects(TemporaryPtr<const UniverseObject> one, TemporaryPtr<const UniverseObject> two) {
+    int JumpsBetweenObjects(ObjectHandle<const UniverseObject> one, ObjectHandle<const UniverseObject> two) {
         if (!one || !two)
             return MANY_JUMPS;
 
@@ -5646,7 +5825,7 @@ namespace {
 
         } else if (system_one) {
             // just object one is / in a system.
-            if (TemporaryPtr<const Fleet> fleet = FleetFromObject(two)) {
+            if (ObjectHandle<const Fleet> fleet = FleetFromObject(two)) {
                 // other object is a fleet that is between systems
                 // need to check shortest path from systems on either side of starlane fleet is on
                 short jumps1 = -1, jumps2 = -1;
@@ -5669,7 +5848,7 @@ namespace {
 
         } else if (system_two) {
             // just object two is a system.
-            if (TemporaryPtr<const Fleet> fleet = FleetFromObject(one)) {
+            if (ObjectHandle<const Fleet> fleet = FleetFromObject(one)) {
                 // other object is a fleet that is between systems
                 // need to check shortest path from systems on either side of starlane fleet is on
                 short jumps1 = -1, jumps2 = -1;
@@ -5692,8 +5871,8 @@ namespace {
         } else {
             // neither object is / in a system
 
-            TemporaryPtr<const Fleet> fleet_one = FleetFromObject(one);
-            TemporaryPtr<const Fleet> fleet_two = FleetFromObject(two);
+            ObjectHandle<const Fleet> fleet_one = FleetFromObject(one);
+            ObjectHandle<const Fleet> fleet_two = FleetFromObject(two);
 
             if (fleet_one && fleet_two) {
                 // both objects are / in a fleet.
@@ -5729,12 +5908,55 @@ namespace {
     }
 
     struct WithinStarlaneJumpsSimpleMatch {
-        WithinStarlaneJumpsSimpleMatch(const Condition::ObjectSet& from_objects, int jump_limit) :
+        WithinStarlaneJumpsSimpleMatch(const Condition::ObjectSet& from_objects, int jump_limit,
+                                       bool index_from_objects = false) :
             m_from_objects(from_objects),
-            m_jump_limit(jump_limit)
-        {}
+            m_jump_limit(jump_limit),
+            m_indexed(false),
+            m_near_system_ids(),
+            m_unlocated_from_objects()
+        {
+            if (!index_from_objects || m_jump_limit <= 0 || from_objects.size() < MIN_INDEXED_FROM_OBJECTS)
+                return;
+
+            // collect the systems the objects are in.  objects between
+            // systems are still checked one by one.
+            std::map<int, int> system_jumps;    // jumps from the nearest of the objects' systems, indexed by system id
+            std::deque<int> systems_to_visit;
+            for (Condition::ObjectSet::const_iterator it = m_from_objects.begin(); it != m_from_objects.end(); ++it) {
+                if (TemporaryPtr<const System> system = GetSystem((*it)->SystemID())) {
+                    if (system_jumps.insert(std::make_pair(system->ID(), 0)).second)
+                        systems_to_visit.push_back(system->ID());
+                } else {
+                    m_unlocated_from_objects.push_back(*it);
+                }
+            }
+
+            // find all systems within the jump limit of those systems with a
+            // breadth-first search from all of them at once, which stops at
+            // the jump limit, so only visits the systems that can match
+            while (!systems_to_visit.empty()) {
+                int system_id = systems_to_visit.front();
+                systems_to_visit.pop_front();
+                int jumps = system_jumps[system_id];
+                m_near_system_ids.insert(system_id);
+                if (jumps >= m_jump_limit)
+                    continue;
+                std::multimap<double, int> neighbours;
+                try {
+                    neighbours = GetUniverse().ImmediateNeighbors(system_id);
+                } catch (...) {
+                    continue;   // system is not in the system graph
+                }
+                for (std::multimap<double, int>::const_iterator it = neighbours.begin(); it != neighbours.end(); ++it) {
+                    if (system_jumps.insert(std::make_pair(it->second, jumps + 1)).second)
+                        systems_to_visit.push_back(it->second);
+                }
+            }
+            m_indexed = true;
+        }
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             if (m_from_objects.empty())
@@ -5742,6 +5964,20 @@ namespace {
             if (m_jump_limit < 0)
                 return false;
 
+            if (m_indexed) {
+                if (TemporaryPtr<const System> system = GetSystem(candidate->SystemID())) {
+                    if (m_near_system_ids.find(system->ID()) != m_near_system_ids.end())
+                        return true;
+                    for (Condition::ObjectSet::const_iterator it = m_unlocated_from_objects.begin(); it != m_unlocated_from_objects.end(); ++it) {
+                        int jumps = JumpsBetweenObjects(*it, candidate);
+                        if (jumps != -1 && jumps <= m_jump_limit)
+                            return true;
+                    }
+                    return false;
+                }
+                // candidates between systems are checked against all objects below
+            }
+
             // is candidate object close enough to any subcondition matches?
             for (Condition::ObjectSet::const_iterator it = m_from_objects.begin(); it != m_from_objects.end(); ++it) {
                 if (m_jump_limit == 0) {
@@ -5762,6 +5998,9 @@ namespace {
 
         const Condition::ObjectSet& m_from_objects;
         int m_jump_limit;
+        bool m_indexed;
+        std::set<int> m_near_system_ids;                ///< systems within m_jump_limit of any of m_from_objects in a system, if indexed
+        Condition::ObjectSet m_unlocated_from_objects;  ///< m_from_objects not in a system, if indexed
     };
 }
 
@@ -5773,7 +6012,7 @@ void Condition::WithinStarlaneJumps::Eval(const ScriptingContext& parent_context
                             parent_context.condition_root_candidate || RootCandidateInvariant();
     if (simple_eval_safe) {
         // evaluate contained objects once and check for all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         // get subcondition matches
@@ -5781,7 +6020,7 @@ void Condition::WithinStarlaneJumps::Eval(const ScriptingContext& parent_context
         m_condition->Eval(local_context, subcondition_matches);
         int jump_limit = m_jumps->Eval(local_context);
 
-        EvalImpl(matches, non_matches, search_domain, WithinStarlaneJumpsSimpleMatch(subcondition_matches, jump_limit));
+        EvalImpl(matches, non_matches, search_domain, WithinStarlaneJumpsSimpleMatch(subcondition_matches, jump_limit, true));
     } else {
         // re-evaluate contained objects for each candidate object
         Condition::ConditionBase::Eval(parent_context, matches, non_matches, search_domain);
@@ -5797,6 +6036,9 @@ bool Condition::WithinStarlaneJumps::TargetInvariant() const
 bool Condition::WithinStarlaneJumps::SourceInvariant() const
 { return m_jumps->SourceInvariant() && m_condition->SourceInvariant(); }
 
+unsigned int Condition::WithinStarlaneJumps::Dependencies() const
+{ return DEPENDS_ON_LOCATION | ValueRefDependencies(m_jumps) | m_condition->Dependencies(); }
+
 std::string Condition::WithinStarlaneJumps::Description(bool negated/* = false*/) const {
     std::string value_str = ValueRef::ConstantExpr(m_jumps) ? boost::lexical_cast<std::string>(m_jumps->Eval()) : m_jumps->Description();
     return str(FlexibleFormat((!negated)
@@ -5815,7 +6057,7 @@ std::string Condition::WithinStarlaneJumps::Dump() const {
 }
 
 bool Condition::WithinStarlaneJumps::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "WithinStarlaneJumps::Match passed no candidate object";
         return false;
@@ -5854,7 +6096,7 @@ namespace {
             m_destination_objects(destination_objects)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             // TODO: implement this test
@@ -5872,7 +6114,7 @@ void Condition::CanAddStarlaneConnection::Eval(const ScriptingContext& parent_co
     bool simple_eval_safe = parent_context.condition_root_candidate || RootCandidateInvariant();
     if (simple_eval_safe) {
         // evaluate contained objects once and check for all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         // get subcondition matches
@@ -5911,7 +6153,7 @@ std::string Condition::CanAddStarlaneConnection::Dump() const {
 }
 
 bool Condition::CanAddStarlaneConnection::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "CanAddStarlaneConnection::Match passed no candidate object";
         return false;
@@ -5949,7 +6191,7 @@ namespace {
             m_empire_id(empire_id)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -5972,7 +6214,7 @@ void Condition::ExploredByEmpire::Eval(const ScriptingContext& parent_context,
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int empire_id = m_empire_id->Eval(ScriptingContext(parent_context, no_object));
         EvalImpl(matches, non_matches, search_domain, ExploredByEmpireSimpleMatch(empire_id));
     } else {
@@ -6012,7 +6254,7 @@ std::string Condition::ExploredByEmpire::Dump() const
 { return DumpIndent() + "ExploredByEmpire empire_id = " + m_empire_id->Dump(); }
 
 bool Condition::ExploredByEmpire::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "ExploredByEmpire::Match passed no candidate object";
         return false;
@@ -6037,7 +6279,7 @@ std::string Condition::Stationary::Dump() const
 { return DumpIndent() + "Stationary\n"; }
 
 bool Condition::Stationary::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Stationary::Match passed no candidate object";
         return false;
@@ -6046,9 +6288,9 @@ bool Condition::Stationary::Match(const ScriptingContext& local_context) const {
     // the only objects that can move are fleets and the ships in them.  so,
     // attempt to cast the candidate object to a fleet or ship, and if it's a ship
     // get the fleet of that ship
-    TemporaryPtr<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(candidate);
+    ObjectHandle<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(candidate);
     if (!fleet)
-        if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
+        if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate))
             fleet = GetFleet(ship->FleetID());
 
     if (fleet) {
@@ -6090,7 +6332,7 @@ namespace {
             m_empire_id(empire_id)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
 
@@ -6116,7 +6358,7 @@ void Condition::FleetSupplyableByEmpire::Eval(const ScriptingContext& parent_con
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate empire id once, and use to check all candidate objects
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         int empire_id = m_empire_id->Eval(ScriptingContext(parent_context, no_object));
         EvalImpl(matches, non_matches, search_domain, FleetSupplyableSimpleMatch(empire_id));
     } else {
@@ -6156,7 +6398,7 @@ std::string Condition::FleetSupplyableByEmpire::Dump() const
 { return DumpIndent() + "ResupplyableBy empire_id = " + m_empire_id->Dump(); }
 
 bool Condition::FleetSupplyableByEmpire::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "FleetSupplyableByEmpire::Match passed no candidate object";
         return false;
@@ -6195,7 +6437,7 @@ namespace {
             m_from_objects(from_objects)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             if (m_from_objects.empty())
@@ -6207,7 +6449,7 @@ namespace {
 
             // is candidate object connected to a subcondition matching object by resource supply?
             for (Condition::ObjectSet::const_iterator it = m_from_objects.begin(); it != m_from_objects.end(); ++it) {
-                TemporaryPtr<const UniverseObject> from_object(*it);
+                ObjectHandle<const UniverseObject> from_object(*it);
 
                 for (std::set<std::set<int> >::const_iterator groups_it = groups.begin(); groups_it != groups.end(); ++groups_it) {
                     const std::set<int>& group = *groups_it;
@@ -6240,7 +6482,7 @@ void Condition::ResourceSupplyConnectedByEmpire::Eval(const ScriptingContext& pa
                             (parent_context.condition_root_candidate || RootCandidateInvariant()));
     if (simple_eval_safe) {
         // evaluate contained objects once and check for all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         // get objects to be considering for matching against subcondition
@@ -6266,7 +6508,7 @@ bool Condition::ResourceSupplyConnectedByEmpire::SourceInvariant() const
 { return m_empire_id->SourceInvariant() && m_condition->SourceInvariant(); }
 
 bool Condition::ResourceSupplyConnectedByEmpire::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "ResourceSupplyConnectedByEmpire::Match passed no candidate object";
         return false;
@@ -6324,7 +6566,7 @@ std::string Condition::CanColonize::Dump() const
 { return DumpIndent() + "CanColonize\n"; }
 
 bool Condition::CanColonize::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "CanColonize::Match passed no candidate object";
         return false;
@@ -6333,7 +6575,7 @@ bool Condition::CanColonize::Match(const ScriptingContext& local_context) const
     // is it a ship, a planet, or a building on a planet?
     std::string species_name;
     if (candidate->ObjectType() == OBJ_PLANET) {
-        TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+        ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
         if (!planet) {
             Logger().errorStream() << "CanColonize couldn't cast supposedly planet candidate";
             return false;
@@ -6341,7 +6583,7 @@ bool Condition::CanColonize::Match(const ScriptingContext& local_context) const
         species_name = planet->SpeciesName();
 
     } else if (candidate->ObjectType() == OBJ_BUILDING) {
-        TemporaryPtr<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
+        ObjectHandle<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
         if (!building) {
             Logger().errorStream() << "CanColonize couldn't cast supposedly building candidate";
             return false;
@@ -6354,7 +6596,7 @@ bool Condition::CanColonize::Match(const ScriptingContext& local_context) const
         species_name = planet->SpeciesName();
 
     } else if (candidate->ObjectType() == OBJ_SHIP) {
-        TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
+        ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
         if (!ship) {
             Logger().errorStream() << "CanColonize couldn't cast supposedly ship candidate";
             return false;
@@ -6388,7 +6630,7 @@ std::string Condition::CanProduceShips::Dump() const
 { return DumpIndent() + "CanColonize\n"; }
 
 bool Condition::CanProduceShips::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "CanProduceShips::Match passed no candidate object";
         return false;
@@ -6397,7 +6639,7 @@ bool Condition::CanProduceShips::Match(const ScriptingContext& local_context) co
     // is it a ship, a planet, or a building on a planet?
     std::string species_name;
     if (candidate->ObjectType() == OBJ_PLANET) {
-        TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+        ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
         if (!planet) {
             Logger().errorStream() << "CanProduceShips couldn't cast supposedly planet candidate";
             return false;
@@ -6405,7 +6647,7 @@ bool Condition::CanProduceShips::Match(const ScriptingContext& local_context) co
         species_name = planet->SpeciesName();
 
     } else if (candidate->ObjectType() == OBJ_BUILDING) {
-        TemporaryPtr<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
+        ObjectHandle<const ::Building> building = boost::dynamic_pointer_cast<const ::Building>(candidate);
         if (!building) {
             Logger().errorStream() << "CanProduceShips couldn't cast supposedly building candidate";
             return false;
@@ -6418,7 +6660,7 @@ bool Condition::CanProduceShips::Match(const ScriptingContext& local_context) co
         species_name = planet->SpeciesName();
 
     } else if (candidate->ObjectType() == OBJ_SHIP) {
-        TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
+        ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(candidate);
         if (!ship) {
             Logger().errorStream() << "CanProduceShips couldn't cast supposedly ship candidate";
             return false;
@@ -6461,12 +6703,12 @@ namespace {
             m_by_objects(by_objects)
         {}
 
-        bool operator()(TemporaryPtr<const UniverseObject> candidate) const {
+        bool operator()(ObjectHandle<const UniverseObject> candidate) const {
             if (!candidate)
                 return false;
             if (m_by_objects.empty())
                 return false;
-            TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
+            ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(candidate);
             if (!planet)
                 return false;
             int planet_id = planet->ID();
@@ -6477,7 +6719,7 @@ namespace {
             for (Condition::ObjectSet::const_iterator it = m_by_objects.begin();
                  it != m_by_objects.end(); ++it)
             {
-                TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(*it);
+                ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(*it);
                 if (!ship)
                     continue;
                 if (ship->OrderedBombardPlanet() == planet_id)
@@ -6497,7 +6739,7 @@ void Condition::OrderedBombarded::Eval(const ScriptingContext& parent_context,
     bool simple_eval_safe = parent_context.condition_root_candidate || RootCandidateInvariant();
     if (simple_eval_safe) {
         // evaluate contained objects once and check for all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         // get subcondition matches
@@ -6535,7 +6777,7 @@ std::string Condition::OrderedBombarded::Dump() const
 { return DumpIndent() + "OrderedBombarded by_object = " + m_by_object_condition->Dump(); }
 
 bool Condition::OrderedBombarded::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "OrderedBombarded::Match passed no candidate object";
         return false;
@@ -6583,7 +6825,7 @@ void Condition::ValueTest::Eval(const ScriptingContext& parent_context,
 
     if (simple_eval_safe) {
         // evaluate value and range limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         float low = (m_low ? m_low->Eval(local_context) : -Meter::LARGE_VALUE);
@@ -6665,7 +6907,7 @@ std::string Condition::ValueTest::Dump() const {
 }
 
 bool Condition::ValueTest::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "ValueTest::Match passed no candidate object";
         return false;
@@ -6769,7 +7011,7 @@ void Condition::Location::Eval(const ScriptingContext& parent_context,
 
     if (simple_eval_safe) {
         // evaluate value and range limits once, use to match all candidates
-        TemporaryPtr<const UniverseObject> no_object;
+        ObjectHandle<const UniverseObject> no_object;
         ScriptingContext local_context(parent_context, no_object);
 
         std::string name1 = (m_name1 ? m_name1->Eval(local_context) : "");
@@ -6851,7 +7093,7 @@ std::string Condition::Location::Dump() const {
 }
 
 bool Condition::Location::Match(const ScriptingContext& local_context) const {
-    TemporaryPtr<const UniverseObject> candidate = local_context.condition_local_candidate;
+    ObjectHandle<const UniverseObject> candidate = local_context.condition_local_candidate;
     if (!candidate) {
         Logger().errorStream() << "Location::Match passed no candidate object";
         return false;
@@ -6897,7 +7139,7 @@ bool Condition::And::operator==(const Condition::ConditionBase& rhs) const {
 void Condition::And::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
                           ObjectSet& non_matches, SearchDomain search_domain/* = NON_MATCHES*/) const
 {
-    TemporaryPtr<const UniverseObject> no_object;
+    ObjectHandle<const UniverseObject> no_object;
     ScriptingContext local_context(parent_context, no_object);
 
     if (search_domain == NON_MATCHES) {
@@ -6982,6 +7224,14 @@ bool Condition::And::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::And::Dependencies() const {
+    unsigned int retval = DEPENDS_ON_NOTHING;
+    for (std::vector<const ConditionBase*>::const_iterator it = m_operands.begin();
+         it != m_operands.end(); ++it)
+    { retval |= (*it)->Dependencies(); }
+    return retval;
+}
+
 std::string Condition::And::Description(bool negated/* = false*/) const {
     if (m_operands.size() == 1) {
         return m_operands[0]->Description();
@@ -7045,7 +7295,7 @@ bool Condition::Or::operator==(const Condition::ConditionBase& rhs) const {
 void Condition::Or::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
                          ObjectSet& non_matches, SearchDomain search_domain/* = NON_MATCHES*/) const
 {
-    TemporaryPtr<const UniverseObject> no_object;
+    ObjectHandle<const UniverseObject> no_object;
     ScriptingContext local_context(parent_context, no_object);
 
     if (search_domain == NON_MATCHES) {
@@ -7132,6 +7382,14 @@ bool Condition::Or::SourceInvariant() const {
     return true;
 }
 
+unsigned int Condition::Or::Dependencies() const {
+    unsigned int retval = DEPENDS_ON_NOTHING;
+    for (std::vector<const ConditionBase*>::const_iterator it = m_operands.begin();
+         it != m_operands.end(); ++it)
+    { retval |= (*it)->Dependencies(); }
+    return retval;
+}
+
 std::string Condition::Or::Description(bool negated/* = false*/) const {
     if (m_operands.size() == 1) {
         return m_operands[0]->Description();
@@ -7181,7 +7439,7 @@ bool Condition::Not::operator==(const Condition::ConditionBase& rhs) const {
 void Condition::Not::Eval(const ScriptingContext& parent_context, ObjectSet& matches, ObjectSet& non_matches,
                           SearchDomain search_domain/* = NON_MATCHES*/) const
 {
-    TemporaryPtr<const UniverseObject> no_object;
+    ObjectHandle<const UniverseObject> no_object;
     ScriptingContext local_context(parent_context, no_object);
 
     if (search_domain == NON_MATCHES) {
@@ -7216,6 +7474,9 @@ bool Condition::Not::SourceInvariant() const {
     return m_source_invariant == INVARIANT;
 }
 
+unsigned int Condition::Not::Dependencies() const
+{ return m_operand->Dependencies(); }
+
 std::string Condition::Not::Description(bool negated/* = false*/) const
 { return m_operand->Description(true); }
 
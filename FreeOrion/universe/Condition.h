@@ -4,7 +4,7 @@
 
 #include "Enums.h"
 #include "ValueRefFwd.h"
-#include "TemporaryPtr.h"
+#include "ObjectHandle.h"
 
 #include "../util/Export.h"
 
@@ -21,7 +21,7 @@ struct ScriptingContext;
   * represent predicates about UniverseObjects used by, for instance, the
   * Effect system. */
 namespace Condition {
-    typedef std::vector<TemporaryPtr<const UniverseObject> > ObjectSet;
+    typedef std::vector<ObjectHandle<const UniverseObject> > ObjectSet;
 
     enum Invariance {
         UNKNOWN_INVARIANCE, ///< This condition hasn't yet calculated this invariance type
@@ -41,6 +41,22 @@ namespace Condition {
         SORT_RANDOM     ///< Objects will be selected randomly, without consideration of property values
     };
 
+    /** Kinds of game state that a condition's result may depend on, as bit
+      * flags.  Used to decide whether a previously evaluated result of a
+      * condition can be reused after some of the game state has changed. */
+    enum Dependency {
+        DEPENDS_ON_NOTHING  = 0,        ///< Result depends only on which objects exist and their (immutable) types
+        DEPENDS_ON_OWNER    = 1 << 0,   ///< Ownership of objects
+        DEPENDS_ON_LOCATION = 1 << 1,   ///< Positions of objects, the systems they are in and starlanes
+        DEPENDS_ON_METERS   = 1 << 2,   ///< Meter values of objects
+        DEPENDS_ON_FOCUS    = 1 << 3,   ///< Foci of planets
+        DEPENDS_ON_SPECIES  = 1 << 4,   ///< Species of planets and ships
+        DEPENDS_ON_SPECIALS = 1 << 5,   ///< Specials attached to objects
+        DEPENDS_ON_EMPIRE   = 1 << 6,   ///< Empire state, such as techs, capitals, queues, supply and visibility
+        DEPENDS_ON_OTHER    = 1 << 7,   ///< Any other object properties, the current turn or randomness
+        DEPENDS_ON_ANYTHING = 0xff
+    };
+
     enum ContentType {
         CONTENT_BUILDING,
         CONTENT_SPECIES,
@@ -155,11 +171,11 @@ struct FO_COMMON_API Condition::ConditionBase {
 
     /** Tests single candidate object, returning true iff it matches condition. */
     bool                Eval(const ScriptingContext& parent_context,
-                             TemporaryPtr<const UniverseObject> candidate) const;
+                             ObjectHandle<const UniverseObject> candidate) const;
 
     /** Tests single candidate object, returning true iff it matches condition
       * with empty ScriptingContext. */
-    bool                Eval(TemporaryPtr<const UniverseObject> candidate) const;
+    bool                Eval(ObjectHandle<const UniverseObject> candidate) const;
 
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                           Condition::ObjectSet& condition_non_targets) const;
@@ -185,6 +201,11 @@ struct FO_COMMON_API Condition::ConditionBase {
       * source object.*/
     virtual bool        SourceInvariant() const { return false; }
 
+    /** Returns the Dependency flags of all game state that this condition's
+      * evaluation may read.  The default is DEPENDS_ON_ANYTHING; conditions
+      * that can tell more precisely override this. */
+    virtual unsigned int Dependencies() const { return DEPENDS_ON_ANYTHING; }
+
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -236,6 +257,12 @@ private:
     const ValueRef::ValueRefBase<int>* m_high;
     const ConditionBase*               m_condition;
 
+    Number() :
+        m_low(0),
+        m_high(0),
+        m_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -267,6 +294,11 @@ private:
     const ValueRef::ValueRefBase<int>* m_low;
     const ValueRef::ValueRefBase<int>* m_high;
 
+    Turn() :
+        m_low(0),
+        m_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -324,6 +356,12 @@ private:
     SortingMethod                           m_sorting_method;
     const ConditionBase*                    m_condition;
 
+    SortedNumberOf() :
+        m_number(0),
+        m_sort_key(0),
+        m_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -337,6 +375,7 @@ struct FO_COMMON_API Condition::All : public Condition::ConditionBase {
                              Condition::ObjectSet& non_matches, SearchDomain search_domain = NON_MATCHES) const;
     void                Eval(Condition::ObjectSet& matches, Condition::ObjectSet& non_matches,
                              SearchDomain search_domain = NON_MATCHES) const { ConditionBase::Eval(matches, non_matches, search_domain); }
+    virtual unsigned int Dependencies() const { return DEPENDS_ON_NOTHING; }
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     virtual bool        RootCandidateInvariant() const { return true; }
@@ -371,8 +410,10 @@ struct FO_COMMON_API Condition::EmpireAffiliation : public Condition::ConditionB
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const;
     const ValueRef::ValueRefBase<int>*  EmpireID() const { return m_empire_id; }
     EmpireAffiliationType               GetAffiliation() const { return m_affiliation; }
 
@@ -382,6 +423,10 @@ private:
     const ValueRef::ValueRefBase<int>* m_empire_id;
     EmpireAffiliationType              m_affiliation;
 
+    EmpireAffiliation() :
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -394,6 +439,7 @@ struct FO_COMMON_API Condition::Source : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const { return true; }
     virtual bool        TargetInvariant() const { return true; }
     //virtual bool        SourceInvariant() const { return false; } // same as ConditionBase
+    virtual unsigned int Dependencies() const { return DEPENDS_ON_NOTHING; }
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const;
@@ -416,6 +462,7 @@ struct FO_COMMON_API Condition::RootCandidate : public Condition::ConditionBase
     virtual bool        RootCandidateInvariant() const { return false; }
     virtual bool        TargetInvariant() const { return true; }
     virtual bool        SourceInvariant() const { return true; }
+    virtual unsigned int Dependencies() const { return DEPENDS_ON_NOTHING; }
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -437,6 +484,7 @@ struct FO_COMMON_API Condition::Target : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const { return true; }
     virtual bool        TargetInvariant() const { return false; }
     virtual bool        SourceInvariant() const { return true; }
+    virtual unsigned int Dependencies() const { return DEPENDS_ON_NOTHING; }
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const;
@@ -554,6 +602,7 @@ struct FO_COMMON_API Condition::Type : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ValueRef::ValueRefBase<UniverseObjectType>*   GetType() const { return m_type; }
@@ -564,6 +613,10 @@ private:
 
     const ValueRef::ValueRefBase<UniverseObjectType>* m_type;
 
+    Type() :
+        m_type(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -584,6 +637,7 @@ struct FO_COMMON_API Condition::Building : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<const ValueRef::ValueRefBase<std::string>*>   Names() const { return m_names; }
@@ -594,6 +648,8 @@ private:
 
     std::vector<const ValueRef::ValueRefBase<std::string>*> m_names;
 
+    Building() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -622,6 +678,7 @@ struct FO_COMMON_API Condition::HasSpecial : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::string&                  Name() const { return m_name; }
@@ -635,6 +692,11 @@ private:
     const ValueRef::ValueRefBase<int>*  m_since_turn_low;
     const ValueRef::ValueRefBase<int>*  m_since_turn_high;
 
+    HasSpecial() :
+        m_since_turn_low(0),
+        m_since_turn_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -658,6 +720,8 @@ private:
 
     std::string                         m_name;
 
+    HasTag() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -689,6 +753,11 @@ private:
     const ValueRef::ValueRefBase<int>*  m_low;
     const ValueRef::ValueRefBase<int>*  m_high;
 
+    CreatedOnTurn() :
+        m_low(0),
+        m_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -720,6 +789,10 @@ private:
 
     const ConditionBase* m_condition;
 
+    Contains() :
+        m_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -750,6 +823,10 @@ private:
 
     const ConditionBase* m_condition;
 
+    ContainedBy() :
+        m_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -778,6 +855,10 @@ private:
 
     const ValueRef::ValueRefBase<int>* m_system_id;
 
+    InSystem() :
+        m_system_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -807,6 +888,10 @@ private:
 
     const ValueRef::ValueRefBase<int>* m_object_id;
 
+    ObjectID() :
+        m_object_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -828,6 +913,7 @@ struct FO_COMMON_API Condition::PlanetType : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<const ValueRef::ValueRefBase< ::PlanetType>*>&    Types() const { return m_types; }
@@ -838,6 +924,8 @@ private:
 
     std::vector<const ValueRef::ValueRefBase< ::PlanetType>*> m_types;
 
+    PlanetType() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -859,6 +947,7 @@ struct FO_COMMON_API Condition::PlanetSize : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<const ValueRef::ValueRefBase< ::PlanetSize>*>&    Sizes() const { return m_sizes; }
@@ -869,6 +958,8 @@ private:
 
     std::vector<const ValueRef::ValueRefBase< ::PlanetSize>*> m_sizes;
 
+    PlanetSize() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -900,6 +991,8 @@ private:
 
     std::vector<const ValueRef::ValueRefBase< ::PlanetEnvironment>*> m_environments;
 
+    PlanetEnvironment() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -926,8 +1019,10 @@ struct FO_COMMON_API Condition::Species : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
+    virtual void        GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, Condition::ObjectSet& condition_non_targets) const;
     const std::vector<const ValueRef::ValueRefBase<std::string>*>&  Names() const { return m_names; }
 
 private:
@@ -1024,6 +1119,7 @@ struct FO_COMMON_API Condition::FocusType : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<const ValueRef::ValueRefBase<std::string>*>&  Names() const { return m_names; }
@@ -1033,6 +1129,8 @@ private:
 
     std::vector<const ValueRef::ValueRefBase<std::string>*> m_names;
 
+    FocusType() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1053,6 +1151,7 @@ struct FO_COMMON_API Condition::StarType : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<const ValueRef::ValueRefBase< ::StarType>*>&  Types() const { return m_types; }
@@ -1062,6 +1161,8 @@ private:
 
     std::vector<const ValueRef::ValueRefBase< ::StarType>*> m_types;
 
+    StarType() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1085,6 +1186,8 @@ private:
 
     std::string     m_name;
 
+    DesignHasHull() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1121,6 +1224,11 @@ private:
     const ValueRef::ValueRefBase<int>*  m_high;
     std::string                         m_name;
 
+    DesignHasPart() :
+        m_low(0),
+        m_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1157,6 +1265,11 @@ private:
     const ValueRef::ValueRefBase<int>*  m_high;
     ShipPartClass                       m_class;
 
+    DesignHasPartClass() :
+        m_low(0),
+        m_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1181,6 +1294,8 @@ private:
 
     std::string     m_name;
 
+    PredefinedShipDesign() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1209,6 +1324,10 @@ private:
 
     const ValueRef::ValueRefBase<int>* m_design_id;
 
+    NumberedShipDesign() :
+        m_design_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1237,6 +1356,10 @@ private:
 
     const ValueRef::ValueRefBase<int>* m_empire_id;
 
+    ProducedByEmpire() :
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1265,6 +1388,10 @@ private:
 
     const ValueRef::ValueRefBase<double>* m_chance;
 
+    Chance() :
+        m_chance(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1288,6 +1415,7 @@ struct FO_COMMON_API Condition::MeterValue : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ValueRef::ValueRefBase<double>*   Low() const { return m_low; }
@@ -1301,6 +1429,11 @@ private:
     const ValueRef::ValueRefBase<double>* m_low;
     const ValueRef::ValueRefBase<double>* m_high;
 
+    MeterValue() :
+        m_low(0),
+        m_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1341,6 +1474,15 @@ private:
     MeterType                               m_meter;
     const ValueRef::ValueRefBase<double>*   m_low;
     const ValueRef::ValueRefBase<double>*   m_high;
+
+    ShipPartMeterValue() :
+        m_low(0),
+        m_high(0)
+    {}
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
 };
 
 /** Matches all objects if the empire with id \a empire_id has an empire meter
@@ -1383,9 +1525,19 @@ private:
     virtual bool        Match(const ScriptingContext& local_context) const;
 
     const ValueRef::ValueRefBase<int>*      m_empire_id;
-    const std::string                       m_meter;
+    std::string                             m_meter;
     const ValueRef::ValueRefBase<double>*   m_low;
     const ValueRef::ValueRefBase<double>*   m_high;
+
+    EmpireMeterValue() :
+        m_empire_id(0),
+        m_low(0),
+        m_high(0)
+    {}
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
 };
 
 /** Matches all objects whose owner's stockpile of \a stockpile is between
@@ -1419,6 +1571,11 @@ private:
     const ValueRef::ValueRefBase<double>*   m_low;
     const ValueRef::ValueRefBase<double>*   m_high;
 
+    EmpireStockpileValue() :
+        m_low(0),
+        m_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1442,6 +1599,8 @@ private:
 
     std::string m_name;
 
+    OwnerHasTech() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1465,6 +1624,8 @@ private:
 
     std::string m_name;
 
+    OwnerHasBuildingTypeAvailable() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1488,6 +1649,8 @@ private:
 
     int m_id;
 
+    OwnerHasShipDesignAvailable() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1516,6 +1679,10 @@ private:
 
     const ValueRef::ValueRefBase<int>* m_empire_id;
 
+    VisibleToEmpire() :
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1539,6 +1706,7 @@ struct FO_COMMON_API Condition::WithinDistance : public Condition::ConditionBase
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -1548,6 +1716,11 @@ private:
     const ValueRef::ValueRefBase<double>* m_distance;
     const ConditionBase*                  m_condition;
 
+    WithinDistance() :
+        m_distance(0),
+        m_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1571,6 +1744,7 @@ struct FO_COMMON_API Condition::WithinStarlaneJumps : public Condition::Conditio
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
 
@@ -1580,6 +1754,11 @@ private:
     const ValueRef::ValueRefBase<int>* m_jumps;
     const ConditionBase*               m_condition;
 
+    WithinStarlaneJumps() :
+        m_jumps(0),
+        m_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1640,6 +1819,10 @@ private:
 
     const ValueRef::ValueRefBase<int>* m_empire_id;
 
+    ExploredByEmpire() :
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1688,6 +1871,10 @@ private:
 
     const ValueRef::ValueRefBase<int>*  m_empire_id;
 
+    FleetSupplyableByEmpire() :
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1719,6 +1906,11 @@ private:
     const ValueRef::ValueRefBase<int>*  m_empire_id;
     const ConditionBase*                m_condition;
 
+    ResourceSupplyConnectedByEmpire() :
+        m_empire_id(0),
+        m_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1785,6 +1977,10 @@ private:
 
     const ConditionBase*    m_by_object_condition;
 
+    OrderedBombarded() :
+        m_by_object_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1822,6 +2018,12 @@ private:
     const ValueRef::ValueRefBase<double>*   m_low;
     const ValueRef::ValueRefBase<double>*   m_high;
 
+    ValueTest() :
+        m_value_ref(0),
+        m_low(0),
+        m_high(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1858,6 +2060,11 @@ private:
     const ValueRef::ValueRefBase<std::string>*  m_name2;
     ContentType                                 m_content_type;
 
+    Location() :
+        m_name1(0),
+        m_name2(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1877,6 +2084,7 @@ struct FO_COMMON_API Condition::And : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<const ConditionBase*>&
@@ -1886,6 +2094,8 @@ struct FO_COMMON_API Condition::And : public Condition::ConditionBase {
 private:
     std::vector<const ConditionBase*> m_operands;
 
+    And() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1905,6 +2115,7 @@ struct FO_COMMON_API Condition::Or : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const std::vector<const ConditionBase*>&
@@ -1913,6 +2124,8 @@ struct FO_COMMON_API Condition::Or : public Condition::ConditionBase {
 private:
     std::vector<const ConditionBase*> m_operands;
 
+    Or() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -1932,6 +2145,7 @@ struct FO_COMMON_API Condition::Not : public Condition::ConditionBase {
     virtual bool        RootCandidateInvariant() const;
     virtual bool        TargetInvariant() const;
     virtual bool        SourceInvariant() const;
+    virtual unsigned int Dependencies() const;
     virtual std::string Description(bool negated = false) const;
     virtual std::string Dump() const;
     const ConditionBase*Operand() const { return m_operand; }
@@ -1939,6 +2153,10 @@ struct FO_COMMON_API Condition::Not : public Condition::ConditionBase {
 private:
     const ConditionBase* m_operand;
 
+    Not() :
+        m_operand(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -2201,6 +2419,26 @@ void Condition::MeterValue::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_high);
 }
 
+template <class Archive>
+void Condition::ShipPartMeterValue::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ConditionBase)
+        & BOOST_SERIALIZATION_NVP(m_part_name)
+        & BOOST_SERIALIZATION_NVP(m_meter)
+        & BOOST_SERIALIZATION_NVP(m_low)
+        & BOOST_SERIALIZATION_NVP(m_high);
+}
+
+template <class Archive>
+void Condition::EmpireMeterValue::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ConditionBase)
+        & BOOST_SERIALIZATION_NVP(m_empire_id)
+        & BOOST_SERIALIZATION_NVP(m_meter)
+        & BOOST_SERIALIZATION_NVP(m_low)
+        & BOOST_SERIALIZATION_NVP(m_high);
+}
+
 template <class Archive>
 void Condition::EmpireStockpileValue::serialize(Archive& ar, const unsigned int version)
 {
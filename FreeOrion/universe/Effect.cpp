@@ -258,12 +258,12 @@ void EffectsGroup::GetTargetSet(int source_id, TargetSet& targets, TargetSet& po
     if (m_activation && !m_activation->Eval(ScriptingContext(source), source))
         return;
 
-    BOOST_MPL_ASSERT((boost::is_same<TargetSet,             std::vector<TemporaryPtr<UniverseObject> > >));
-    BOOST_MPL_ASSERT((boost::is_same<Condition::ObjectSet,  std::vector<TemporaryPtr<const UniverseObject> > >));
+    BOOST_MPL_ASSERT((boost::is_same<TargetSet,             std::vector<ObjectHandle<UniverseObject> > >));
+    BOOST_MPL_ASSERT((boost::is_same<Condition::ObjectSet,  std::vector<ObjectHandle<const UniverseObject> > >));
 
     // HACK! We're doing some dirt here for efficiency's sake.  Since we can't
-    // const-cast std::set<TemporaryPtr<UniverseObject> > to std::set<const
-    // TemporaryPtr<UniverseObject> >, we're telling the compiler that one type is actually
+    // const-cast std::vector<ObjectHandle<UniverseObject> > to
+    // std::vector<ObjectHandle<const UniverseObject> >, we're telling the compiler that one type is actually
     // the other, rather than doing a copy.
     m_scope->Eval(ScriptingContext(source),
                   *static_cast<Condition::ObjectSet *>(static_cast<void *>(&targets)),
@@ -468,6 +468,11 @@ void EffectBase::Execute(const Effect::TargetsCauses& targets_causes,
         info.custom_label =         targets_and_cause.effect_cause.custom_label;
         info.source_id =            source_id;
 
+        // a meter value that doesn't depend on the target need only be
+        // evaluated once for this source, rather than once for each target
+        bool value_target_invariant = set_meter_effect && set_meter_effect->GetValue()->TargetInvariant();
+        float target_invariant_value = value_target_invariant ? set_meter_effect->GetValue()->Eval(source_context) : 0.0f;
+
         // process each target separately to do effect accounting
         for (TargetSet::const_iterator target_it = targets.begin();
             target_it != targets.end(); ++target_it)
@@ -499,7 +504,10 @@ void EffectBase::Execute(const Effect::TargetsCauses& targets_causes,
             info.running_meter_total =  meter->Current();
 
             // actually execute effect to modify meter
-            Execute(ScriptingContext(source, target));
+            if (value_target_invariant)
+                target->GetMeter(meter_type)->SetCurrent(target_invariant_value);
+            else
+                Execute(ScriptingContext(source, target));
 
             // update for meter change and new total
             info.meter_change = meter->Current() - info.running_meter_total;
@@ -529,7 +537,7 @@ void EffectBase::Execute(const ScriptingContext& context, const TargetSet& targe
 ///////////////////////////////////////////////////////////
 SetMeter::SetMeter(MeterType meter, const ValueRef::ValueRefBase<double>* value) :
     m_meter(meter),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {}
 
 SetMeter::~SetMeter()
@@ -557,8 +565,26 @@ void SetMeter::Execute(const ScriptingContext& context, const TargetSet& targets
         }
         return;
     }
-    // meter value does depend on target, so handle with default case
-    EffectBase::Execute(context, targets);
+    // meter value does depend on target, so evaluate it for all targets at
+    // once, starting from their current meter values, and then apply it
+    TargetSet meter_targets;
+    std::vector<Meter*> meters;
+    std::vector<double> values;
+    meter_targets.reserve(targets.size());
+    meters.reserve(targets.size());
+    values.reserve(targets.size());
+    for (TargetSet::const_iterator it = targets.begin(); it != targets.end(); ++it) {
+        Meter* m = (*it)->GetMeter(m_meter);
+        if (!m) continue;
+        meter_targets.push_back(*it);
+        meters.push_back(m);
+        values.push_back(m->Current());
+    }
+
+    m_value->EvalForTargets(context, meter_targets, values);
+
+    for (std::size_t i = 0; i < meters.size(); ++i)
+        meters[i]->SetCurrent(values[i]);
 }
 
 std::string SetMeter::Description() const {
@@ -642,7 +668,7 @@ SetShipPartMeter::SetShipPartMeter(MeterType meter,
     m_fighter_type(INVALID_COMBAT_FIGHTER_TYPE),
     m_part_name(),
     m_meter(meter),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {
     if (m_part_class == PC_FIGHTERS)
         Logger().errorStream() << "SetShipPartMeter passed ShipPartClass of PC_FIGHTERS, which is invalid";
@@ -655,7 +681,7 @@ SetShipPartMeter::SetShipPartMeter(MeterType meter,
     m_fighter_type(fighter_type),
     m_part_name(),
     m_meter(meter),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {}
 
 SetShipPartMeter::SetShipPartMeter(MeterType meter,
@@ -665,7 +691,7 @@ SetShipPartMeter::SetShipPartMeter(MeterType meter,
     m_fighter_type(INVALID_COMBAT_FIGHTER_TYPE),
     m_part_name(part_name),
     m_meter(meter),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {}
 
 SetShipPartMeter::~SetShipPartMeter()
@@ -791,14 +817,14 @@ std::string SetShipPartMeter::Dump() const {
 SetEmpireMeter::SetEmpireMeter(const std::string& meter, const ValueRef::ValueRefBase<double>* value) :
     m_empire_id(new ValueRef::Variable<int>(ValueRef::EFFECT_TARGET_REFERENCE, std::vector<std::string>(1, "Owner"))),
     m_meter(meter),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {}
 
 SetEmpireMeter::SetEmpireMeter(const ValueRef::ValueRefBase<int>* empire_id, const std::string& meter,
                                const ValueRef::ValueRefBase<double>* value) :
     m_empire_id(empire_id),
     m_meter(meter),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {}
 
 SetEmpireMeter::~SetEmpireMeter() {
@@ -857,7 +883,7 @@ SetEmpireStockpile::SetEmpireStockpile(ResourceType stockpile,
                                        const ValueRef::ValueRefBase<double>* value) :
     m_empire_id(new ValueRef::Variable<int>(ValueRef::EFFECT_TARGET_REFERENCE, std::vector<std::string>(1, "Owner"))),
     m_stockpile(stockpile),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {}
 
 SetEmpireStockpile::SetEmpireStockpile(const ValueRef::ValueRefBase<int>* empire_id,
@@ -865,7 +891,7 @@ SetEmpireStockpile::SetEmpireStockpile(const ValueRef::ValueRefBase<int>* empire
                                        const ValueRef::ValueRefBase<double>* value) :
     m_empire_id(empire_id),
     m_stockpile(stockpile),
-    m_value(value)
+    m_value(ValueRef::FoldConstants(value))
 {}
 
 SetEmpireStockpile::~SetEmpireStockpile() {
@@ -16,7 +16,7 @@ struct ScriptingContext;
 
 namespace Condition {
     struct ConditionBase;
-    typedef std::vector<TemporaryPtr<const UniverseObject> > ObjectSet;
+    typedef std::vector<ObjectHandle<const UniverseObject> > ObjectSet;
 }
 namespace Effect {
     class EffectsGroup;
@@ -122,6 +122,11 @@ protected:
     std::string                     m_accounting_label;
 
 private:
+    EffectsGroup() :
+        m_scope(0),
+        m_activation(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -170,11 +175,16 @@ public:
     virtual std::string Description() const;
     virtual std::string Dump() const;
     MeterType GetMeterType() const {return m_meter;};
+    const ValueRef::ValueRefBase<double>* GetValue() const {return m_value;};
 
 private:
     MeterType                             m_meter;
     const ValueRef::ValueRefBase<double>* m_value;
 
+    SetMeter() :
+        m_value(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -222,6 +232,10 @@ private:
     MeterType                             m_meter;
     const ValueRef::ValueRefBase<double>* m_value;
 
+    SetShipPartMeter() :
+        m_value(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -243,9 +257,14 @@ public:
 
 private:
     const ValueRef::ValueRefBase<int>*      m_empire_id;
-    const std::string                       m_meter;
+    std::string                             m_meter;
     const ValueRef::ValueRefBase<double>*   m_value;
 
+    SetEmpireMeter() :
+        m_empire_id(0),
+        m_value(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -271,6 +290,11 @@ private:
     ResourceType                            m_stockpile;
     const ValueRef::ValueRefBase<double>*   m_value;
 
+    SetEmpireStockpile() :
+        m_empire_id(0),
+        m_value(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -313,6 +337,10 @@ public:
 private:
     const ValueRef::ValueRefBase<PlanetType>* m_type;
 
+    SetPlanetType() :
+        m_type(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -335,6 +363,10 @@ public:
 private:
     const ValueRef::ValueRefBase<PlanetSize>* m_size;
 
+    SetPlanetSize() :
+        m_size(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -354,6 +386,10 @@ public:
 private:
     const ValueRef::ValueRefBase<std::string>* m_species_name;
 
+    SetSpecies() :
+        m_species_name(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -373,6 +409,10 @@ public:
 private:
     const ValueRef::ValueRefBase<int>* m_empire_id;
 
+    SetOwner() :
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -393,6 +433,11 @@ private:
     const ValueRef::ValueRefBase<PlanetType>*   m_type;
     const ValueRef::ValueRefBase<PlanetSize>*   m_size;
 
+    CreatePlanet() :
+        m_type(0),
+        m_size(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -410,6 +455,10 @@ public:
 private:
     const ValueRef::ValueRefBase<std::string>*  m_building_type_name;
 
+    CreateBuilding() :
+        m_building_type_name(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -435,11 +484,17 @@ public:
     virtual std::string Description() const;
     virtual std::string Dump() const;
 private:
-    const std::string                           m_design_name;
+    std::string                                 m_design_name;
     const ValueRef::ValueRefBase<int>*          m_design_id;
     const ValueRef::ValueRefBase<int>*          m_empire_id;
     const ValueRef::ValueRefBase<std::string>*  m_species_name;
 
+    CreateShip() :
+        m_design_id(0),
+        m_empire_id(0),
+        m_species_name(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -461,11 +516,17 @@ public:
     virtual std::string Description() const;
     virtual std::string Dump() const;
 private:
-    const std::string                       m_field_type_name;
+    std::string                             m_field_type_name;
     const ValueRef::ValueRefBase<double>*   m_x;
     const ValueRef::ValueRefBase<double>*   m_y;
     const ValueRef::ValueRefBase<double>*   m_size;
 
+    CreateField() :
+        m_x(0),
+        m_y(0),
+        m_size(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -490,6 +551,12 @@ private:
     const ValueRef::ValueRefBase<double>*       m_x;
     const ValueRef::ValueRefBase<double>*       m_y;
 
+    CreateSystem() :
+        m_type(0),
+        m_x(0),
+        m_y(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -526,6 +593,8 @@ public:
 private:
     std::string m_name;
 
+    AddSpecial() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -544,6 +613,8 @@ public:
 private:
     std::string m_name;
 
+    RemoveSpecial() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -563,6 +634,10 @@ public:
 private:
     const Condition::ConditionBase* m_other_lane_endpoint_condition;
 
+    AddStarlanes() :
+        m_other_lane_endpoint_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -582,6 +657,10 @@ public:
 private:
     const Condition::ConditionBase* m_other_lane_endpoint_condition;
 
+    RemoveStarlanes() :
+        m_other_lane_endpoint_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -601,6 +680,10 @@ public:
 private:
     const ValueRef::ValueRefBase<StarType>* m_type;
 
+    SetStarType() :
+        m_type(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -622,6 +705,10 @@ public:
 private:
     const Condition::ConditionBase* m_location_condition;
 
+    MoveTo() :
+        m_location_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -650,6 +737,13 @@ private:
     const ValueRef::ValueRefBase<double>*   m_focus_x;
     const ValueRef::ValueRefBase<double>*   m_focus_y;
 
+    MoveInOrbit() :
+        m_speed(0),
+        m_focal_point_condition(0),
+        m_focus_x(0),
+        m_focus_y(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -677,6 +771,13 @@ private:
     const ValueRef::ValueRefBase<double>*   m_dest_x;
     const ValueRef::ValueRefBase<double>*   m_dest_y;
 
+    MoveTowards() :
+        m_speed(0),
+        m_dest_condition(0),
+        m_dest_x(0),
+        m_dest_y(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -698,6 +799,10 @@ public:
 private:
     const Condition::ConditionBase* m_location_condition;
 
+    SetDestination() :
+        m_location_condition(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -715,6 +820,8 @@ public:
 private:
     bool m_aggressive;
 
+    SetAggression() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -733,6 +840,8 @@ public:
 private:
     std::string m_reason_string;
 
+    Victory() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -758,6 +867,12 @@ private:
     ValueRef::ValueRefBase<double>*     m_research_progress;
     const ValueRef::ValueRefBase<int>*  m_empire_id;
 
+    SetEmpireTechProgress() :
+        m_tech_name(0),
+        m_research_progress(0),
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -778,6 +893,10 @@ private:
     std::string                         m_tech_name;
     const ValueRef::ValueRefBase<int>*  m_empire_id;
 
+    GiveEmpireTech() :
+        m_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -812,6 +931,10 @@ private:
     const ValueRef::ValueRefBase<int>*              m_recipient_empire_id;
     EmpireAffiliationType                           m_affiliation;
 
+    GenerateSitRepMessage() :
+        m_recipient_empire_id(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -831,6 +954,10 @@ private:
     std::string                             m_texture;
     const ValueRef::ValueRefBase<double>*   m_size;
 
+    SetOverlayTexture() :
+        m_size(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -848,6 +975,8 @@ public:
 private:
     std::string m_texture;
 
+    SetTexture() {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -861,7 +990,8 @@ void Effect::EffectsGroup::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_activation)
         & BOOST_SERIALIZATION_NVP(m_stacking_group)
         & BOOST_SERIALIZATION_NVP(m_explicit_description)
-        & BOOST_SERIALIZATION_NVP(m_effects);
+        & BOOST_SERIALIZATION_NVP(m_effects)
+        & BOOST_SERIALIZATION_NVP(m_accounting_label);
 }
 
 template <class Archive>
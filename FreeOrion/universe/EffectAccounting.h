@@ -4,7 +4,7 @@
 
 #include "Enums.h"
 
-#include "TemporaryPtr.h"
+#include "ObjectHandle.h"
 #include <boost/shared_ptr.hpp>
 
 #include <map>
@@ -15,7 +15,7 @@ class UniverseObject;
 
 namespace Effect {
     class EffectsGroup;
-    typedef std::vector<TemporaryPtr<UniverseObject> > TargetSet;
+    typedef std::vector<ObjectHandle<UniverseObject> > TargetSet;
 
     /** Description of cause of an effect: the general cause type, and the
       * specific cause.  eg. Building and a particular BuildingType. */
@@ -74,6 +74,12 @@ namespace Effect {
       * of the same effects group due to having multiple copies of the same
       * ship part in its design. */
     typedef std::vector<std::pair<SourcedEffectsGroup, TargetsAndCause> > TargetsCauses;
+
+    /** Map from (effects group and source object id) to the targets of that
+      * effects group with that source object, as found by the last full
+      * evaluation of all effects groups.  An empty target set is stored for
+      * inactive effects groups or scopes that matched nothing. */
+    typedef std::map<std::pair<const EffectsGroup*, int>, TargetSet> TargetsCache;
 }
 
 #endif
@@ -5,7 +5,6 @@
 #include <boost/smart_ptr/enable_shared_from_this.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/smart_ptr/weak_ptr.hpp>
-#include <boost/thread/mutex.hpp>
 
 template <class T> class TemporaryPtr;
 
@@ -24,7 +23,6 @@ private:
     // friend class boost::shared_ptr; 
     template <class Y>
     friend class TemporaryPtr;
-    mutable boost::mutex m_ptr_mutex;
 };
 
 #include "EnableTemporaryFromThis.tcc"
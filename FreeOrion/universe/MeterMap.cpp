@@ -0,0 +1,200 @@
+#include "MeterMap.h"
+
+#include "ShipDesign.h"
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+///////////////////////////////////////////////////////////
+// MeterMap                                              //
+///////////////////////////////////////////////////////////
+MeterMap::MeterMap() :
+    m_types(0)
+{}
+
+std::size_t MeterMap::Size() const {
+    std::size_t retval = 0;
+    for (boost::uint64_t types = m_types; types; types &= types - 1)
+        ++retval;
+    return retval;
+}
+
+std::map<MeterType, Meter> MeterMap::ToMap() const {
+    std::map<MeterType, Meter> retval;
+    for (MeterType type = MeterType(0); type != NUM_METER_TYPES; type = MeterType(type + 1))
+        if (const Meter* meter = Get(type))
+            retval.insert(std::make_pair(type, *meter));
+    return retval;
+}
+
+Meter& MeterMap::operator[](MeterType type) {
+    if (type < 0 || type >= NUM_METER_TYPES)
+        throw std::invalid_argument("MeterMap::operator[] passed an invalid MeterType");
+    if (!Has(type)) {
+        m_types |= boost::uint64_t(1) << type;
+        m_meters[type] = Meter();
+    }
+    return m_meters[type];
+}
+
+void MeterMap::Clear()
+{ m_types = 0; }
+
+void MeterMap::FromMap(const std::map<MeterType, Meter>& meters) {
+    Clear();
+    for (std::map<MeterType, Meter>::const_iterator it = meters.begin(); it != meters.end(); ++it)
+        (*this)[it->first] = it->second;
+}
+
+///////////////////////////////////////////////////////////
+// Part name ids                                         //
+///////////////////////////////////////////////////////////
+namespace {
+    /** The ids of the names of all part types.  They are assigned once, when
+      * they are first needed, and never change, so they are looked up
+      * without locking. */
+    struct PartTypeNameIDs {
+        PartTypeNameIDs() {
+            const PartTypeManager& manager = GetPartTypeManager();
+            for (PartTypeManager::iterator it = manager.begin(); it != manager.end(); ++it) {
+                ids[it->first] = static_cast<int>(names.size());
+                names.push_back(it->first);
+            }
+        }
+
+        boost::unordered_map<std::string, int>  ids;
+        std::vector<std::string>                names;
+    };
+
+    const PartTypeNameIDs& PartTypeNames() {
+        static const PartTypeNameIDs part_type_names;
+        return part_type_names;
+    }
+
+    // names that aren't part types, such as those of parts in games saved
+    // with other content, get ids after those of the part types.  these are
+    // rare, so they are kept under a mutex
+    boost::mutex                            s_other_part_names_mutex;
+    boost::unordered_map<std::string, int>  s_other_part_name_ids;
+    std::vector<std::string>                s_other_part_names;
+}
+
+int PartNameID(const std::string& part_name) {
+    const PartTypeNameIDs& part_type_names = PartTypeNames();
+    boost::unordered_map<std::string, int>::const_iterator it = part_type_names.ids.find(part_name);
+    if (it != part_type_names.ids.end())
+        return it->second;
+
+    boost::mutex::scoped_lock lock(s_other_part_names_mutex);
+    std::pair<boost::unordered_map<std::string, int>::iterator, bool> result =
+        s_other_part_name_ids.insert(std::make_pair(part_name, static_cast<int>(part_type_names.names.size() +
+                                                                                s_other_part_names.size())));
+    if (result.second)
+        s_other_part_names.push_back(part_name);
+    return result.first->second;
+}
+
+int FindPartNameID(const std::string& part_name) {
+    const PartTypeNameIDs& part_type_names = PartTypeNames();
+    boost::unordered_map<std::string, int>::const_iterator it = part_type_names.ids.find(part_name);
+    if (it != part_type_names.ids.end())
+        return it->second;
+
+    boost::mutex::scoped_lock lock(s_other_part_names_mutex);
+    it = s_other_part_name_ids.find(part_name);
+    return it != s_other_part_name_ids.end() ? it->second : -1;
+}
+
+std::string PartNameFromID(int id) {
+    const PartTypeNameIDs& part_type_names = PartTypeNames();
+    if (0 <= id && id < static_cast<int>(part_type_names.names.size()))
+        return part_type_names.names[id];
+
+    boost::mutex::scoped_lock lock(s_other_part_names_mutex);
+    return s_other_part_names.at(id - part_type_names.names.size());
+}
+
+///////////////////////////////////////////////////////////
+// PartMeterMap                                          //
+///////////////////////////////////////////////////////////
+namespace {
+    struct KeyLess {
+        bool operator()(const std::pair<PartMeterMap::Key, Meter>& lhs, const PartMeterMap::Key& rhs) const
+        { return lhs.first < rhs; }
+        bool operator()(const PartMeterMap::Key& lhs, const std::pair<PartMeterMap::Key, Meter>& rhs) const
+        { return lhs < rhs.first; }
+        bool operator()(const std::pair<PartMeterMap::Key, Meter>& lhs, const std::pair<PartMeterMap::Key, Meter>& rhs) const
+        { return lhs.first < rhs.first; }
+    };
+}
+
+const Meter* PartMeterMap::Get(MeterType type, const std::string& part_name) const
+{ return Get(type, FindPartNameID(part_name)); }
+
+const Meter* PartMeterMap::Get(MeterType type, int part_name_id) const
+{ return part_name_id < 0 ? 0 : Find(Key(type, part_name_id)); }
+
+std::size_t PartMeterMap::Size() const
+{ return m_meters.size(); }
+
+PartMeterMap::const_iterator PartMeterMap::begin() const
+{ return m_meters.begin(); }
+
+PartMeterMap::const_iterator PartMeterMap::end() const
+{ return m_meters.end(); }
+
+std::map<std::pair<MeterType, std::string>, Meter> PartMeterMap::ToMap() const {
+    std::map<std::pair<MeterType, std::string>, Meter> retval;
+    for (const_iterator it = m_meters.begin(); it != m_meters.end(); ++it)
+        retval.insert(std::make_pair(std::make_pair(it->first.first, PartNameFromID(it->first.second)), it->second));
+    return retval;
+}
+
+Meter* PartMeterMap::Get(MeterType type, const std::string& part_name)
+{ return Get(type, FindPartNameID(part_name)); }
+
+Meter* PartMeterMap::Get(MeterType type, int part_name_id)
+{ return part_name_id < 0 ? 0 : const_cast<Meter*>(Find(Key(type, part_name_id))); }
+
+Meter& PartMeterMap::Add(MeterType type, const std::string& part_name)
+{ return Insert(Key(type, PartNameID(part_name))); }
+
+Meter& PartMeterMap::Add(MeterType type, int part_name_id)
+{ return Insert(Key(type, part_name_id)); }
+
+void PartMeterMap::AddMissing(const PartMeterMap& meters) {
+    for (const_iterator it = meters.begin(); it != meters.end(); ++it)
+        Insert(it->first);
+}
+
+PartMeterMap::iterator PartMeterMap::begin()
+{ return m_meters.begin(); }
+
+PartMeterMap::iterator PartMeterMap::end()
+{ return m_meters.end(); }
+
+void PartMeterMap::FromMap(const std::map<std::pair<MeterType, std::string>, Meter>& meters) {
+    m_meters.clear();
+    m_meters.reserve(meters.size());
+    for (std::map<std::pair<MeterType, std::string>, Meter>::const_iterator it = meters.begin();
+         it != meters.end(); ++it)
+    { Insert(Key(it->first.first, PartNameID(it->first.second))) = it->second; }
+}
+
+const Meter* PartMeterMap::Find(const Key& key) const {
+    const_iterator it = std::lower_bound(m_meters.begin(), m_meters.end(), key, KeyLess());
+    if (it != m_meters.end() && it->first == key)
+        return &it->second;
+    return 0;
+}
+
+Meter& PartMeterMap::Insert(const Key& key) {
+    iterator it = std::lower_bound(m_meters.begin(), m_meters.end(), key, KeyLess());
+    if (it == m_meters.end() || it->first != key)
+        it = m_meters.insert(it, std::make_pair(key, Meter()));
+    return it->second;
+}
@@ -0,0 +1,125 @@
+// -*- C++ -*-
+#ifndef _MeterMap_h_
+#define _MeterMap_h_
+
+#include "Enums.h"
+#include "Meter.h"
+#include "../util/Export.h"
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** The meters of a UniverseObject.  Meters are stored in an array indexed by
+  * MeterType, along with a bitmask of which meter types the object has, so
+  * that getting a meter doesn't need to search for it. */
+class FO_COMMON_API MeterMap {
+public:
+    /** \name Structors */ //@{
+    MeterMap();
+    //@}
+
+    /** \name Accessors */ //@{
+    bool            Has(MeterType type) const;  ///< returns true iff there is a meter of type \a type
+    const Meter*    Get(MeterType type) const;  ///< returns the meter of type \a type, or 0 if there is none
+    std::size_t     Size() const;               ///< returns the number of meters
+
+    /** Returns the meters as a map. */
+    std::map<MeterType, Meter>  ToMap() const;
+    //@}
+
+    /** \name Mutators */ //@{
+    Meter*          Get(MeterType type);        ///< returns the meter of type \a type, or 0 if there is none
+    Meter&          operator[](MeterType type); ///< returns the meter of type \a type, adding a default Meter if there is none
+    void            Clear();                    ///< removes all meters
+
+    /** Replaces the meters with those in \a meters, which is how they were
+      * serialized in older saves. */
+    void            FromMap(const std::map<MeterType, Meter>& meters);
+    //@}
+
+private:
+    BOOST_STATIC_ASSERT(NUM_METER_TYPES <= 64);
+
+    boost::uint64_t m_types;                    ///< bit i is set iff there is a meter of MeterType i
+    Meter           m_meters[NUM_METER_TYPES];
+};
+
+/** Returns the id that \a part_name is interned as for PartMeterMap, adding
+  * it if it isn't interned yet.  The names of all part types are interned
+  * when they are first needed, and are looked up without locking.  Ids are
+  * only valid during this run of the program. */
+FO_COMMON_API int                   PartNameID(const std::string& part_name);
+
+/** Returns the id that \a part_name is interned as, or -1 if it isn't
+  * interned, in which case no PartMeterMap has a meter for it. */
+FO_COMMON_API int                   FindPartNameID(const std::string& part_name);
+
+/** Returns the part name interned as \a id. */
+FO_COMMON_API std::string           PartNameFromID(int id);
+
+/** The meters of the parts of a Ship, each identified by its MeterType and
+  * part name.  Part names are interned as ids, and the meters are kept in a
+  * vector sorted by type and part name id, so that getting a meter is a
+  * binary search over a small contiguous array instead of a walk over a tree
+  * that compares strings.  Code that gets meters of the same part repeatedly
+  * can look up the part name id once and use the overloads that take it. */
+class FO_COMMON_API PartMeterMap {
+public:
+    typedef std::pair<MeterType, int>               Key;
+    typedef std::vector<std::pair<Key, Meter> >     Container;
+    typedef Container::iterator                     iterator;
+    typedef Container::const_iterator               const_iterator;
+
+    /** \name Accessors */ //@{
+    const Meter*    Get(MeterType type, const std::string& part_name) const;    ///< returns the part meter, or 0 if there is none
+    const Meter*    Get(MeterType type, int part_name_id) const;                ///< returns the part meter, or 0 if there is none
+    std::size_t     Size() const;
+
+    const_iterator  begin() const;
+    const_iterator  end() const;
+
+    /** Returns the meters as a map. */
+    std::map<std::pair<MeterType, std::string>, Meter>  ToMap() const;
+    //@}
+
+    /** \name Mutators */ //@{
+    Meter*          Get(MeterType type, const std::string& part_name);          ///< returns the part meter, or 0 if there is none
+    Meter*          Get(MeterType type, int part_name_id);                      ///< returns the part meter, or 0 if there is none
+    Meter&          Add(MeterType type, const std::string& part_name);          ///< returns the part meter, adding a default Meter if there is none
+    Meter&          Add(MeterType type, int part_name_id);                      ///< returns the part meter, adding a default Meter if there is none
+
+    /** Adds a default Meter for each part meter in \a meters that isn't
+      * present yet, leaving existing meters unchanged. */
+    void            AddMissing(const PartMeterMap& meters);
+
+    iterator        begin();
+    iterator        end();
+
+    /** Replaces the meters with those in \a meters, which is how they were
+      * serialized in older saves. */
+    void            FromMap(const std::map<std::pair<MeterType, std::string>, Meter>& meters);
+    //@}
+
+private:
+    const Meter*    Find(const Key& key) const;
+    Meter&          Insert(const Key& key);
+
+    Container       m_meters;
+};
+
+// inline implementations
+inline bool MeterMap::Has(MeterType type) const
+{ return type >= 0 && type < NUM_METER_TYPES && (m_types & (boost::uint64_t(1) << type)); }
+
+inline const Meter* MeterMap::Get(MeterType type) const
+{ return Has(type) ? &m_meters[type] : 0; }
+
+inline Meter* MeterMap::Get(MeterType type)
+{ return Has(type) ? &m_meters[type] : 0; }
+
+#endif // _MeterMap_h_
@@ -0,0 +1,117 @@
+// -*- C++ -*-
+#ifndef _ObjectHandle_h_
+#define _ObjectHandle_h_
+
+#include "TemporaryPtr.h"
+
+template <class T> class ObjectHandle;
+
+namespace boost {
+
+template <class Y, class R> ObjectHandle<Y> static_pointer_cast (const ObjectHandle<R>& item);
+template <class Y, class R> ObjectHandle<Y> dynamic_pointer_cast(const ObjectHandle<R>& item);
+template <class Y, class R> ObjectHandle<Y> const_pointer_cast  (const ObjectHandle<R>& item);
+
+}
+
+/** A non-owning handle to a UniverseObject, for the sets of objects that are
+  * built and used within one phase of turn processing, such as condition
+  * candidates and matches and effects targets.  No objects are freed during
+  * such a phase, so unlike TemporaryPtr, a handle does not keep its object
+  * alive, and copying, casting or destroying it doesn't touch a reference
+  * count.  Handles convert implicitly from TemporaryPtr, and to TemporaryPtr
+  * for passing objects on to code that may keep them beyond the phase; only
+  * that conversion touches the reference count. */
+template <class T>
+class ObjectHandle {
+public:
+    /** \name Structors */ //@{
+    ObjectHandle() :
+        m_ptr(0)
+    {}
+
+    template <class Y>
+    ObjectHandle(const ObjectHandle<Y>& rhs) :
+        m_ptr(rhs.get())
+    {}
+
+    template <class Y>
+    ObjectHandle(const TemporaryPtr<Y>& rhs) :
+        m_ptr(rhs.get())
+    {}
+
+    explicit ObjectHandle(T* ptr) :
+        m_ptr(ptr)
+    {}
+    //@}
+
+    /** \name Accessors */ //@{
+    T*   get() const { return m_ptr; }
+
+    operator bool() const { return m_ptr != 0; }
+    T* operator ->() const { return m_ptr; }
+    T& operator *() const  { return *m_ptr; }
+
+    /** Returns a TemporaryPtr that shares ownership of the object. */
+    template <class Y>
+    operator TemporaryPtr<Y>() const {
+        if (!m_ptr)
+            return TemporaryPtr<Y>();
+        return TemporaryPtr<Y>(boost::static_pointer_cast<T>(m_ptr->TemporaryFromThis()));
+    }
+    //@}
+
+private:
+    T* m_ptr;
+};
+
+/** ObjectHandle comparison operators */
+//@{
+
+#define OBJECT_HANDLE_OP(op) \
+    template <class Y, class R> \
+    bool operator op (const ObjectHandle<Y>& lhs, const ObjectHandle<R>& rhs) \
+    { return lhs.get() op rhs.get(); } \
+    template <class Y, class R> \
+    bool operator op (const ObjectHandle<Y>& lhs, const TemporaryPtr<R>& rhs) \
+    { return lhs.get() op rhs.get(); } \
+    template <class Y, class R> \
+    bool operator op (const TemporaryPtr<Y>& lhs, const ObjectHandle<R>& rhs) \
+    { return lhs.get() op rhs.get(); } \
+    template <class Y, class R> \
+    bool operator op (const ObjectHandle<Y>& lhs, R* rhs) \
+    { return lhs.get() op rhs; } \
+    template <class Y, class R> \
+    bool operator op (Y* lhs, const ObjectHandle<R>& rhs) \
+    { return lhs op rhs.get(); }
+
+OBJECT_HANDLE_OP(==)
+OBJECT_HANDLE_OP(!=)
+OBJECT_HANDLE_OP(<)
+OBJECT_HANDLE_OP(>)
+OBJECT_HANDLE_OP(<=)
+OBJECT_HANDLE_OP(>=)
+
+#undef OBJECT_HANDLE_OP
+
+//@}
+
+namespace boost {
+
+/** Casts return handles, so casting a candidate to a more specific type
+  * doesn't touch any reference count either. */
+template <class Y, class R>
+ObjectHandle<Y> static_pointer_cast(const ObjectHandle<R>& item)
+{ return ObjectHandle<Y>(static_cast<Y*>(item.get())); }
+
+template <class Y, class R>
+ObjectHandle<Y> dynamic_pointer_cast(const ObjectHandle<R>& item)
+{ return ObjectHandle<Y>(dynamic_cast<Y*>(item.get())); }
+
+template <class Y, class R>
+ObjectHandle<Y> const_pointer_cast(const ObjectHandle<R>& item)
+{ return ObjectHandle<Y>(const_cast<Y*>(item.get())); }
+
+}
+
+#endif // _ObjectHandle_h_
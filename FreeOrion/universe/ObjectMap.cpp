@@ -27,7 +27,23 @@
 /////////////////////////////////////////////
 // class ObjectMap
 /////////////////////////////////////////////
-ObjectMap::ObjectMap()
+namespace {
+    const std::map<int, TemporaryPtr<UniverseObject> > EMPTY_OBJECT_INDEX;
+    const boost::shared_ptr<UniverseObject> NULL_OBJECT_PTR;
+
+    // ids beyond this much more than the number of objects are not stored in
+    // ObjectMap::m_objects_by_id, so that few objects with very large ids
+    // don't make it huge
+    const int MIN_OBJECTS_BY_ID_SLACK = 1024;
+
+    void AssignIfChanged(std::set<int>& lhs, const std::set<int>& rhs) {
+        if (lhs != rhs)
+            lhs = rhs;
+    }
+}
+
+ObjectMap::ObjectMap() :
+    m_object_indexes_valid(false)
 {}
 
 ObjectMap::~ObjectMap() {
@@ -52,6 +68,7 @@ void ObjectMap::CopyForSerialize(const ObjectMap& copied_map) {
 
     // note: the following relies upon only m_objects actually getting serialized by ObjectMap::serialize
     m_objects.insert(copied_map.m_objects.begin(), copied_map.m_objects.end());
+    RebuildObjectsByID();
 }
 
 void ObjectMap::CopyObject(TemporaryPtr<const UniverseObject> source, int empire_id/* = ALL_EMPIRES*/) {
@@ -64,13 +81,39 @@ void ObjectMap::CopyObject(TemporaryPtr<const UniverseObject> source, int empire
     if (GetUniverse().GetObjectVisibilityByEmpire(source_id, empire_id) <= VIS_NO_VISIBILITY)
         return;
     
-    if (TemporaryPtr<UniverseObject> destination = this->Object(source_id)) {
+    if (TemporaryPtr<UniverseObject> destination = this->UnsharedObject(source_id, empire_id)) {
         destination->Copy(source, empire_id); // there already is a version of this object present in this ObjectMap, so just update it
     } else {
         Insert(source->Clone(), empire_id); // this object is not yet present in this ObjectMap, so add a new UniverseObject object for it
     }
 }
 
+TemporaryPtr<UniverseObject> ObjectMap::UnsharedObject(int id, int empire_id/* = ALL_EMPIRES*/) {
+    if (m_shared_object_ids.find(id) == m_shared_object_ids.end())
+        return Object(id);
+    return CopiedObject(id, empire_id);
+}
+
+TemporaryPtr<UniverseObject> ObjectMap::CopiedObject(int id, int empire_id/* = ALL_EMPIRES*/) {
+    TemporaryPtr<UniverseObject> obj = Object(id);
+    if (!obj)
+        return obj;
+
+    // make a full copy of the object.  Clone copies the specials of the
+    // universe's version of the object, rather than this one, so they are
+    // copied separately
+    UniverseObject* copy = obj->Clone(ALL_EMPIRES);
+    if (!copy)
+        return obj;
+    copy->m_specials = obj->m_specials;
+    return Insert(copy, empire_id);
+}
+
+void ObjectMap::MarkShared(int id) {
+    if (Object(id))
+        m_shared_object_ids.insert(id);
+}
+
 ObjectMap* ObjectMap::Clone(int empire_id) const {
     ObjectMap* result = new ObjectMap();
     result->Copy(*this, empire_id);
@@ -154,6 +197,11 @@ ObjectMap::const_iterator<> ObjectMap::const_end() const
 
 void ObjectMap::Insert(boost::shared_ptr<UniverseObject> item, int empire_id/* = ALL_EMPIRES*/) {
     FOR_EACH_MAP(TryInsertIntoMap, item);
+    if (item) {
+        SetObjectByID(item->ID(), item);
+        m_shared_object_ids.erase(item->ID());
+    }
+    m_object_indexes_valid = false;
     if (item &&
         GetUniverse().EmpireKnownDestroyedObjectIDs(empire_id).find(item->ID()) ==
             GetUniverse().EmpireKnownDestroyedObjectIDs(empire_id).end())
@@ -204,6 +252,8 @@ boost::shared_ptr<UniverseObject> ObjectMap::Remove(int id) {
     // and erase from pointer maps
     m_objects.erase(it);
     FOR_EACH_SPECIALIZED_MAP(EraseFromMap, id);
+    SetObjectByID(id, NULL_OBJECT_PTR);
+    m_shared_object_ids.erase(id);
     m_existing_objects.erase(id);
     m_existing_buildings.erase(id);
     m_existing_fields.erase(id);
@@ -213,15 +263,28 @@ boost::shared_ptr<UniverseObject> ObjectMap::Remove(int id) {
     m_existing_pop_centers.erase(id);
     m_existing_resource_centers.erase(id);
     m_existing_systems.erase(id);
+    m_object_indexes_valid = false;
     return result;
 }
 
 void ObjectMap::Clear() {
     FOR_EACH_MAP(ClearMap);
+    m_objects_by_id.clear();
+    m_shared_object_ids.clear();
+    m_existing_objects_by_owner.clear();
+    m_existing_objects_by_species.clear();
+    m_existing_buildings_by_type.clear();
+    m_object_indexes_valid = false;
 }
 
 void ObjectMap::swap(ObjectMap& rhs) {
     FOR_EACH_MAP(SwapMap, rhs);
+    m_objects_by_id.swap(rhs.m_objects_by_id);
+    m_shared_object_ids.swap(rhs.m_shared_object_ids);
+    m_existing_objects_by_owner.swap(rhs.m_existing_objects_by_owner);
+    m_existing_objects_by_species.swap(rhs.m_existing_objects_by_species);
+    m_existing_buildings_by_type.swap(rhs.m_existing_buildings_by_type);
+    std::swap(m_object_indexes_valid, rhs.m_object_indexes_valid);
 }
 
 std::vector<int> ObjectMap::FindExistingObjectIDs() const {
@@ -233,6 +296,7 @@ std::vector<int> ObjectMap::FindExistingObjectIDs() const {
 }
 
 void ObjectMap::UpdateCurrentDestroyedObjects(const std::set<int>& destroyed_object_ids) {
+    m_object_indexes_valid = false;
     m_existing_objects.clear();
     m_existing_buildings.clear();
     m_existing_fields.clear();
@@ -284,7 +348,9 @@ void ObjectMap::UpdateCurrentDestroyedObjects(const std::set<int>& destroyed_obj
     }
 }
 
-void ObjectMap::AuditContainment(const std::set<int>& destroyed_object_ids) {
+void ObjectMap::AuditContainment(const std::set<int>& destroyed_object_ids, bool copy_modified/* = false*/,
+                                 int empire_id/* = ALL_EMPIRES*/)
+{
     // determine all objects that some other object thinks contains them
     std::map<int, std::set<int> >   contained_objs;
     std::map<int, std::set<int> >   contained_planets;
@@ -330,38 +396,139 @@ void ObjectMap::AuditContainment(const std::set<int>& destroyed_object_ids) {
             contained_ships[alt_id].insert(contained_id);
     }
 
-    // set contained objects of all possible containers
+    // set contained objects of all possible containers.  objects that are
+    // already consistent are left untouched, so that auditing an audited map
+    // only reads its objects, and doesn't need to unshare them
     for (iterator<> it = begin(); it != end(); ++it) {
         TemporaryPtr<UniverseObject> obj = *it;
         if (obj->ObjectType() == OBJ_SYSTEM) {
             TemporaryPtr<System> sys = boost::dynamic_pointer_cast<System>(obj);
             if (!sys)
                 continue;
-            sys->m_objects =    contained_objs[sys->ID()];
-            sys->m_planets =    contained_planets[sys->ID()];
-            sys->m_buildings =  contained_buildings[sys->ID()];
-            sys->m_fleets =     contained_fleets[sys->ID()];
-            sys->m_ships =      contained_ships[sys->ID()];
-            sys->m_fields =     contained_fields[sys->ID()];
+            int sys_id = sys->ID();
+            if (sys->m_objects != contained_objs[sys_id] ||
+                sys->m_planets != contained_planets[sys_id] ||
+                sys->m_buildings != contained_buildings[sys_id] ||
+                sys->m_fleets != contained_fleets[sys_id] ||
+                sys->m_ships != contained_ships[sys_id] ||
+                sys->m_fields != contained_fields[sys_id])
+            { sys = boost::dynamic_pointer_cast<System>(copy_modified ? CopiedObject(sys_id, empire_id) : UnsharedObject(sys_id, empire_id)); }
+            AssignIfChanged(sys->m_objects,     contained_objs[sys->ID()]);
+            AssignIfChanged(sys->m_planets,     contained_planets[sys->ID()]);
+            AssignIfChanged(sys->m_buildings,   contained_buildings[sys->ID()]);
+            AssignIfChanged(sys->m_fleets,      contained_fleets[sys->ID()]);
+            AssignIfChanged(sys->m_ships,       contained_ships[sys->ID()]);
+            AssignIfChanged(sys->m_fields,      contained_fields[sys->ID()]);
         } else if (obj->ObjectType() == OBJ_PLANET) {
             TemporaryPtr<Planet> plt = boost::dynamic_pointer_cast<Planet>(obj);
             if (!plt)
                 continue;
-            plt->m_buildings =  contained_buildings[plt->ID()];
+            if (plt->m_buildings != contained_buildings[plt->ID()])
+                plt = boost::dynamic_pointer_cast<Planet>(copy_modified ? CopiedObject(plt->ID(), empire_id) : UnsharedObject(plt->ID(), empire_id));
+            AssignIfChanged(plt->m_buildings,   contained_buildings[plt->ID()]);
         } else if (obj->ObjectType() == OBJ_FLEET) {
             TemporaryPtr<Fleet> flt = boost::dynamic_pointer_cast<Fleet>(obj);
             if (!flt)
                 continue;
-            flt->m_ships =      contained_ships[flt->ID()];
+            if (flt->m_ships != contained_ships[flt->ID()])
+                flt = boost::dynamic_pointer_cast<Fleet>(copy_modified ? CopiedObject(flt->ID(), empire_id) : UnsharedObject(flt->ID(), empire_id));
+            AssignIfChanged(flt->m_ships,       contained_ships[flt->ID()]);
+        }
+    }
+}
+
+void ObjectMap::UpdateObjectIndexes() {
+    if (m_object_indexes_valid)
+        return;
+
+    m_existing_objects_by_owner.clear();
+    m_existing_objects_by_species.clear();
+    m_existing_buildings_by_type.clear();
+    for (std::map<int, TemporaryPtr<UniverseObject> >::iterator it = m_existing_objects.begin();
+         it != m_existing_objects.end(); ++it)
+    {
+        TemporaryPtr<UniverseObject> obj = it->second;
+        if (!obj)
+            continue;
+
+        if (!obj->Unowned())
+            m_existing_objects_by_owner[obj->Owner()][it->first] = obj;
+
+        switch (obj->ObjectType()) {
+            case OBJ_PLANET:
+                if (TemporaryPtr<Planet> planet = boost::dynamic_pointer_cast<Planet>(obj))
+                    if (!planet->SpeciesName().empty())
+                        m_existing_objects_by_species[planet->SpeciesName()][it->first] = obj;
+                break;
+            case OBJ_SHIP:
+                if (TemporaryPtr<Ship> ship = boost::dynamic_pointer_cast<Ship>(obj))
+                    if (!ship->SpeciesName().empty())
+                        m_existing_objects_by_species[ship->SpeciesName()][it->first] = obj;
+                break;
+            case OBJ_BUILDING:
+                if (TemporaryPtr<Building> building = boost::dynamic_pointer_cast<Building>(obj))
+                    m_existing_buildings_by_type[building->BuildingTypeName()][it->first] = obj;
+                break;
+            default:
+                break;
         }
     }
+    m_object_indexes_valid = true;
 }
 
+void ObjectMap::InvalidateObjectIndexes()
+{ m_object_indexes_valid = false; }
+
 void ObjectMap::CopyObjectsToSpecializedMaps() {
+    m_object_indexes_valid = false;
     FOR_EACH_SPECIALIZED_MAP(ClearMap);
     for (std::map<int, boost::shared_ptr<UniverseObject> >::iterator it = Map<UniverseObject>().begin();
          it != Map<UniverseObject>().end(); ++it)
     { FOR_EACH_SPECIALIZED_MAP(TryInsertIntoMap, it->second); }
+    RebuildObjectsByID();
+}
+
+const boost::shared_ptr<UniverseObject>& ObjectMap::ObjectPtr(int id) const {
+    if (0 <= id && id < static_cast<int>(m_objects_by_id.size()))
+        return m_objects_by_id[id];
+    std::map<int, boost::shared_ptr<UniverseObject> >::const_iterator it = m_objects.find(id);
+    return it != m_objects.end() ? it->second : NULL_OBJECT_PTR;
+}
+
+void ObjectMap::SetObjectByID(int id, const boost::shared_ptr<UniverseObject>& item) {
+    if (id < 0)
+        return;
+    int old_size = static_cast<int>(m_objects_by_id.size());
+    if (id < old_size) {
+        m_objects_by_id[id] = item;
+        return;
+    }
+    // ids outside the vector are found in m_objects, so there's nothing to
+    // do for removals, or for ids too far beyond the others
+    if (!item || id >= 2 * static_cast<int>(m_objects.size()) + MIN_OBJECTS_BY_ID_SLACK)
+        return;
+
+    // grow, and fill in all objects that weren't covered so far, including
+    // \a item, which is already in m_objects
+    m_objects_by_id.resize(id + 1);
+    for (std::map<int, boost::shared_ptr<UniverseObject> >::const_iterator it = m_objects.lower_bound(old_size);
+         it != m_objects.end() && it->first <= id; ++it)
+    { m_objects_by_id[it->first] = it->second; }
+}
+
+void ObjectMap::RebuildObjectsByID() {
+    m_objects_by_id.clear();
+    if (m_objects.empty())
+        return;
+    // size for the highest id that SetObjectByID would accept
+    std::map<int, boost::shared_ptr<UniverseObject> >::const_iterator last_it = m_objects.lower_bound(
+        2 * static_cast<int>(m_objects.size()) + MIN_OBJECTS_BY_ID_SLACK);
+    if (last_it == m_objects.begin())
+        return;
+    --last_it;
+    if (last_it->first < 0)
+        return;
+    SetObjectByID(last_it->first, last_it->second);
 }
 
 std::string ObjectMap::Dump() const {
@@ -380,6 +547,24 @@ TemporaryPtr<UniverseObject> ObjectMap::ExistingObject(int id) {
     return TemporaryPtr<UniverseObject>();
 }
 
+const std::map<int, TemporaryPtr<UniverseObject> >& ObjectMap::ExistingObjectsOwnedBy(int empire_id) const {
+    std::map<int, std::map<int, TemporaryPtr<UniverseObject> > >::const_iterator it =
+        m_existing_objects_by_owner.find(empire_id);
+    return it != m_existing_objects_by_owner.end() ? it->second : EMPTY_OBJECT_INDEX;
+}
+
+const std::map<int, TemporaryPtr<UniverseObject> >& ObjectMap::ExistingObjectsOfSpecies(const std::string& species_name) const {
+    std::map<std::string, std::map<int, TemporaryPtr<UniverseObject> > >::const_iterator it =
+        m_existing_objects_by_species.find(species_name);
+    return it != m_existing_objects_by_species.end() ? it->second : EMPTY_OBJECT_INDEX;
+}
+
+const std::map<int, TemporaryPtr<UniverseObject> >& ObjectMap::ExistingBuildingsOfType(const std::string& building_type_name) const {
+    std::map<std::string, std::map<int, TemporaryPtr<UniverseObject> > >::const_iterator it =
+        m_existing_buildings_by_type.find(building_type_name);
+    return it != m_existing_buildings_by_type.end() ? it->second : EMPTY_OBJECT_INDEX;
+}
+
 // Static helpers
 
 template<class T>
@@ -402,6 +587,42 @@ void ObjectMap::TryInsertIntoMap(std::map<int, boost::shared_ptr<T> >& map, boos
 
 // template specializations
 
+template <>
+boost::shared_ptr<UniverseObject>  ObjectMap::ObjectPtr(int id) const
+{ return ObjectPtr(id); }
+
+template <>
+boost::shared_ptr<ResourceCenter>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<ResourceCenter>(ObjectPtr(id)); }
+
+template <>
+boost::shared_ptr<PopCenter>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<PopCenter>(ObjectPtr(id)); }
+
+template <>
+boost::shared_ptr<Ship>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<Ship>(ObjectPtr(id)); }
+
+template <>
+boost::shared_ptr<Fleet>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<Fleet>(ObjectPtr(id)); }
+
+template <>
+boost::shared_ptr<Planet>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<Planet>(ObjectPtr(id)); }
+
+template <>
+boost::shared_ptr<System>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<System>(ObjectPtr(id)); }
+
+template <>
+boost::shared_ptr<Building>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<Building>(ObjectPtr(id)); }
+
+template <>
+boost::shared_ptr<Field>  ObjectMap::ObjectPtr(int id) const
+{ return boost::dynamic_pointer_cast<Field>(ObjectPtr(id)); }
+
 template <>
 const std::map<int, boost::shared_ptr<UniverseObject> >&  ObjectMap::Map() const
 { return m_objects; }
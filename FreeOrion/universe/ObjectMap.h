@@ -38,37 +38,37 @@ public:
         iterator(const typename std::map<int, boost::shared_ptr<T> >::iterator& base, ObjectMap& owner) :
             std::map<int, boost::shared_ptr<T> >::iterator(base),
             m_owner(owner)
-        { Refresh(); }
+        {}
 
-        TemporaryPtr<T> operator *() const
-        { return m_current_ptr; }
+        TemporaryPtr<T> operator *() const {
+            Refresh();
+            return m_current_ptr;
+        }
 
         // The result of this operator is not intended to be stored, so it's safe to
         // return a reference to an instance variable that's going to be soon overwritten.
-        TemporaryPtr<T>& operator ->() const
-        { return m_current_ptr; }
+        TemporaryPtr<T>& operator ->() const {
+            Refresh();
+            return m_current_ptr;
+        }
 
         iterator& operator ++() {
             std::map<int, boost::shared_ptr<T> >::iterator::operator++();
-            Refresh();
             return *this;
         }
 
         iterator operator ++(int) {
             iterator result = iterator(std::map<int, boost::shared_ptr<T> >::iterator::operator++(0), m_owner);
-            Refresh();
             return result;
         }
 
         iterator& operator --() {
             std::map<int, boost::shared_ptr<T> >::iterator::operator--();
-            Refresh();
             return *this;
         }
 
         iterator operator --(int) {
             iterator result = iterator(std::map<int, boost::shared_ptr<T> >::iterator::operator--(0), m_owner);
-            Refresh();
             return result;
         }
 
@@ -79,14 +79,15 @@ public:
         { return std::map<int, boost::shared_ptr<T> >::iterator::operator !=(other); }
 
     private:
-        // 
+        // Set only when the iterator is dereferenced, so that stepping over
+        // objects doesn't construct a TemporaryPtr for each of them.
         mutable TemporaryPtr<T> m_current_ptr;
         ObjectMap& m_owner;
 
-        // We always want m_current_ptr to be pointing to our parent iterator's
-        // current item, if it is a valid object. Otherwise, we just want to
-        // return a "null" pointer.  We assume that we are dealing with valid
-        // iterators in the range [begin(), end()].
+        // Points m_current_ptr to our parent iterator's current item, if it
+        // is a valid object. Otherwise, we just want to return a "null"
+        // pointer.  We assume that we are dealing with valid iterators in the
+        // range [begin(), end()].
         void Refresh() const {
             if (std::map<int, boost::shared_ptr<T> >::iterator::operator ==(m_owner.Map<T>().end())) {
                 m_current_ptr = TemporaryPtr<T>();
@@ -101,37 +102,37 @@ public:
         const_iterator(const typename std::map<int, boost::shared_ptr<T> >::const_iterator& base, const ObjectMap& owner) :
             std::map<int, boost::shared_ptr<T> >::const_iterator(base),
             m_owner(owner)
-        { Refresh(); }
+        {}
+
+        TemporaryPtr<const T> operator *() const {
+            Refresh();
+            return m_current_ptr;
+        }
 
-        TemporaryPtr<const T> operator *() const
-        { return m_current_ptr; }
-        
         // The result of this operator is not intended to be stored, so it's safe to
         // return a reference to an instance variable that's going to be soon overwritten.
-        TemporaryPtr<const T>& operator ->() const
-        { return m_current_ptr; }
+        TemporaryPtr<const T>& operator ->() const {
+            Refresh();
+            return m_current_ptr;
+        }
 
         const_iterator& operator ++() {
             std::map<int, boost::shared_ptr<T> >::const_iterator::operator++();
-            Refresh();
             return *this;
         }
 
         const_iterator operator ++(int) {
             const_iterator result = std::map<int, boost::shared_ptr<T> >::const_iterator::operator++(0);
-            Refresh();
             return result;
         }
 
         const_iterator& operator --() {
             std::map<int, boost::shared_ptr<T> >::const_iterator::operator--();
-            Refresh();
             return *this;
         }
 
         const_iterator operator --(int) {
             const_iterator result = std::map<int, boost::shared_ptr<T> >::const_iterator::operator--(0);
-            Refresh();
             return result;
         }
 
@@ -146,7 +147,7 @@ public:
         mutable TemporaryPtr<const T> m_current_ptr;
         const ObjectMap& m_owner;
 
-        // We always want m_current_ptr to be pointing to our parent iterator's current item, if it is a valid object.
+        // Points m_current_ptr to our parent iterator's current item, if it is a valid object.
         // Otherwise, we just want to return a "null" pointer.  We assume that we are dealing with valid iterators in
         // the range [begin(), end()].
         void Refresh() const {
@@ -331,6 +332,25 @@ public:
     int NumExistingFields()
     {return m_existing_fields.size(); }
 
+    /** Returns true if the indexes of existing objects by owner, species and
+      * building type are up to date.  They are updated with
+      * UpdateObjectIndexes() and become outdated when objects are added or
+      * removed or InvalidateObjectIndexes() is called. */
+    bool                ObjectIndexesValid() const
+    { return m_object_indexes_valid; }
+
+    /** Returns the existing objects owned by empire \a empire_id.  Only
+      * meaningful if ObjectIndexesValid(). */
+    const std::map<int, TemporaryPtr<UniverseObject> >& ExistingObjectsOwnedBy(int empire_id) const;
+
+    /** Returns the existing planets and ships of species \a species_name.
+      * Only meaningful if ObjectIndexesValid(). */
+    const std::map<int, TemporaryPtr<UniverseObject> >& ExistingObjectsOfSpecies(const std::string& species_name) const;
+
+    /** Returns the existing buildings of type \a building_type_name.  Only
+      * meaningful if ObjectIndexesValid(). */
+    const std::map<int, TemporaryPtr<UniverseObject> >& ExistingBuildingsOfType(const std::string& building_type_name) const;
+
     //@}
 
     /** \name Mutators */ //@{
@@ -364,6 +384,23 @@ public:
       * unchanged. */
     void                CopyObject(TemporaryPtr<const UniverseObject> source, int empire_id = ALL_EMPIRES);
 
+    /** Returns the object with id \a id, first replacing it in this map with
+      * a copy of itself if it is marked as shared (see MarkShared()), so that
+      * modifying the returned object doesn't change what other maps hold.
+      * \a empire_id is passed to Insert for the copy. */
+    TemporaryPtr<UniverseObject>    UnsharedObject(int id, int empire_id = ALL_EMPIRES);
+
+    /** Replaces the object with id \a id in this map with a full copy of
+      * itself, and returns the copy.  \a empire_id is passed to Insert for
+      * the copy. */
+    TemporaryPtr<UniverseObject>    CopiedObject(int id, int empire_id = ALL_EMPIRES);
+
+    /** Marks the object with id \a id in this map as also being held by
+      * another map, such as another empire's latest known objects, so that
+      * UnsharedObject copies it before it is modified.  The mark is removed
+      * when the object is copied, replaced or removed. */
+    void                MarkShared(int id);
+
     /** Adds object \a obj to the map under its ID, if it is a valid object.
       * If there already was an object in the map with the id \a id then
       * that object will be removed.  A TemporaryPtr to the new object is
@@ -396,13 +433,37 @@ public:
       * on what other objects exist in this ObjectMap. Useful to eliminate
       * cases where there are inconsistencies between whan an object thinks it
       * contains, and what other objects think they are contained by the first
-      * object. */
-    void                AuditContainment(const std::set<int>& destroyed_object_ids);
+      * object.  If \a copy_modified is true, objects whose contained objects
+      * change are first replaced with copies (see CopiedObject()), so that
+      * other maps that hold the same objects are neither modified nor read
+      * while they are modified.  Otherwise, only shared objects are copied
+      * (see UnsharedObject()).  \a empire_id is passed to Insert for the
+      * copies. */
+    void                AuditContainment(const std::set<int>& destroyed_object_ids, bool copy_modified = false,
+                                         int empire_id = ALL_EMPIRES);
+
+    /** Rebuilds the indexes of existing objects by owner, species and
+      * building type, if they are not up to date. */
+    void                UpdateObjectIndexes();
+
+    /** Marks the indexes of existing objects as outdated.  To be called when
+      * the owner or species of an object changes. */
+    void                InvalidateObjectIndexes();
     //@}
 
 private:
     void                Insert(boost::shared_ptr<UniverseObject> item, int empire_id = ALL_EMPIRES);
     void                CopyObjectsToSpecializedMaps();
+
+    /** Returns the object with id \a id, or a null pointer if there is none.
+      * Looks in m_objects_by_id first and only falls back to m_objects for
+      * ids that are not covered by it. */
+    const boost::shared_ptr<UniverseObject>&    ObjectPtr(int id) const;
+    /** Returns the object with id \a id if it is of type T. */
+    template <class T>
+    boost::shared_ptr<T>                        ObjectPtr(int id) const;
+    void                SetObjectByID(int id, const boost::shared_ptr<UniverseObject>& item);
+    void                RebuildObjectsByID();
     template <class T>
     const std::map<int, boost::shared_ptr<T> >& Map() const;
     template <class T>
@@ -436,6 +497,21 @@ private:
     std::map<int, TemporaryPtr<UniverseObject> >                m_existing_buildings;
     std::map<int, TemporaryPtr<UniverseObject> >                m_existing_fields;
 
+    /** Objects of m_objects indexed directly by their id.  Object ids are
+      * handed out sequentially, so this is densely populated and lookups by
+      * id don't need to walk m_objects.  Covers every object with an id in
+      * [0, m_objects_by_id.size()); objects with other ids are only found
+      * in m_objects. */
+    std::vector<boost::shared_ptr<UniverseObject> >             m_objects_by_id;
+
+    /** Ids of objects in this map that are also held by other maps. */
+    std::set<int>                                               m_shared_object_ids;
+
+    std::map<int, std::map<int, TemporaryPtr<UniverseObject> > >            m_existing_objects_by_owner;
+    std::map<std::string, std::map<int, TemporaryPtr<UniverseObject> > >    m_existing_objects_by_species;
+    std::map<std::string, std::map<int, TemporaryPtr<UniverseObject> > >    m_existing_buildings_by_type;
+    bool                                                        m_object_indexes_valid;
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -458,25 +534,12 @@ ObjectMap::const_iterator<T> ObjectMap::const_end() const
 { return const_iterator<T>(Map<typename boost::remove_const<T>::type>().end(), *this); }
 
 template <class T>
-TemporaryPtr<const T> ObjectMap::Object(int id) const {
-    typename std::map<int, boost::shared_ptr<typename boost::remove_const<T>::type> >::const_iterator it =
-        Map<typename boost::remove_const<T>::type>().find(id);
-    return TemporaryPtr<const T>(
-        it != Map<typename boost::remove_const<T>::type>().end()
-            ? it->second
-            : boost::shared_ptr<const T>());
-}
+TemporaryPtr<const T> ObjectMap::Object(int id) const
+{ return TemporaryPtr<const T>(ObjectPtr<typename boost::remove_const<T>::type>(id)); }
 
 template <class T>
-TemporaryPtr<T> ObjectMap::Object(int id) {
-    typename std::map<int, boost::shared_ptr<typename boost::remove_const<T>::type> >::iterator it =
-        Map<typename boost::remove_const<T>::type>().find(id);
-    return TemporaryPtr<T>(
-        it != Map<typename boost::remove_const<T>::type>().end()
-            ? it->second
-            : boost::shared_ptr<typename boost::remove_const<T>::type>()
-        );
-}
+TemporaryPtr<T> ObjectMap::Object(int id)
+{ return TemporaryPtr<T>(ObjectPtr<typename boost::remove_const<T>::type>(id)); }
 
 template <class T>
 std::vector<TemporaryPtr<const T> > ObjectMap::FindObjects() const {
@@ -507,11 +570,9 @@ std::vector<int> ObjectMap::FindObjectIDs() const {
 template <class T>
 std::vector<TemporaryPtr<const T> > ObjectMap::FindObjects(const std::vector<int>& object_ids) const {
     std::vector<TemporaryPtr<const T> > retval;
-    typedef typename boost::remove_const<T>::type mutableT;
     for (std::vector<int>::const_iterator it = object_ids.begin(); it != object_ids.end(); ++it) {
-        typename std::map<int, boost::shared_ptr<mutableT> >::const_iterator map_it = Map<mutableT>().find(*it);
-        if (map_it != Map<mutableT>().end())
-            retval.push_back(TemporaryPtr<const T>(map_it->second));
+        if (TemporaryPtr<const T> obj = Object<T>(*it))
+            retval.push_back(obj);
     }
     return retval;
 }
@@ -519,11 +580,9 @@ std::vector<TemporaryPtr<const T> > ObjectMap::FindObjects(const std::vector<int
 template <class T>
 std::vector<TemporaryPtr<const T> > ObjectMap::FindObjects(const std::set<int>& object_ids) const {
     std::vector<TemporaryPtr<const T> > retval;
-    typedef typename boost::remove_const<T>::type mutableT;
     for (std::set<int>::const_iterator it = object_ids.begin(); it != object_ids.end(); ++it) {
-        typename std::map<int, boost::shared_ptr<mutableT> >::const_iterator map_it = Map<mutableT>().find(*it);
-        if (map_it != Map<mutableT>().end())
-            retval.push_back(TemporaryPtr<const T>(map_it->second));
+        if (TemporaryPtr<const T> obj = Object<T>(*it))
+            retval.push_back(obj);
     }
     return retval;
 }
@@ -531,11 +590,9 @@ std::vector<TemporaryPtr<const T> > ObjectMap::FindObjects(const std::set<int>&
 template <class T>
 std::vector<TemporaryPtr<T> > ObjectMap::FindObjects(const std::vector<int>& object_ids) {
     std::vector<TemporaryPtr<T> > retval;
-    typedef typename boost::remove_const<T>::type mutableT;
     for (std::vector<int>::const_iterator it = object_ids.begin(); it != object_ids.end(); ++it) {
-        typename std::map<int, boost::shared_ptr<mutableT> >::const_iterator map_it = Map<mutableT>().find(*it);
-        if (map_it != Map<mutableT>().end())
-            retval.push_back(TemporaryPtr<T>(map_it->second));
+        if (TemporaryPtr<T> obj = Object<T>(*it))
+            retval.push_back(obj);
     }
     return retval;
 }
@@ -543,11 +600,9 @@ std::vector<TemporaryPtr<T> > ObjectMap::FindObjects(const std::vector<int>& obj
 template <class T>
 std::vector<TemporaryPtr<T> > ObjectMap::FindObjects(const std::set<int>& object_ids) {
     std::vector<TemporaryPtr<T> > retval;
-    typedef typename boost::remove_const<T>::type mutableT;
     for (std::set<int>::const_iterator it = object_ids.begin(); it != object_ids.end(); ++it) {
-        typename std::map<int, boost::shared_ptr<mutableT> >::const_iterator map_it = Map<mutableT>().find(*it);
-        if (map_it != Map<mutableT>().end())
-            retval.push_back(TemporaryPtr<T>(map_it->second));
+        if (TemporaryPtr<T> obj = Object<T>(*it))
+            retval.push_back(obj);
     }
     return retval;
 }
@@ -575,6 +630,33 @@ void ObjectMap::Insert(TemporaryPtr<T> item, int empire_id /* = ALL_EMPIRES */)
 
 // template specializations
 
+template <>
+boost::shared_ptr<UniverseObject>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<ResourceCenter>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<PopCenter>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<Ship>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<Fleet>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<Planet>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<System>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<Building>  ObjectMap::ObjectPtr(int id) const;
+
+template <>
+boost::shared_ptr<Field>  ObjectMap::ObjectPtr(int id) const;
+
 template <>
 const std::map<int, boost::shared_ptr<UniverseObject> >&  ObjectMap::Map() const;
 
@@ -535,6 +535,7 @@ void Planet::SetType(PlanetType type) {
     if (NUM_PLANET_TYPES <= type)
         type = PT_GASGIANT;
     m_type = type;
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_OTHER);
     StateChangedSignal();
 }
 
@@ -544,6 +545,7 @@ void Planet::SetSize(PlanetSize size) {
     if (NUM_PLANET_SIZES <= size)
         size = SZ_GASGIANT;
     m_size = size;
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_OTHER);
     StateChangedSignal();
 }
 
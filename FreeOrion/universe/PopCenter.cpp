@@ -3,7 +3,10 @@
 #include "../util/OptionsDB.h"
 #include "../util/Directories.h"
 #include "../util/Logger.h"
+#include "../util/AppInterface.h"
 #include "Meter.h"
+#include "Condition.h"
+#include "Universe.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -140,7 +143,10 @@ void PopCenter::Reset() {
     GetMeter(METER_TARGET_POPULATION)->Reset();
     GetMeter(METER_HAPPINESS)->Reset();
     GetMeter(METER_TARGET_HAPPINESS)->Reset();
-    m_species_name.clear();
+    if (!m_species_name.empty()) {
+        m_species_name.clear();
+        GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_SPECIES);
+    }
 }
 
 void PopCenter::Depopulate() {
@@ -154,4 +160,5 @@ void PopCenter::SetSpecies(const std::string& species_name) {
         Logger().errorStream() << "PopCenter::SetSpecies couldn't get species with name " << species_name;
     }
     m_species_name = species_name;
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_SPECIES);
 }
@@ -3,12 +3,15 @@
 #include "../util/Directories.h"
 #include "../util/Logger.h"
 #include "../util/OptionsDB.h"
+#include "../util/AppInterface.h"
 #include "../Empire/Empire.h"
+#include "Condition.h"
 #include "Fleet.h"
 #include "Planet.h"
 #include "ShipDesign.h"
 #include "System.h"
 #include "Building.h"
+#include "Universe.h"
 
 #include <stdexcept>
 
@@ -140,6 +143,7 @@ void ResourceCenter::SetFocus(const std::string& focus) {
             m_last_turn_focus_changed = m_last_turn_focus_changed_turn_initial;
         else
             m_last_turn_focus_changed = CurrentTurn();
+        GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_FOCUS);
         ResourceCenterChangedSignal();
         return;
     }
@@ -149,6 +153,7 @@ void ResourceCenter::SetFocus(const std::string& focus) {
 void ResourceCenter::ClearFocus() {
     m_focus.clear();
     m_last_turn_focus_changed = CurrentTurn();
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_FOCUS);
     ResourceCenterChangedSignal();
 }
 
@@ -186,7 +191,10 @@ void ResourceCenter::ResourceCenterClampMeters() {
 }
 
 void ResourceCenter::Reset() {
-    m_focus.clear();
+    if (!m_focus.empty()) {
+        m_focus.clear();
+        GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_FOCUS);
+    }
     m_last_turn_focus_changed = INVALID_GAME_TURN;
 
     GetMeter(METER_INDUSTRY)->Reset();
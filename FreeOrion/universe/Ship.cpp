@@ -8,6 +8,7 @@
 #include "Predicates.h"
 #include "ShipDesign.h"
 #include "Species.h"
+#include "Condition.h"
 #include "Universe.h"
 #include "../Empire/Empire.h"
 #include "../Empire/EmpireManager.h"
@@ -72,13 +73,14 @@ Ship::Ship(int empire_id, int design_id, const std::string& species_name,
                 Logger().errorStream() << "Ship::Ship couldn't get part with name " << part_names[i];
                 continue;
             }
+            int part_name_id = PartNameID(part->Name());
 
             switch (part->Class()) {
             case PC_SHORT_RANGE:
             case PC_POINT_DEFENSE: {
-                m_part_meters[std::make_pair(METER_DAMAGE,              part->Name())];
-                m_part_meters[std::make_pair(METER_ROF,                 part->Name())];
-                m_part_meters[std::make_pair(METER_RANGE,               part->Name())];
+                m_part_meters.Add(METER_DAMAGE,              part_name_id);
+                m_part_meters.Add(METER_ROF,                 part_name_id);
+                m_part_meters.Add(METER_RANGE,               part_name_id);
                 break;
             }
             case PC_MISSILES: {
@@ -86,13 +88,13 @@ Ship::Ship(int empire_id, int design_id, const std::string& species_name,
                     m_missiles[part_names[i]];
                 ++part_missiles.first;
                 part_missiles.second += boost::get<LRStats>(part->Stats()).m_capacity;
-                m_part_meters[std::make_pair(METER_DAMAGE,              part->Name())];
-                m_part_meters[std::make_pair(METER_ROF,                 part->Name())];
-                m_part_meters[std::make_pair(METER_RANGE,               part->Name())];
-                m_part_meters[std::make_pair(METER_SPEED,               part->Name())];
-                m_part_meters[std::make_pair(METER_STEALTH,             part->Name())];
-                m_part_meters[std::make_pair(METER_STRUCTURE,           part->Name())];
-                m_part_meters[std::make_pair(METER_CAPACITY,            part->Name())];
+                m_part_meters.Add(METER_DAMAGE,              part_name_id);
+                m_part_meters.Add(METER_ROF,                 part_name_id);
+                m_part_meters.Add(METER_RANGE,               part_name_id);
+                m_part_meters.Add(METER_SPEED,               part_name_id);
+                m_part_meters.Add(METER_STEALTH,             part_name_id);
+                m_part_meters.Add(METER_STRUCTURE,           part_name_id);
+                m_part_meters.Add(METER_CAPACITY,            part_name_id);
                 break;
             }
             case PC_FIGHTERS: {
@@ -100,15 +102,15 @@ Ship::Ship(int empire_id, int design_id, const std::string& species_name,
                     m_fighters[part_names[i]];
                 ++part_fighters.first;
                 part_fighters.second += boost::get<FighterStats>(part->Stats()).m_capacity;
-                m_part_meters[std::make_pair(METER_ANTI_SHIP_DAMAGE,    part->Name())];
-                m_part_meters[std::make_pair(METER_ANTI_FIGHTER_DAMAGE, part->Name())];
-                m_part_meters[std::make_pair(METER_LAUNCH_RATE,         part->Name())];
-                m_part_meters[std::make_pair(METER_FIGHTER_WEAPON_RANGE,part->Name())];
-                m_part_meters[std::make_pair(METER_SPEED,               part->Name())];
-                m_part_meters[std::make_pair(METER_STEALTH,             part->Name())];
-                m_part_meters[std::make_pair(METER_STRUCTURE,           part->Name())];
-                m_part_meters[std::make_pair(METER_DETECTION,           part->Name())];
-                m_part_meters[std::make_pair(METER_CAPACITY,            part->Name())];
+                m_part_meters.Add(METER_ANTI_SHIP_DAMAGE,    part_name_id);
+                m_part_meters.Add(METER_ANTI_FIGHTER_DAMAGE, part_name_id);
+                m_part_meters.Add(METER_LAUNCH_RATE,         part_name_id);
+                m_part_meters.Add(METER_FIGHTER_WEAPON_RANGE,part_name_id);
+                m_part_meters.Add(METER_SPEED,               part_name_id);
+                m_part_meters.Add(METER_STEALTH,             part_name_id);
+                m_part_meters.Add(METER_STRUCTURE,           part_name_id);
+                m_part_meters.Add(METER_DETECTION,           part_name_id);
+                m_part_meters.Add(METER_CAPACITY,            part_name_id);
                 break;
             }
             default:
@@ -159,9 +161,7 @@ void Ship::Copy(TemporaryPtr<const UniverseObject> copied_object, int empire_id)
             this->m_design_id =             copied_ship->m_design_id;
             this->m_fighters =              copied_ship->m_fighters;
             this->m_missiles =              copied_ship->m_missiles;
-            for (PartMeterMap::const_iterator it = copied_ship->m_part_meters.begin();
-                 it != copied_ship->m_part_meters.end(); ++it)
-            { this->m_part_meters[it->first]; }
+            this->m_part_meters.AddMissing(copied_ship->m_part_meters);
             this->m_species_name =          copied_ship->m_species_name;
 
             if (vis >= VIS_FULL_VISIBILITY) {
@@ -260,7 +260,7 @@ std::string Ship::Dump() const {
     //typedef std::map<std::pair<MeterType, std::string>, Meter> PartMeters;
     os << " part meters: ";
     for (PartMeterMap::const_iterator it = m_part_meters.begin(); it != m_part_meters.end();) {
-        const std::string part_name = it->first.second;
+        const std::string part_name = PartNameFromID(it->first.second);
         MeterType meter_type = it->first.first;
         const Meter& meter = it->second;
         ++it;
@@ -398,13 +398,8 @@ float Ship::NextTurnCurrentMeterValue(MeterType type) const {
 const Meter* Ship::GetPartMeter(MeterType type, const std::string& part_name) const
 { return const_cast<Ship*>(this)->GetPartMeter(type, part_name); }
 
-Meter* Ship::GetPartMeter(MeterType type, const std::string& part_name) {
-    Meter* retval = 0;
-    PartMeterMap::iterator it = m_part_meters.find(std::make_pair(type, part_name));
-    if (it != m_part_meters.end())
-        retval = &it->second;
-    return retval;
-}
+Meter* Ship::GetPartMeter(MeterType type, const std::string& part_name)
+{ return m_part_meters.Get(type, part_name); }
 
 float Ship::CurrentPartMeterValue(MeterType type, const std::string& part_name) const {
     if (const Meter* meter = GetPartMeter(type, part_name))
@@ -518,6 +513,7 @@ void Ship::SetSpecies(const std::string& species_name) {
     if (!GetSpecies(species_name))
         Logger().errorStream() << "Ship::SetSpecies couldn't get species with name " << species_name;
     m_species_name = species_name;
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_SPECIES);
 }
 
 void Ship::SetOrderedScrapped(bool b) {
@@ -16,8 +16,6 @@ public:
     // number of fighters (or missiles) available of that type) pairs
     typedef std::map<std::string, std::pair<std::size_t, std::size_t> > ConsumablesMap;
 
-    typedef std::map<std::pair<MeterType, std::string>, Meter>          PartMeterMap;
-
     /** \name Accessors */ //@{
     virtual std::set<std::string>
                                 Tags() const;                                       ///< returns all tags this object has
@@ -756,6 +756,7 @@ void PartType::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_stats)
         & BOOST_SERIALIZATION_NVP(m_production_cost)
         & BOOST_SERIALIZATION_NVP(m_production_time)
+        & BOOST_SERIALIZATION_NVP(m_producible)
         & BOOST_SERIALIZATION_NVP(m_mountable_slot_types)
         & BOOST_SERIALIZATION_NVP(m_tags)
         & BOOST_SERIALIZATION_NVP(m_location)
@@ -775,6 +776,7 @@ void HullType::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_structure)
         & BOOST_SERIALIZATION_NVP(m_production_cost)
         & BOOST_SERIALIZATION_NVP(m_production_time)
+        & BOOST_SERIALIZATION_NVP(m_producible)
         & BOOST_SERIALIZATION_NVP(m_slots)
         & BOOST_SERIALIZATION_NVP(m_tags)
         & BOOST_SERIALIZATION_NVP(m_location)
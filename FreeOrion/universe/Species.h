@@ -55,6 +55,10 @@ private:
     std::string                                         m_description;
     boost::shared_ptr<const Condition::ConditionBase>   m_location;
     std::string                                         m_graphic;
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
 };
 
 /** Used by parser due to limits on number of sub-items per parsed main item. */
@@ -145,6 +149,13 @@ public:
     //@}
 
 private:
+    Species() :
+        m_playable(false),
+        m_native(false),
+        m_can_colonize(false),
+        m_can_produce_ships(false)
+    {}
+
     std::string                             m_name;
     std::string                             m_description;
     std::string                             m_gameplay_description;
@@ -165,6 +176,10 @@ private:
     bool                                    m_can_produce_ships;
     std::set<std::string>                   m_tags;
     std::string                             m_graphic;
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
 };
 
 
@@ -5,6 +5,7 @@
 #include "Planet.h"
 #include "Building.h"
 #include "Predicates.h"
+#include "Condition.h"
 #include "Universe.h"
 
 #include "../Empire/Empire.h"
@@ -438,6 +439,7 @@ void System::SetStarType(StarType type) {
     m_star = type;
     if (m_star <= INVALID_STAR_TYPE || NUM_STAR_TYPES <= m_star)
         Logger().errorStream() << "System::SetStarType set star type to " << boost::lexical_cast<std::string>(type);
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_OTHER);
     StateChangedSignal();
 }
 
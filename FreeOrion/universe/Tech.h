@@ -8,6 +8,7 @@
 #include "../util/Export.h"
 
 #include <boost/multi_index_container.hpp>
+#include <boost/serialization/access.hpp>
 #include <boost/multi_index/key_extractors.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 
@@ -120,6 +121,11 @@ public:
     //@}
 
 private:
+    Tech() :
+        m_research_cost(0),
+        m_research_turns(0),
+        m_researchable(false)
+    {}
     Tech(const Tech&);                  // disabled
     const Tech& operator=(const Tech&); // disabled
 
@@ -139,6 +145,10 @@ private:
     std::set<std::string>                   m_unlocked_techs;
 
     friend class TechManager;
+
+    friend class boost::serialization::access;
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version);
 };
 
 
@@ -27,10 +27,6 @@ public:
     TemporaryPtr() : m_ptr()
     {}
 
-    /* NOTE: pointer assignment can block the current thread until other 
-     * manipulations of the refcounting base, like TemporaryFromThis(), have 
-     * completed.
-     */
     template<class Y>
     TemporaryPtr(const TemporaryPtr<Y>& rhs) :
         m_ptr()
@@ -5,11 +5,8 @@
 #include "TemporaryPtr.h"
 #include <boost/mpl/assert.hpp>
 #include <boost/pointer_cast.hpp>
-#include <boost/thread/locks.hpp>
-#include <boost/thread/mutex.hpp>
 #include <boost/type_traits/is_convertible.hpp>
 #include <boost/type_traits/remove_const.hpp>
-#include <algorithm>
 
 template<class T>
 T* TemporaryPtr<T>::get() const 
@@ -19,32 +16,15 @@ template<class T> template <class P>
 TemporaryPtr<T>& TemporaryPtr<T>::internal_assign(const P& rhs) {
     BOOST_MPL_ASSERT((boost::is_convertible<typename P::element_type*, T*>));
     BOOST_MPL_ASSERT((boost::is_convertible<T*, const typename T::enable_temporary_from_this_type*>));
-    T*                        our_raw = get();
-    typename P::element_type* rhs_raw = rhs.get();
-    if (our_raw != rhs_raw) {
-        /* What is secured here is neither the target object, nor the pointer itself.
-         * What we absolutely need to synchronize is accessing and updating the 
-         * reference counting base of m_ptr, which is shared between all pointers to
-         * the same object (this is an internal structure of boost::shared_ptr and
-         * boost::weak_ptr). If you need synchronization of the pointer value or the
-         * target object, this is outside the scope of TemporaryPtr.
-         *
-         * Because we have to acquire two mutexes, we do so in order of their address
-         * value. This prevents deadlocks between concurrent pointer assigments, but
-         * it does not prevent other deadlocks. Keep in mind that pointer assignment
-         * can block the current thread until other manipulations of the refcounting
-         * base, like TemporaryFromThis(), have completed.
-         */
-        boost::mutex sentinel1, sentinel2;
-        boost::mutex* mutex_in_owned_object = our_raw? &( our_raw->m_ptr_mutex ) : &sentinel1;
-        boost::mutex* mutex_in_other_object = rhs_raw? &( rhs_raw->m_ptr_mutex ) : &sentinel2;
-        boost::mutex* mutex1 = (std::min)(mutex_in_owned_object, mutex_in_other_object);
-        boost::mutex* mutex2 = (std::max)(mutex_in_owned_object, mutex_in_other_object);
-        boost::unique_lock<boost::mutex> guard1(*mutex1);
-        boost::unique_lock<boost::mutex> guard2(*mutex2);
-
-        m_ptr = rhs; // both refcounting_bases are modified!
-    }
+    /* The reference counting base of m_ptr is shared between all pointers to
+     * the same object.  boost::shared_ptr and boost::weak_ptr already update it
+     * atomically, so assignment needs no locking of its own; this keeps copying
+     * and converting pointers in large object sets cheap.  If you need
+     * synchronization of the pointer value or the target object, this is
+     * outside the scope of TemporaryPtr.
+     */
+    if (get() != rhs.get())
+        m_ptr = rhs;
     return *this;
 }
 
@@ -31,7 +31,6 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/breadth_first_search.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/filtered_graph.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/optional/optional.hpp>
@@ -39,12 +38,14 @@
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include <boost/timer.hpp>
 
 #include <algorithm>
 #include <cmath>
 #include <list>
+#include <queue>
 #include <stdexcept>
 
 
@@ -54,6 +55,8 @@ namespace {
     void AddOptions(OptionsDB& db) {
         db.Add("verbose-logging",   UserStringNop("OPTIONS_DB_VERBOSE_LOGGING_DESC"),   false,  Validator<bool>());
         db.Add("effects-threads",   UserStringNop("OPTIONS_DB_EFFECTS_THREADS_DESC"),   8,      RangedValidator<int>(1, 32));
+        db.Add("jump-table-precompute-max-systems", UserStringNop("OPTIONS_DB_JUMP_TABLE_PRECOMPUTE_MAX_SYSTEMS_DESC"), 3000, RangedValidator<int>(0, 100000));
+        db.Add("jump-table-threads", UserStringNop("OPTIONS_DB_JUMP_TABLE_THREADS_DESC"), 4, RangedValidator<int>(1, 32));
     }
     bool temp_bool = RegisterOptions(&AddOptions);
 
@@ -74,25 +77,6 @@ namespace boost {
 }
 
 namespace SystemPathing {
-    /** Used to short-circuit the use of BFS (breadth-first search) or
-      * Dijkstra's algorithm for pathfinding when it finds the desired
-      * destination system. */
-    struct PathFindingShortCircuitingVisitor : public boost::base_visitor<PathFindingShortCircuitingVisitor>
-    {
-        typedef boost::on_finish_vertex event_filter;
-
-        struct FoundDestination {}; // exception type thrown when destination is found
-
-        PathFindingShortCircuitingVisitor(int dest_system) : destination_system(dest_system) {}
-        template <class Vertex, class Graph>
-        void operator()(Vertex u, Graph& g)
-        {
-            if (static_cast<int>(u) == destination_system)
-                throw FoundDestination();
-        }
-        const int destination_system;
-    };
-
     /** Complete BFS visitor implementing:
       *  - predecessor recording
       *  - short-circuit exit on found match
@@ -163,23 +147,134 @@ namespace SystemPathing {
     ////////////////////////////////////////////////////////////////
     struct vertex_system_id_t {typedef boost::vertex_property_tag kind;}; ///< a system graph property map type
 
-    /** Returns the path between vertices \a system1_id and \a system2_id of
-      * \a graph that travels the shorest distance on starlanes, and the path
-      * length.  If system1_id is the same vertex as system2_id, the path has
-      * just that system in it, and the path lenth is 0.  If there is no path
-      * between the two vertices, then the list is empty and the path length
-      * is -1.0 */
+    /** The starlanes of a system graph, or of an empire's view of one, stored
+      * as contiguous arrays: the lanes out of the system at graph index i are
+      * lane_targets and lane_lengths at [first_lane[i], first_lane[i + 1]).
+      * Searching these doesn't need to evaluate a graph filter for each edge
+      * that is visited, as searching a boost::filtered_graph does. */
+    struct SystemAdjacency {
+        SystemAdjacency() :
+            heuristic_scale(1.0),
+            shortcut_length(0.0)
+        {}
+
+        std::vector<size_t> first_lane;
+        std::vector<size_t> lane_targets;
+        std::vector<double> lane_lengths;
+
+        /** Largest factor by which the straight-line distance between two
+          * systems can be multiplied and not exceed the length of any path
+          * between them that doesn't use a shortcut.  Shortcuts are lanes
+          * less than half as long as the distance between the systems they
+          * connect, such as wormholes. */
+        double              heuristic_scale;
+
+        /** Graph indices of the systems at either end of a shortcut, without
+          * duplicates, and the length of the shortest shortcut. */
+        std::vector<size_t> shortcut_ends;
+        double              shortcut_length;
+    };
+
+    /** Lanes less than this fraction of the distance between the systems they
+      * connect are shortcuts, which the A* heuristic treats separately. */
+    const double SHORTCUT_LENGTH_FRACTION = 0.5;
+
+    /** Fills \a adjacency with the edges of \a graph.  \a positions are the
+      * positions of the systems, indexed like the vertices of \a graph. */
     template <class Graph>
-    std::pair<std::list<int>, double> ShortestPathImpl(const Graph& graph, int system1_id, int system2_id,
-                                                       double linear_distance, const boost::unordered_map<int, size_t>& id_to_graph_index)
+    void BuildSystemAdjacency(const Graph& graph, const std::vector<std::pair<double, double> >& positions,
+                              SystemAdjacency& adjacency)
     {
-        typedef typename boost::property_map<Graph, vertex_system_id_t>::const_type     ConstSystemIDPropertyMap;
-        typedef typename boost::property_map<Graph, boost::vertex_index_t>::const_type  ConstIndexPropertyMap;
+        typedef typename boost::graph_traits<Graph>::out_edge_iterator                  OutEdgeIterator;
         typedef typename boost::property_map<Graph, boost::edge_weight_t>::const_type   ConstEdgeWeightPropertyMap;
 
-        std::pair<std::list<int>, double> retval(std::list<int>(), -1.0);
+        ConstEdgeWeightPropertyMap edge_weight_map = boost::get(boost::edge_weight, graph);
+        const size_t num_systems = boost::num_vertices(graph);
+
+        adjacency = SystemAdjacency();
+        adjacency.first_lane.reserve(num_systems + 1);
+        for (size_t system_index = 0; system_index < num_systems; ++system_index) {
+            adjacency.first_lane.push_back(adjacency.lane_targets.size());
+            OutEdgeIterator edge_it, edge_end;
+            for (boost::tie(edge_it, edge_end) = boost::out_edges(system_index, graph); edge_it != edge_end; ++edge_it) {
+                size_t lane_dest_index = boost::target(*edge_it, graph);
+                double lane_length = edge_weight_map[*edge_it];
+                adjacency.lane_targets.push_back(lane_dest_index);
+                adjacency.lane_lengths.push_back(lane_length);
+
+                if (system_index >= positions.size() || lane_dest_index >= positions.size())
+                    continue;
+                double x_dist = positions[lane_dest_index].first - positions[system_index].first;
+                double y_dist = positions[lane_dest_index].second - positions[system_index].second;
+                double linear_distance = std::sqrt(x_dist*x_dist + y_dist*y_dist);
+                if (lane_length < SHORTCUT_LENGTH_FRACTION * linear_distance) {
+                    if (adjacency.shortcut_ends.empty() || lane_length < adjacency.shortcut_length)
+                        adjacency.shortcut_length = lane_length;
+                    adjacency.shortcut_ends.push_back(system_index);
+                    adjacency.shortcut_ends.push_back(lane_dest_index);
+                } else if (lane_length < adjacency.heuristic_scale * linear_distance) {
+                    adjacency.heuristic_scale = lane_length / linear_distance;
+                }
+            }
+        }
+        adjacency.first_lane.push_back(adjacency.lane_targets.size());
 
-        ConstSystemIDPropertyMap sys_id_property_map = boost::get(vertex_system_id_t(), graph);
+        std::sort(adjacency.shortcut_ends.begin(), adjacency.shortcut_ends.end());
+        adjacency.shortcut_ends.erase(std::unique(adjacency.shortcut_ends.begin(), adjacency.shortcut_ends.end()),
+                                      adjacency.shortcut_ends.end());
+    }
+
+    /** Estimates the length of the shortest path between the systems at
+      * \a position and \a dest, without ever overestimating it.  A path that
+      * uses no shortcut is at least as long as the scaled straight-line
+      * distance.  A path that uses shortcuts is at least as long as the scaled
+      * distance to its first shortcut, plus a shortcut, plus the scaled
+      * distance from its last shortcut, which is at least
+      * \a dest_to_shortcut.  The estimate is also consistent, so A* doesn't
+      * need to search a system more than once. */
+    double ShortestPathHeuristic(const SystemAdjacency& adjacency,
+                                 const std::vector<std::pair<double, double> >& positions,
+                                 const std::pair<double, double>& position, const std::pair<double, double>& dest,
+                                 double dest_to_shortcut)
+    {
+        double x_dist = dest.first - position.first;
+        double y_dist = dest.second - position.second;
+        double estimate = std::sqrt(x_dist*x_dist + y_dist*y_dist);
+        if (adjacency.shortcut_ends.empty())
+            return adjacency.heuristic_scale * estimate;
+
+        double to_shortcut = estimate;
+        for (std::vector<size_t>::const_iterator it = adjacency.shortcut_ends.begin();
+             it != adjacency.shortcut_ends.end() && to_shortcut > 0.0; ++it)
+        {
+            x_dist = positions[*it].first - position.first;
+            y_dist = positions[*it].second - position.second;
+            to_shortcut = std::min(to_shortcut, std::sqrt(x_dist*x_dist + y_dist*y_dist));
+        }
+        return std::min(adjacency.heuristic_scale * estimate,
+                        adjacency.heuristic_scale * (to_shortcut + dest_to_shortcut) + adjacency.shortcut_length);
+    }
+
+    /** Returns the path between vertices \a system1_id and \a system2_id of
+      * the graph with lanes \a adjacency that travels the shorest distance on
+      * starlanes, and the path length.  If system1_id is the same vertex as
+      * system2_id, the path has just that system in it, and the path lenth is
+      * 0.  If there is no path between the two vertices, then the list is
+      * empty and the path length is -1.0
+      *
+      * This is an A* search, which is guided towards system2_id by the
+      * straight-line distance to it, allowing for shortcuts so that it never
+      * overestimates the remaining path length (see ShortestPathHeuristic).
+      * \a positions and \a graph_index_to_id are the positions and ids of the
+      * systems, indexed like the graph. */
+    std::pair<std::list<int>, double> ShortestPathImpl(const SystemAdjacency& adjacency,
+                                                       const std::vector<std::pair<double, double> >& positions,
+                                                       const std::vector<int>& graph_index_to_id,
+                                                       int system1_id, int system2_id,
+                                                       const boost::unordered_map<int, size_t>& id_to_graph_index)
+    {
+        std::pair<std::list<int>, double> retval(std::list<int>(), -1.0);
+        const size_t num_systems = graph_index_to_id.size();
 
         // convert system IDs to graph indices.  try/catch for invalid input system ids.
         size_t system1_index, system2_index;
@@ -189,6 +284,9 @@ namespace SystemPathing {
         } catch (...) {
             return retval;
         }
+        if (system1_index >= num_systems || system2_index >= num_systems ||
+            positions.size() != num_systems || adjacency.first_lane.size() != num_systems + 1)
+        { return retval; }
 
         // early exit if systems are the same
         if (system1_id == system2_id) {
@@ -197,52 +295,134 @@ namespace SystemPathing {
             return retval;
         }
 
-        /* initializing all vertices' predecessors to themselves prevents endless loops when back traversing the tree in the case where
-           one of the end systems is system 0, because systems that are not connected to the root system (system2) are not visited
-           by the search, and so their predecessors are left unchanged.  Default initialization of the vector may be 0 or undefined
-           which could lead to out of bounds errors, or endless loops if a system's default predecessor is 0 (debug mode), and 0's
-           predecessor is that system */
-        std::vector<int> predecessors(boost::num_vertices(graph));
-        std::vector<double> distances(boost::num_vertices(graph));
-        for (unsigned int i = 0; i < boost::num_vertices(graph); ++i) {
-            predecessors[i] = i;
-            distances[i] = -1.0;
+        const std::pair<double, double>& dest = positions[system2_index];
+
+        // straight-line distance from the destination to the nearest shortcut
+        double dest_to_shortcut = 0.0;
+        for (std::vector<size_t>::const_iterator it = adjacency.shortcut_ends.begin();
+             it != adjacency.shortcut_ends.end(); ++it)
+        {
+            double x_dist = positions[*it].first - dest.first;
+            double y_dist = positions[*it].second - dest.second;
+            double distance = std::sqrt(x_dist*x_dist + y_dist*y_dist);
+            if (it == adjacency.shortcut_ends.begin() || distance < dest_to_shortcut)
+                dest_to_shortcut = distance;
         }
 
+        // unvisited systems are their own predecessors, and have distance -1
+        std::vector<size_t> predecessors(num_systems);
+        std::vector<double> distances(num_systems, -1.0);
+        std::vector<bool> finished(num_systems, false);
+        for (size_t i = 0; i < num_systems; ++i)
+            predecessors[i] = i;
 
-        ConstIndexPropertyMap index_map = boost::get(boost::vertex_index, graph);
-        ConstEdgeWeightPropertyMap edge_weight_map = boost::get(boost::edge_weight, graph);
+        // queue of (estimated total path length, system index).  systems may be
+        // queued more than once, and later, longer entries are skipped
+        typedef std::pair<double, size_t> QueueEntry;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+        distances[system1_index] = 0.0;
+        queue.push(QueueEntry(0.0, system1_index));
+
+        while (!queue.empty()) {
+            size_t system_index = queue.top().second;
+            queue.pop();
+            if (finished[system_index])
+                continue;
+            finished[system_index] = true;
+            if (system_index == system2_index)
+                break;
 
+            for (size_t lane = adjacency.first_lane[system_index]; lane < adjacency.first_lane[system_index + 1]; ++lane) {
+                size_t lane_dest_index = adjacency.lane_targets[lane];
+                if (finished[lane_dest_index])
+                    continue;
+                double distance = distances[system_index] + adjacency.lane_lengths[lane];
+                if (distances[lane_dest_index] >= 0.0 && distances[lane_dest_index] <= distance)
+                    continue;
+                distances[lane_dest_index] = distance;
+                predecessors[lane_dest_index] = system_index;
 
-        // do the actual path finding using verbose boost magic...
-        try {
-            boost::dijkstra_shortest_paths(graph, system1_index, &predecessors[0], &distances[0], edge_weight_map, index_map, 
-                                           std::less<double>(), std::plus<double>(), std::numeric_limits<int>::max(), 0, 
-                                           boost::make_dijkstra_visitor(PathFindingShortCircuitingVisitor(system2_index)));
-        } catch (const PathFindingShortCircuitingVisitor::FoundDestination&) {
-            // catching this just means that the destination was found, and so the algorithm was exited early, via exception
+                double estimate = distance + ShortestPathHeuristic(adjacency, positions, positions[lane_dest_index],
+                                                                   dest, dest_to_shortcut);
+                queue.push(QueueEntry(estimate, lane_dest_index));
+            }
         }
 
+        if (!finished[system2_index])
+            return retval;  // there is no path between the specified nodes
 
-        int current_system = system2_index;
-        while (predecessors[current_system] != current_system) {
-            retval.first.push_front(sys_id_property_map[current_system]);
-            current_system = predecessors[current_system];
-        }
+        for (size_t current_system = system2_index; current_system != system1_index; current_system = predecessors[current_system])
+            retval.first.push_front(graph_index_to_id[current_system]);
+        retval.first.push_front(graph_index_to_id[system1_index]);
         retval.second = distances[system2_index];
 
-        if (retval.first.empty()) {
-            // there is no path between the specified nodes
-            retval.second = -1.0;
-            return retval;
-        } else {
-            // add start system to path, as it wasn't added by traversing predecessors array
-            retval.first.push_front(sys_id_property_map[system1_index]);
-        }
-
         return retval;
     }
 
+    /** Least recently used cache of the results of ShortestPath, by empire
+      * id and start and end system ids.  Safe to use from several threads.
+      * Results are only valid while the system graphs don't change, so the
+      * cache is cleared whenever they are regenerated, which happens at least
+      * once per turn. */
+    class ShortestPathCache {
+    public:
+        typedef std::pair<int, std::pair<int, int> >   Key;
+        typedef std::pair<std::list<int>, double>       Path;
+
+        ShortestPathCache() :
+            m_hits(0),
+            m_misses(0)
+        {}
+
+        /** Sets \a path to the cached path for \a key and returns true, or
+          * returns false if there is none. */
+        bool    Get(const Key& key, Path& path) {
+            boost::mutex::scoped_lock lock(m_mutex);
+            std::map<Key, Entries::iterator>::iterator it = m_index.find(key);
+            if (it == m_index.end()) {
+                ++m_misses;
+                return false;
+            }
+            ++m_hits;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            path = it->second->second;
+            return true;
+        }
+
+        void    Put(const Key& key, const Path& path) {
+            boost::mutex::scoped_lock lock(m_mutex);
+            if (m_index.find(key) != m_index.end())
+                return;
+            m_entries.push_front(std::make_pair(key, path));
+            m_index[key] = m_entries.begin();
+            if (m_entries.size() > CAPACITY) {
+                m_index.erase(m_entries.back().first);
+                m_entries.pop_back();
+            }
+        }
+
+        void    Clear() {
+            boost::mutex::scoped_lock lock(m_mutex);
+            if (m_hits || m_misses)
+                Logger().debugStream() << "ShortestPathCache: " << m_hits << " hits and " << m_misses << " misses since last cleared";
+            m_entries.clear();
+            m_index.clear();
+            m_hits = 0;
+            m_misses = 0;
+        }
+
+    private:
+        typedef std::list<std::pair<Key, Path> > Entries;   ///< most recently used first
+
+        static const size_t CAPACITY = 8192;
+
+        Entries                             m_entries;
+        std::map<Key, Entries::iterator>    m_index;
+        unsigned int                        m_hits;
+        unsigned int                        m_misses;
+        boost::mutex                        m_mutex;
+    };
+
     /** Returns the path between vertices \a system1_id and \a system2_id of
       * \a graph that takes the fewest number of jumps (edge traversals), and
       * the number of jumps this path takes.  If system1_id is the same vertex
@@ -409,8 +589,16 @@ struct Universe::GraphImpl {
     typedef boost::property_map<SystemGraph, boost::edge_weight_t>::const_type      ConstEdgeWeightPropertyMap;
     typedef boost::property_map<SystemGraph, boost::edge_weight_t>::type            EdgeWeightPropertyMap;
 
+    typedef std::map<int, boost::shared_ptr<const SystemAdjacency> > EmpireSystemAdjacencyMap;
+
     SystemGraph                 system_graph;                 ///< a graph in which the systems are vertices and the starlanes are edges
     EmpireViewSystemGraphMap    empire_system_graph_views;    ///< a map of empire IDs to the views of the system graph by those empires
+    std::vector<int>            system_ids;                   ///< ids of the systems, indexed like the vertices of system_graph
+    std::vector<std::pair<double, double> >
+                                system_positions;             ///< positions of the systems, indexed like the vertices of system_graph
+    SystemAdjacency             system_adjacency;             ///< the edges of system_graph, for ShortestPath
+    EmpireSystemAdjacencyMap    empire_system_adjacencies;    ///< a map of empire IDs to the edges of the views of the system graph by those empires
+    ShortestPathCache           shortest_path_cache;
 };
 
 
@@ -430,10 +618,13 @@ Universe::Universe() :
     m_graph_impl(new GraphImpl),
     m_last_allocated_object_id(-1), // this is conicidentally equal to INVALID_OBJECT_ID as of this writing, but the reason for this to be -1 is so that the first object has id 0, and all object ids are non-negative
     m_last_allocated_design_id(-1), // same, but for ShipDesign::INVALID_DESIGN_ID
+    m_effects_targets_cache_valid(false),
+    m_effects_targets_cache_changes(Condition::DEPENDS_ON_NOTHING),
     m_universe_width(1000.0),
     m_inhibit_universe_object_signals(false),
-    m_encoding_empire(ALL_EMPIRES),
-    m_all_objects_visible(false)
+    m_encoding_empire(),
+    m_all_objects_visible(false),
+    m_precompute_system_jumps(false)
 {}
 
 Universe::~Universe() {
@@ -454,14 +645,15 @@ void Universe::Clear() {
 
     m_destroyed_object_ids.clear();
 
-    m_empire_object_visibility.clear();
-    m_empire_object_visibility_turns.clear();
+    m_empire_object_visibility.Clear();
+    m_empire_object_visibility_turns.Clear();
 
     m_empire_object_visible_specials.clear();
 
     m_system_id_to_graph_index.clear();
     m_effect_accounting_map.clear();
     m_effect_discrepancy_map.clear();
+    InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
 
     m_last_allocated_object_id = -1;
     m_last_allocated_design_id = -1;
@@ -592,33 +784,11 @@ Visibility Universe::GetObjectVisibilityByEmpire(int object_id, int empire_id) c
     if (empire_id == ALL_EMPIRES || GetUniverse().AllObjectsVisible())
         return VIS_FULL_VISIBILITY;
 
-    EmpireObjectVisibilityMap::const_iterator empire_it = m_empire_object_visibility.find(empire_id);
-    if (empire_it == m_empire_object_visibility.end())
-        return VIS_NO_VISIBILITY;
-
-    const ObjectVisibilityMap& vis_map = empire_it->second;
-
-    ObjectVisibilityMap::const_iterator vis_map_it = vis_map.find(object_id);
-    if (vis_map_it == vis_map.end())
-        return VIS_NO_VISIBILITY;
-
-    return vis_map_it->second;
+    return m_empire_object_visibility.Get(empire_id, object_id);
 }
 
-const Universe::VisibilityTurnMap& Universe::GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const {
-    static const std::map<Visibility, int> empty_map;
-
-    EmpireObjectVisibilityTurnMap::const_iterator empire_it = m_empire_object_visibility_turns.find(empire_id);
-    if (empire_it == m_empire_object_visibility_turns.end())
-        return empty_map;
-
-    const ObjectVisibilityTurnMap& obj_vis_turn_map = empire_it->second;
-    ObjectVisibilityTurnMap::const_iterator object_it = obj_vis_turn_map.find(object_id);
-    if (object_it == obj_vis_turn_map.end())
-        return empty_map;
-
-    return object_it->second;
-}
+Universe::VisibilityTurnMap Universe::GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const
+{ return m_empire_object_visibility_turns.Get(empire_id, object_id); }
 
 std::set<std::string> Universe::GetObjectVisibleSpecialsByEmpire(int object_id, int empire_id) const {
     if (empire_id != ALL_EMPIRES) {
@@ -749,6 +919,45 @@ namespace {
     private:
         Storage& m_storage;
     };
+
+    /** Sets \a row to the number of starlane jumps from the system at index
+      * \a system_index in \a graph to each system, or SHRT_MAX for systems
+      * that can't be reached. */
+    template <class Graph>
+    void FillSystemJumpsRow(const Graph& graph, size_t system_index, std::vector<short>& row) {
+        typedef boost::iterator_property_map<std::vector<short>::iterator, boost::identity_property_map> DistancePropertyMap;
+
+        row.assign(boost::num_vertices(graph), SHRT_MAX);
+        DistancePropertyMap distance_property_map(row.begin());
+        boost::distance_recorder<DistancePropertyMap, boost::on_tree_edge> distance_recorder(distance_property_map);
+
+        row[system_index] = 0;
+        boost::breadth_first_search(graph, system_index, boost::visitor(boost::make_bfs_visitor(distance_recorder)));
+    }
+
+    /** Fills some rows of a jumps distance matrix.  Each work item is given
+      * different rows, so they can be filled concurrently without locking
+      * them, as long as the matrix isn't resized meanwhile. */
+    template <class Graph>
+    class FillSystemJumpsRowsWorkItem {
+    public:
+        FillSystemJumpsRowsWorkItem(const Graph& graph, std::vector<std::vector<short> >& rows,
+                                    const std::vector<size_t>& row_indices) :
+            m_graph(graph),
+            m_rows(rows),
+            m_row_indices(row_indices)
+        {}
+
+        void operator()() {
+            for (std::vector<size_t>::const_iterator it = m_row_indices.begin(); it != m_row_indices.end(); ++it)
+                FillSystemJumpsRow(m_graph, *it, m_rows[*it]);
+        }
+
+    private:
+        const Graph&                        m_graph;
+        std::vector<std::vector<short> >&   m_rows;
+        std::vector<size_t>                 m_row_indices;
+    };
 }
 
 double Universe::LinearDistance(int system1_id, int system2_id) const {
@@ -787,15 +996,10 @@ short Universe::JumpDistance(int system1_id, int system2_id) const {
             // cache miss, still holding a lock in cache_guard
             // we are keeping the row locked during computation so other 
             // threads waiting for the same row will see a cache hit
-            typedef boost::iterator_property_map<std::vector<short>::iterator, boost::identity_property_map> DistancePropertyMap;
-            
-            std::vector<short> private_distance_buffer(m_system_jumps.size(), SHRT_MAX);
-            DistancePropertyMap distance_property_map(private_distance_buffer.begin());
-            boost::distance_recorder<DistancePropertyMap, boost::on_tree_edge> distance_recorder(distance_property_map);
+            std::vector<short> private_distance_buffer;
 
             // FIXME: dont compute m_system_jumps[i][j] again as m_system_jumps[j][i]
-            private_distance_buffer[smaller_index] = 0;
-            boost::breadth_first_search(m_graph_impl->system_graph, smaller_index, boost::visitor(boost::make_bfs_visitor(distance_recorder)));
+            FillSystemJumpsRow(m_graph_impl->system_graph, smaller_index, private_distance_buffer);
             jumps = private_distance_buffer[other_index];
             cache.swap_and_unlock_row(smaller_index, private_distance_buffer, cache_guard);
         }
@@ -811,35 +1015,35 @@ short Universe::JumpDistance(int system1_id, int system2_id) const {
 }
 
 std::pair<std::list<int>, double> Universe::ShortestPath(int system1_id, int system2_id, int empire_id/* = ALL_EMPIRES*/) const {
-    if (empire_id == ALL_EMPIRES) {
-        // find path on full / complete system graph
-        try {
-            double linear_distance = LinearDistance(system1_id, system2_id);
-            return ShortestPathImpl(m_graph_impl->system_graph, system1_id, system2_id,
-                                    linear_distance, m_system_id_to_graph_index);
-        } catch (const std::out_of_range&) {
-            Logger().errorStream() << "Universe::ShortestPath passed invalid system id(s): "
-                                   << system1_id << " & " << system2_id;
-            throw;
+    // find path on full / complete system graph, or on single empire's view of it
+    const SystemAdjacency* adjacency = &m_graph_impl->system_adjacency;
+    if (empire_id != ALL_EMPIRES) {
+        GraphImpl::EmpireSystemAdjacencyMap::const_iterator adjacency_it =
+            m_graph_impl->empire_system_adjacencies.find(empire_id);
+        if (adjacency_it == m_graph_impl->empire_system_adjacencies.end()) {
+            Logger().errorStream() << "Universe::ShortestPath passed unknown empire id: " << empire_id;
+            throw std::out_of_range("Universe::ShortestPath passed unknown empire id");
         }
+        adjacency = adjacency_it->second.get();
     }
 
-    // find path on single empire's view of system graph
-    GraphImpl::EmpireViewSystemGraphMap::const_iterator graph_it =
-        m_graph_impl->empire_system_graph_views.find(empire_id);
-    if (graph_it == m_graph_impl->empire_system_graph_views.end()) {
-        Logger().errorStream() << "Universe::ShortestPath passed unknown empire id: " << empire_id;
-        throw std::out_of_range("Universe::ShortestPath passed unknown empire id");
-    }
     try {
-        double linear_distance = LinearDistance(system1_id, system2_id);
-        return ShortestPathImpl(*graph_it->second, system1_id, system2_id,
-                                linear_distance, m_system_id_to_graph_index);
+        LinearDistance(system1_id, system2_id); // throws if either system doesn't exist
     } catch (const std::out_of_range&) {
         Logger().errorStream() << "Universe::ShortestPath passed invalid system id(s): "
                                << system1_id << " & " << system2_id;
         throw;
     }
+
+    ShortestPathCache::Key key(empire_id, std::make_pair(system1_id, system2_id));
+    std::pair<std::list<int>, double> retval;
+    if (m_graph_impl->shortest_path_cache.Get(key, retval))
+        return retval;
+
+    retval = ShortestPathImpl(*adjacency, m_graph_impl->system_positions, m_graph_impl->system_ids,
+                              system1_id, system2_id, m_system_id_to_graph_index);
+    m_graph_impl->shortest_path_cache.Put(key, retval);
+    return retval;
 }
 
 std::pair<std::list<int>, int> Universe::LeastJumpsPath(int system1_id, int system2_id, int empire_id/* = ALL_EMPIRES*/,
@@ -922,6 +1126,7 @@ TemporaryPtr<T> Universe::Insert(T* obj) {
     int id = GenerateObjectID();
     if (id != INVALID_OBJECT_ID) {
         obj->SetID(id);
+        InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
         return m_objects.Insert(obj);
     }
 
@@ -940,6 +1145,7 @@ TemporaryPtr<T> Universe::InsertID(T* obj, int id) {
         return TemporaryPtr<T>();
 
     obj->SetID(id);
+    InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
     TemporaryPtr<T> result = m_objects.Insert(obj);
     if (id > m_last_allocated_object_id )
         m_last_allocated_object_id = id;
@@ -990,7 +1196,7 @@ bool Universe::DeleteShipDesign(int design_id) {
 }
 
 void Universe::ApplyAllEffectsAndUpdateMeters() {
-    ScopedTimer timer("Universe::ApplyAllEffectsAndUpdateMeters");
+    ScopedTimer timer("Universe::ApplyAllEffectsAndUpdateMeters", true);
 
     // cache all activation and scoping condition results before applying
     // Effects, since the application of these Effects may affect the activation
@@ -1132,11 +1338,11 @@ void Universe::InitMeterEstimatesAndDiscrepancies() {
         }
 
         // every meter has a value at the start of the turn, and a value after updating with known effects
-        for (std::map<MeterType, Meter>::iterator meter_it = obj->Meters().begin();
-             meter_it != obj->Meters().end(); ++meter_it)
-        {
-            MeterType type = meter_it->first;
-            Meter& meter = meter_it->second;
+        for (MeterType type = MeterType(0); type != NUM_METER_TYPES; type = MeterType(type + 1)) {
+            Meter* meter_ptr = obj->Meters().Get(type);
+            if (!meter_ptr)
+                continue;
+            Meter& meter = *meter_ptr;
 
             // discrepancy is the difference between expected and actual meter values at start of turn
             double discrepancy = meter.Initial() - meter.Current();
@@ -1272,7 +1478,7 @@ void Universe::UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec) {
     // cache all activation and scoping condition results before applying Effects, since the application of
     // these Effects may affect the activation and scoping evaluations
     Effect::TargetsCauses targets_causes;
-    GetEffectsAndTargets(targets_causes, objects_vec);
+    GetEffectsAndTargets(targets_causes, objects_vec, true);
 
     // Apply and record effect meter adjustments
     ExecuteEffects(targets_causes, true, true, false, false);
@@ -1360,6 +1566,25 @@ void Universe::BackPropegateObjectMeters()
 { BackPropegateObjectMeters(m_objects.FindObjectIDs()); }
 
 namespace {
+    /** Results of one StoreTargetsAndCausesOfEffectsGroupsWorkItem. */
+    struct EffectsGroupJobResult {
+        Effect::TargetsCauses   targets_causes;
+        Effect::TargetsCache    targets_cache;  ///< targets of all sources, only stored when filling the cache
+    };
+
+    /** How GetEffectsAndTargets uses Universe's effects targets cache. */
+    struct TargetsCacheUse {
+        TargetsCacheUse() :
+            fill(false),
+            reuse_cache(0),
+            changed_dependencies(Condition::DEPENDS_ON_ANYTHING)
+        {}
+        bool                        fill;                   ///< store targets of all sources in job results
+        const Effect::TargetsCache* reuse_cache;            ///< cached targets that may be reused, or null
+        unsigned int                changed_dependencies;   ///< Condition::Dependency flags of changes since reuse_cache was filled
+        std::set<int>               target_ids;             ///< objects to which reused targets are restricted
+    };
+
     /** Used by GetEffectsAndTargets to process a vector of effects groups.
       * Stores target set of specified \a effects_groups and \a source_object_id
       * in \a targets_causes
@@ -1386,23 +1611,28 @@ namespace {
             EffectsCauseType                                         the_effect_cause_type,
             const std::string&                                       the_specific_cause_name,
             const Effect::TargetSet&                                 the_target_objects,
-            Effect::TargetsCauses&                                   the_targets_causes,
+            EffectsGroupJobResult&                                   the_result,
             std::map<int, boost::shared_ptr<ConditionCache> >&       the_source_cached_condition_matches,
             ConditionCache&                                          the_invariant_cached_condition_matches,
-            boost::shared_mutex&                                     the_global_mutex
+            const TargetsCacheUse&                                   the_targets_cache_use
         );
         void operator ()();
     private:
-        // WARNING: do NOT copy the shared_pointers! Use raw pointers, shared_ptr may not be thread-safe. 
+        // Each work item writes its results only to its own m_result buffer, so no locking is needed to store them.  Copying
+        // m_effects_group and the TemporaryPtrs of the cached target sets is
+        // safe, as their reference counts are updated atomically.
         boost::shared_ptr<const Effect::EffectsGroup>            m_effects_group;
         const std::vector< TemporaryPtr<const UniverseObject> >* m_sources;
         EffectsCauseType                                         m_effect_cause_type;
         const std::string                                        m_specific_cause_name;
         const Effect::TargetSet*                                 m_target_objects;
-        Effect::TargetsCauses*                                   m_targets_causes;
+        EffectsGroupJobResult*                                   m_result;
         std::map<int, boost::shared_ptr<ConditionCache> >*       m_source_cached_condition_matches;
         ConditionCache*                                          m_invariant_cached_condition_matches;
-        boost::shared_mutex*                                     m_global_mutex;
+        const TargetsCacheUse*                                   m_targets_cache_use;
+
+        bool ReuseCachedTargets(int source_object_id);
+        void StoreTargets(int source_object_id, const Effect::TargetSet& target_set);
 
         static Effect::TargetSet& GetConditionMatches(
             const Condition::ConditionBase*    cond,
@@ -1418,10 +1648,10 @@ namespace {
             EffectsCauseType                                         the_effect_cause_type,
             const std::string&                                       the_specific_cause_name,
             const Effect::TargetSet&                                 the_target_objects,
-            Effect::TargetsCauses&                                   the_targets_causes,
+            EffectsGroupJobResult&                                   the_result,
             std::map<int, boost::shared_ptr<ConditionCache> >&       the_source_cached_condition_matches,
             ConditionCache&                                          the_invariant_cached_condition_matches,
-            boost::shared_mutex&                                     the_global_mutex
+            const TargetsCacheUse&                                   the_targets_cache_use
         ) :
             m_effects_group                         (the_effects_group),
             m_sources                               (&the_sources),
@@ -1429,10 +1659,10 @@ namespace {
             // create a deep copy just in case string methods do unlocked copy-on-write or other unsafe things
             m_specific_cause_name                   (the_specific_cause_name.c_str()),
             m_target_objects                        (&the_target_objects),
-            m_targets_causes                        (&the_targets_causes),
+            m_result                                (&the_result),
             m_source_cached_condition_matches       (&the_source_cached_condition_matches),
             m_invariant_cached_condition_matches    (&the_invariant_cached_condition_matches),
-            m_global_mutex                          (&the_global_mutex)
+            m_targets_cache_use                     (&the_targets_cache_use)
     {}
 
     std::pair<bool, Effect::TargetSet>* StoreTargetsAndCausesOfEffectsGroupsWorkItem::ConditionCache::Find(
@@ -1539,16 +1769,21 @@ namespace {
     {
         ScopedTimer timer("StoreTargetsAndCausesOfEffectsGroups");
 
-        if (GetOptionsDB().Get<bool>("verbose-logging")) {
-            boost::unique_lock<boost::shared_mutex> guard(*m_global_mutex);
+        if (GetOptionsDB().Get<bool>("verbose-logging"))
             Logger().debugStream() << "StoreTargetsAndCausesOfEffectsGroups(effects group: " << m_effects_group->AccountingLabel() << ", , , specific cause: " << m_specific_cause_name << ", , )";
-        }
 
         // get objects matched by scope
         const Condition::ConditionBase* scope = m_effects_group->Scope();
         if (!scope)
             return;
 
+        // cached targets can be reused if neither the scope nor the
+        // activation condition depend on anything that changed since
+        const Condition::ConditionBase* activation = m_effects_group->Activation();
+        unsigned int dependencies = scope->Dependencies() | (activation ? activation->Dependencies() : Condition::DEPENDS_ON_NOTHING);
+        bool reuse_cached_targets = m_targets_cache_use->reuse_cache &&
+                                    !(dependencies & m_targets_cache_use->changed_dependencies);
+
         // create temporary container for concurrent work
         Effect::TargetSet target_objects(*m_target_objects);
         // process all sources in set provided
@@ -1561,12 +1796,17 @@ namespace {
                                     boost::lexical_cast<std::string>(source_object_id) +
                                     " cause: " + m_specific_cause_name);
 
+            if (reuse_cached_targets && ReuseCachedTargets(source_object_id))
+                continue;
+
             // skip inactive sources
             // FIXME: is it safe to move this out of the loop? 
             // Activation condition must not contain "Source" subconditions in that case
-            const Condition::ConditionBase* activation = m_effects_group->Activation();
-            if (activation && !activation->Eval(source_context, source))
+            if (activation && !activation->Eval(source_context, source)) {
+                if (m_targets_cache_use->fill)
+                    m_result->targets_cache[std::make_pair(m_effects_group.get(), source_object_id)];
                 continue;
+            }
 
             bool source_invariant = !source || scope->SourceInvariant();
             ConditionCache* condition_cache = source_invariant ? m_invariant_cached_condition_matches : (*m_source_cached_condition_matches)[source_object_id].get();
@@ -1579,29 +1819,49 @@ namespace {
                 boost::shared_lock<boost::shared_mutex> cache_guard;
                 
                 condition_cache->LockShared(cache_guard);
+                if (m_targets_cache_use->fill)
+                    m_result->targets_cache[std::make_pair(m_effects_group.get(), source_object_id)] = target_set;
                 if (target_set.empty())
                     continue;
             }
 
-            {
-                // NOTE: boost::shared_ptr copying is not thread-safe. 
-                // FIXME: use TemporaryPtr here, or a dedicated lock
-                boost::unique_lock<boost::shared_mutex> guard(*m_global_mutex);
+            StoreTargets(source_object_id, target_set);
+        }
+    }
+
+    bool StoreTargetsAndCausesOfEffectsGroupsWorkItem::ReuseCachedTargets(int source_object_id) {
+        // sources without cached targets were not sources when the cache
+        // was filled, so have to be evaluated
+        Effect::TargetsCache::const_iterator cache_it =
+            m_targets_cache_use->reuse_cache->find(std::make_pair(m_effects_group.get(), source_object_id));
+        if (cache_it == m_targets_cache_use->reuse_cache->end())
+            return false;
 
-                // combine effects group and source object id into a sourced effects group
-                Effect::SourcedEffectsGroup sourced_effects_group(source_object_id, m_effects_group);
+        // restrict cached targets to the objects being updated
+        Effect::TargetSet target_set;
+        for (Effect::TargetSet::const_iterator it = cache_it->second.begin(); it != cache_it->second.end(); ++it)
+            if (m_targets_cache_use->target_ids.find((*it)->ID()) != m_targets_cache_use->target_ids.end())
+                target_set.push_back(*it);
 
-                // combine cause type and specific cause into effect cause
-                Effect::EffectCause effect_cause(m_effect_cause_type, m_specific_cause_name,
-                                                 m_effects_group->AccountingLabel());
+        if (!target_set.empty())
+            StoreTargets(source_object_id, target_set);
+        return true;
+    }
 
-                // combine target set and effect cause
-                Effect::TargetsAndCause target_and_cause(target_set, effect_cause);
+    void StoreTargetsAndCausesOfEffectsGroupsWorkItem::StoreTargets(int source_object_id, const Effect::TargetSet& target_set) {
+        // combine effects group and source object id into a sourced effects group
+        Effect::SourcedEffectsGroup sourced_effects_group(source_object_id, m_effects_group);
 
-                // store effect cause and targets info in map, indexed by sourced effects group
-                m_targets_causes->push_back(std::make_pair(sourced_effects_group, target_and_cause));
-            }
-        }
+        // combine cause type and specific cause into effect cause
+        Effect::EffectCause effect_cause(m_effect_cause_type, m_specific_cause_name,
+                                         m_effects_group->AccountingLabel());
+
+        // combine target set and effect cause
+        Effect::TargetsAndCause target_and_cause(target_set, effect_cause);
+
+        // store effect cause and targets info in this job's own result
+        // buffer, indexed by sourced effects group
+        m_result->targets_causes.push_back(std::make_pair(sourced_effects_group, target_and_cause));
     }
 
 } // namespace
@@ -1613,11 +1873,31 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes) {
 
 void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
                                     const std::vector<int>& target_objects)
+{ GetEffectsAndTargets(targets_causes, target_objects, false); }
+
+void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
+                                    const std::vector<int>& target_objects,
+                                    bool use_targets_cache)
 {
     ScopedTimer timer("Universe::GetEffectsAndTargets");
 
+    // conditions may draw their candidates from the object indexes, which
+    // can't be rebuilt while they are being evaluated concurrently
+    m_objects.UpdateObjectIndexes();
+
+    TargetsCacheUse targets_cache_use;
+    if (use_targets_cache && target_objects.empty()) {
+        targets_cache_use.fill = true;
+    } else if (use_targets_cache && m_effects_targets_cache_valid) {
+        // meters of the target objects have been reset before getting here
+        targets_cache_use.reuse_cache = &m_effects_targets_cache;
+        targets_cache_use.changed_dependencies = m_effects_targets_cache_changes | Condition::DEPENDS_ON_METERS;
+        targets_cache_use.target_ids.insert(target_objects.begin(), target_objects.end());
+    }
+
     // transfer target objects from input vector to a set
-    Effect::TargetSet all_potential_targets = m_objects.FindObjects(target_objects);
+    std::vector<TemporaryPtr<UniverseObject> > target_objects_found = m_objects.FindObjects(target_objects);
+    Effect::TargetSet all_potential_targets(target_objects_found.begin(), target_objects_found.end());
 
     if (GetOptionsDB().Get<bool>("verbose-logging")) {
         Logger().debugStream() << "target objects:";
@@ -1646,11 +1926,10 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
     boost::timer type_timer;
     boost::timer eval_timer;
 
-    std::list<Effect::TargetsCauses> targets_causes_reorder_buffer; // create before run_queue, destroy after run_queue
+    // one result buffer per job, merged in issue order after all jobs are done
+    std::list<EffectsGroupJobResult> targets_causes_reorder_buffer; // create before run_queue, destroy after run_queue
     unsigned int num_threads = static_cast<unsigned int>(std::max(1, GetOptionsDB().Get<int>("effects-threads")));
     RunQueue<StoreTargetsAndCausesOfEffectsGroupsWorkItem> run_queue(num_threads);
-    boost::shared_mutex global_mutex;
-    boost::unique_lock<boost::shared_mutex> global_lock(global_mutex); // create after run_queue, destroy before run_queue
 
     eval_timer.restart();
 
@@ -1714,13 +1993,13 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         const std::vector<boost::shared_ptr<const Effect::EffectsGroup> >& effects_groups = species->Effects();
         std::vector<boost::shared_ptr<const Effect::EffectsGroup> >::const_iterator effects_group_it;
         for (effects_group_it = effects_groups.begin(); effects_group_it != effects_groups.end(); ++effects_group_it) {
-            targets_causes_reorder_buffer.push_back(Effect::TargetsCauses());
+            targets_causes_reorder_buffer.push_back(EffectsGroupJobResult());
             run_queue.AddWork(new StoreTargetsAndCausesOfEffectsGroupsWorkItem(
                                                  *effects_group_it, species_objects_it->second, ECT_SPECIES, species_name,
                                                  all_potential_targets, targets_causes_reorder_buffer.back(),
                                                  cached_source_condition_matches,
                                                  invariant_condition_matches,
-                                                 global_mutex));
+                                                 targets_cache_use));
         }
     }
 
@@ -1758,13 +2037,13 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         const std::vector<boost::shared_ptr<const Effect::EffectsGroup> >& effects_groups = special->Effects();
         std::vector<boost::shared_ptr<const Effect::EffectsGroup> >::const_iterator effects_group_it;
         for (effects_group_it = effects_groups.begin(); effects_group_it != effects_groups.end(); ++effects_group_it) {
-            targets_causes_reorder_buffer.push_back(Effect::TargetsCauses());
+            targets_causes_reorder_buffer.push_back(EffectsGroupJobResult());
             run_queue.AddWork(new StoreTargetsAndCausesOfEffectsGroupsWorkItem(
                                                  *effects_group_it, specials_objects_it->second, ECT_SPECIAL, special_name,
                                                  all_potential_targets, targets_causes_reorder_buffer.back(),
                                                  cached_source_condition_matches,
                                                  invariant_condition_matches,
-                                                 global_mutex));
+                                                 targets_cache_use));
         }
     }
     double special_time = type_timer.elapsed();
@@ -1814,13 +2093,13 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
             const std::vector<boost::shared_ptr<const Effect::EffectsGroup> >& effects_groups = tech->Effects();
             std::vector<boost::shared_ptr<const Effect::EffectsGroup> >::const_iterator effects_group_it;
             for (effects_group_it = effects_groups.begin(); effects_group_it != effects_groups.end(); ++effects_group_it) {
-                targets_causes_reorder_buffer.push_back(Effect::TargetsCauses());
+                targets_causes_reorder_buffer.push_back(EffectsGroupJobResult());
                 run_queue.AddWork(new StoreTargetsAndCausesOfEffectsGroupsWorkItem(
                                                      *effects_group_it, tech_sources.back(), ECT_TECH, tech->Name(),
                                                      all_potential_targets, targets_causes_reorder_buffer.back(),
                                                      cached_source_condition_matches,
                                                      invariant_condition_matches,
-                                                     global_mutex));
+                                                     targets_cache_use));
             }
         }
     }
@@ -1862,13 +2141,13 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         const std::vector<boost::shared_ptr<const Effect::EffectsGroup> >& effects_groups = building_type->Effects();
         std::vector<boost::shared_ptr<const Effect::EffectsGroup> >::const_iterator effects_group_it;
         for (effects_group_it = effects_groups.begin(); effects_group_it != effects_groups.end(); ++effects_group_it) {
-            targets_causes_reorder_buffer.push_back(Effect::TargetsCauses());
+            targets_causes_reorder_buffer.push_back(EffectsGroupJobResult());
             run_queue.AddWork(new StoreTargetsAndCausesOfEffectsGroupsWorkItem(
                                                  *effects_group_it, buildings_by_type_it->second, ECT_BUILDING, building_type_name,
                                                  all_potential_targets, targets_causes_reorder_buffer.back(),
                                                  cached_source_condition_matches,
                                                  invariant_condition_matches,
-                                                 global_mutex));
+                                                 targets_cache_use));
         }
     }
     double building_time = type_timer.elapsed();
@@ -1928,13 +2207,13 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         const std::vector<boost::shared_ptr<const Effect::EffectsGroup> >& effects_groups = hull_type->Effects();
         std::vector<boost::shared_ptr<const Effect::EffectsGroup> >::const_iterator effects_group_it;
         for (effects_group_it = effects_groups.begin(); effects_group_it != effects_groups.end(); ++effects_group_it) {
-            targets_causes_reorder_buffer.push_back(Effect::TargetsCauses());
+            targets_causes_reorder_buffer.push_back(EffectsGroupJobResult());
             run_queue.AddWork(new StoreTargetsAndCausesOfEffectsGroupsWorkItem(
                                                  *effects_group_it, ships_by_hull_type_it->second, ECT_SHIP_HULL, hull_type_name,
                                                  all_potential_targets, targets_causes_reorder_buffer.back(),
                                                  cached_source_condition_matches,
                                                  invariant_condition_matches,
-                                                 global_mutex));
+                                                 targets_cache_use));
         }
     }
     // enforce part types effects order
@@ -1949,13 +2228,13 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         const std::vector<boost::shared_ptr<const Effect::EffectsGroup> >& effects_groups = part_type->Effects();
         std::vector<boost::shared_ptr<const Effect::EffectsGroup> >::const_iterator effects_group_it;
         for (effects_group_it = effects_groups.begin(); effects_group_it != effects_groups.end(); ++effects_group_it) {
-            targets_causes_reorder_buffer.push_back(Effect::TargetsCauses());
+            targets_causes_reorder_buffer.push_back(EffectsGroupJobResult());
             run_queue.AddWork(new StoreTargetsAndCausesOfEffectsGroupsWorkItem(
                                                  *effects_group_it, ships_by_part_type_it->second, ECT_SHIP_PART, part_type_name,
                                                  all_potential_targets, targets_causes_reorder_buffer.back(),
                                                  cached_source_condition_matches,
                                                  invariant_condition_matches,
-                                                 global_mutex));
+                                                 targets_cache_use));
         }
     }
     double ships_time = type_timer.elapsed();
@@ -1994,30 +2273,38 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
         const std::vector<boost::shared_ptr<const Effect::EffectsGroup> >& effects_groups = field_type->Effects();
         std::vector<boost::shared_ptr<const Effect::EffectsGroup> >::const_iterator effects_group_it;
         for (effects_group_it = effects_groups.begin(); effects_group_it != effects_groups.end(); ++effects_group_it) {
-            targets_causes_reorder_buffer.push_back(Effect::TargetsCauses());
+            targets_causes_reorder_buffer.push_back(EffectsGroupJobResult());
             run_queue.AddWork(new StoreTargetsAndCausesOfEffectsGroupsWorkItem(
                                                  *effects_group_it, fields_by_type_it->second, ECT_FIELD, field_type_name,
                                                  all_potential_targets, targets_causes_reorder_buffer.back(),
                                                  cached_source_condition_matches,
                                                  invariant_condition_matches,
-                                                 global_mutex));
+                                                 targets_cache_use));
         }
     }
     double fields_time = type_timer.elapsed();
 
-    run_queue.Wait(global_lock);
+    run_queue.Wait();
     double eval_time = eval_timer.elapsed();
 
     eval_timer.restart();
-    // add results to targets_causes in issue order
+    // add results to targets_causes in issue order, so the result does not
+    // depend on the number of threads or the order in which jobs finished
     // FIXME: each job is an effectsgroup, and we need that separation for
     // execution anyway, so maintain it here instead of merging.
-    for (std::list<Effect::TargetsCauses>::const_iterator job_it = targets_causes_reorder_buffer.begin(); job_it != targets_causes_reorder_buffer.end(); ++job_it) {
-        Effect::TargetsCauses job_results = *job_it;
-
-        for (Effect::TargetsCauses::const_iterator result_it = job_results.begin(); result_it != job_results.end(); ++result_it) {
-            targets_causes.push_back(*result_it);
-        }
+    std::size_t num_results = targets_causes.size();
+    for (std::list<EffectsGroupJobResult>::const_iterator job_it = targets_causes_reorder_buffer.begin(); job_it != targets_causes_reorder_buffer.end(); ++job_it)
+        num_results += job_it->targets_causes.size();
+    targets_causes.reserve(num_results);
+    for (std::list<EffectsGroupJobResult>::const_iterator job_it = targets_causes_reorder_buffer.begin(); job_it != targets_causes_reorder_buffer.end(); ++job_it)
+        targets_causes.insert(targets_causes.end(), job_it->targets_causes.begin(), job_it->targets_causes.end());
+
+    if (targets_cache_use.fill) {
+        m_effects_targets_cache.clear();
+        for (std::list<EffectsGroupJobResult>::const_iterator job_it = targets_causes_reorder_buffer.begin(); job_it != targets_causes_reorder_buffer.end(); ++job_it)
+            m_effects_targets_cache.insert(job_it->targets_cache.begin(), job_it->targets_cache.end());
+        m_effects_targets_cache_valid = true;
+        m_effects_targets_cache_changes = Condition::DEPENDS_ON_NOTHING;
     }
     double reorder_time = eval_timer.elapsed();
     Logger().debugStream() << "Issue times: planet species: " << planet_species_time*1000
@@ -2028,6 +2315,7 @@ void Universe::GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
                            << " hulls/parts: " << ships_time*1000
                            << " fields: " << fields_time*1000;
     Logger().debugStream() << "Evaluation time: " << eval_time*1000
+                           << " on " << run_queue.NumThreads() << " threads"
                            << " reorder time: " << reorder_time*1000;
 }
 
@@ -2132,6 +2420,11 @@ void Universe::ExecuteEffects(const Effect::TargetsCauses& targets_causes,
                                 include_empire_meter_effects);
     }
 
+    // meter and appearance effects only change meters, which are never
+    // assumed unchanged when reusing cached effects targets
+    if (!only_meter_effects && !only_appearance_effects)
+        InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
+
     // actually do destroy effect action.  Executing the effect just marks
     // objects to be destroyed, but doesn't actually do so in order to ensure
     // no interaction in order of effects and source or target objects being
@@ -2144,21 +2437,8 @@ void Universe::SetEmpireObjectVisibility(int empire_id, int object_id, Visibilit
     if (empire_id == ALL_EMPIRES || object_id == INVALID_OBJECT_ID)
         return;
 
-    // get visibility map for empire and find object in it
-    Universe::ObjectVisibilityMap& vis_map = m_empire_object_visibility[empire_id];
-    Universe::ObjectVisibilityMap::iterator vis_map_it = vis_map.find(object_id);
-
-    // if object not already present, store default value (which may be replaced)
-    if (vis_map_it == vis_map.end()) {
-        vis_map[object_id] = VIS_NO_VISIBILITY;
-
-        // get iterator pointing at newly-created entry
-        vis_map_it = vis_map.find(object_id);
-    }
-
     // increase stored value if new visibility is higher than last recorded
-    if (vis > vis_map_it->second)
-        vis_map_it->second = vis;
+    m_empire_object_visibility.Raise(empire_id, object_id, vis);
 
     // if object is a ship, empire also gets knowledge of its design
     if (vis >= VIS_PARTIAL_VISIBILITY) {
@@ -2191,13 +2471,130 @@ void Universe::SetEmpireSpecialVisibility(int empire_id, int object_id,
 }
 
 namespace {
-    /** for each empire: for each position where the empire has detector objects,
-      * what is the empire's detection range at that location?  (this is the
-      * largest of the detection ranges of objects the empire has at that spot) */
-    std::map<int, std::map<std::pair<double, double>, float> >
-        GetEmpiresPositionDetectionRanges()
-    {
-        std::map<int, std::map<std::pair<double, double>, float> > retval;
+    /** position and detection range of an object that gives an empire
+      * detection */
+    struct DetectorPosition {
+        DetectorPosition(double x_, double y_, float range_) :
+            x(x_), y(y_), range(range_)
+        {}
+        double  x;
+        double  y;
+        float   range;
+    };
+
+    /** An empire's detector positions, bucketed into a grid of square cells
+      * that are at least as large as the largest detection range, so that
+      * finding a detector in range of a position only needs to check the
+      * detectors in the cells around that position, rather than all of
+      * them. */
+    class DetectorGrid {
+    public:
+        DetectorGrid() :
+            m_min_x(0.0),
+            m_min_y(0.0),
+            m_cell_size(1.0),
+            m_max_range(0.0f),
+            m_columns(0),
+            m_rows(0)
+        {}
+
+        explicit DetectorGrid(const std::vector<DetectorPosition>& detectors) :
+            m_min_x(0.0),
+            m_min_y(0.0),
+            m_cell_size(1.0),
+            m_max_range(0.0f),
+            m_columns(0),
+            m_rows(0)
+        {
+            if (detectors.empty())
+                return;
+
+            double max_x = detectors.front().x;
+            double max_y = detectors.front().y;
+            m_min_x = max_x;
+            m_min_y = max_y;
+            for (std::vector<DetectorPosition>::const_iterator it = detectors.begin();
+                 it != detectors.end(); ++it)
+            {
+                m_min_x = std::min(m_min_x, it->x);
+                m_min_y = std::min(m_min_y, it->y);
+                max_x = std::max(max_x, it->x);
+                max_y = std::max(max_y, it->y);
+                m_max_range = std::max(m_max_range, it->range);
+            }
+
+            // cells no smaller than the largest range, so that a position's
+            // detectors are all in the adjacent cells, but not so small that
+            // there are an excessive number of cells
+            double extent = std::max(max_x - m_min_x, max_y - m_min_y);
+            m_cell_size = std::max(static_cast<double>(m_max_range),
+                                   std::max(extent / MAX_CELLS_PER_SIDE, 1.0));
+            m_columns = static_cast<int>((max_x - m_min_x) / m_cell_size) + 1;
+            m_rows = static_cast<int>((max_y - m_min_y) / m_cell_size) + 1;
+
+            m_cells.resize(m_columns * m_rows);
+            for (std::vector<DetectorPosition>::const_iterator it = detectors.begin();
+                 it != detectors.end(); ++it)
+            {
+                int column = std::min(static_cast<int>((it->x - m_min_x) / m_cell_size), m_columns - 1);
+                int row = std::min(static_cast<int>((it->y - m_min_y) / m_cell_size), m_rows - 1);
+                m_cells[row * m_columns + column].push_back(*it);
+            }
+        }
+
+        /** returns true iff the position (\a x, \a y) is no further than a
+          * detector's range plus \a extra_range from that detector */
+        bool InRange(double x, double y, double extra_range = 0.0) const {
+            if (m_cells.empty())
+                return false;
+
+            // number of cells around the position's cell that could contain
+            // detectors in range
+            double reach = m_max_range + extra_range;
+            if (reach < 0.0)
+                return false;
+            int cell_reach = static_cast<int>(std::ceil(reach / m_cell_size));
+
+            int column = static_cast<int>(std::floor((x - m_min_x) / m_cell_size));
+            int row = static_cast<int>(std::floor((y - m_min_y) / m_cell_size));
+            int first_column = std::max(column - cell_reach, 0);
+            int last_column = std::min(column + cell_reach, m_columns - 1);
+            int first_row = std::max(row - cell_reach, 0);
+            int last_row = std::min(row + cell_reach, m_rows - 1);
+
+            for (int cell_row = first_row; cell_row <= last_row; ++cell_row) {
+                for (int cell_column = first_column; cell_column <= last_column; ++cell_column) {
+                    const std::vector<DetectorPosition>& cell = m_cells[cell_row * m_columns + cell_column];
+                    for (std::vector<DetectorPosition>::const_iterator it = cell.begin(); it != cell.end(); ++it) {
+                        double range = it->range + extra_range;
+                        if (range < 0.0)
+                            continue;
+                        double x_dist = it->x - x;
+                        double y_dist = it->y - y;
+                        if (x_dist*x_dist + y_dist*y_dist <= range*range)
+                            return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+        static const int MAX_CELLS_PER_SIDE = 256;
+
+        double  m_min_x;
+        double  m_min_y;
+        double  m_cell_size;
+        float   m_max_range;
+        int     m_columns;
+        int     m_rows;
+        std::vector<std::vector<DetectorPosition> > m_cells;   ///< detectors in each cell, in row-major order
+    };
+
+    /** for each empire: a grid of the positions where the empire has detector
+      * objects, and the detection ranges of those objects */
+    std::map<int, DetectorGrid> GetEmpiresDetectorGrids() {
+        std::map<int, std::vector<DetectorPosition> > empire_detectors;
 
         for (ObjectMap::const_iterator<> object_it = Objects().const_begin();
                 object_it != Objects().const_end(); ++object_it)
@@ -2231,17 +2628,14 @@ namespace {
             }
 
             // record object's detection range for owner
-            int object_owner_empire_id = obj->Owner();
-            std::pair<double, double> object_pos(obj->X(), obj->Y());
-            // store range in output map (if new for location or larger than any
-            // previously-found range at this location)
-            std::map<std::pair<double, double>, float>& retval_empire_pos_range = retval[object_owner_empire_id];
-            std::map<std::pair<double, double>, float>::iterator retval_pos_it = retval_empire_pos_range.find(object_pos);
-            if (retval_pos_it == retval_empire_pos_range.end())
-                retval_empire_pos_range[object_pos] = object_detection_range;
-            else
-                retval_pos_it->second = std::max(retval_pos_it->second, object_detection_range);
+            empire_detectors[obj->Owner()].push_back(
+                DetectorPosition(obj->X(), obj->Y(), object_detection_range));
         }
+
+        std::map<int, DetectorGrid> retval;
+        for (std::map<int, std::vector<DetectorPosition> >::const_iterator it = empire_detectors.begin();
+             it != empire_detectors.end(); ++it)
+        { retval.insert(std::make_pair(it->first, DetectorGrid(it->second))); }
         return retval;
     }
 
@@ -2302,35 +2696,21 @@ namespace {
       * within range of a set of detectors and ranges */
     std::vector<int> FilterObjectPositionsByDetectorPositionsAndRanges(
         const std::map<std::pair<double, double>, std::vector<int> >& object_positions,
-        const std::map<std::pair<double, double>, float>& detector_position_ranges)
+        const DetectorGrid& detectors)
     {
         std::vector<int> retval;
-        // check each detector position and range against each object position
+        // check each object position against the detectors near it
         for (std::map<std::pair<double, double>, std::vector<int> >::const_iterator
              object_position_it = object_positions.begin();
              object_position_it != object_positions.end();
              ++object_position_it)
         {
             const std::pair<double, double>& object_pos = object_position_it->first;
+            if (!detectors.InRange(object_pos.first, object_pos.second))
+                continue;   // objects out of range
+            // add objects at position to return value
             const std::vector<int>& objects = object_position_it->second;
-            // search through detector positions until one is found in range
-            for (std::map<std::pair<double, double>, float>::const_iterator
-                 detector_position_it = detector_position_ranges.begin();
-                 detector_position_it != detector_position_ranges.end();
-                 ++detector_position_it)
-            {
-                // check range for this detector location for this detectables location
-                float detector_range2 = detector_position_it->second * detector_position_it->second;
-                const std::pair<double, double>& detector_pos = detector_position_it->first;
-                double x_dist = detector_pos.first - object_pos.first;
-                double y_dist = detector_pos.second - object_pos.second;
-                double dist2 = x_dist*x_dist + y_dist*y_dist;
-                if (dist2 > detector_range2)
-                    continue;   // object out of range
-                // add objects at position to return value
-                std::copy(objects.begin(), objects.end(), std::back_inserter(retval));
-                break;  // done searching for a detector position in range
-            }
+            std::copy(objects.begin(), objects.end(), std::back_inserter(retval));
         }
         return retval;
     }
@@ -2367,16 +2747,14 @@ namespace {
       * permissive than other object types, so a special function for them is
       * needed in addition to SetEmpireObjectVisibilitiesFromRanges(...) */
     void SetEmpireFieldVisibilitiesFromRanges(
-        const std::map<int, std::map<std::pair<double, double>, float> >&
-            empire_location_detection_ranges,
+        const std::map<int, DetectorGrid>& empire_detector_grids,
         const ObjectMap& objects)
     {
-        std::vector<TemporaryPtr<const Field> > fields = objects.FindObjects<Field>();
         Universe& universe = GetUniverse();
 
-        for (std::map<int, std::map<std::pair<double, double>, float> >::const_iterator
-             detecting_empire_it = empire_location_detection_ranges.begin();
-             detecting_empire_it != empire_location_detection_ranges.end();
+        for (std::map<int, DetectorGrid>::const_iterator
+             detecting_empire_it = empire_detector_grids.begin();
+             detecting_empire_it != empire_detector_grids.end();
              ++detecting_empire_it)
         {
             int detecting_empire_id = detecting_empire_it->first;
@@ -2389,9 +2767,8 @@ namespace {
                 continue;
             detection_strength = meter->Current();
 
-            // get empire's locations of detection ranges
-            const std::map<std::pair<double, double>, float>& detector_position_ranges =
-                detecting_empire_it->second;
+            // get empire's detector positions and ranges
+            const DetectorGrid& detectors = detecting_empire_it->second;
 
             // for each field, try to find a detector position in range for this empire
             for (ObjectMap::const_iterator<Field> field_it = objects.const_begin<Field>();
@@ -2400,29 +2777,15 @@ namespace {
                 TemporaryPtr<const Field> field = *field_it;
                 if (field->GetMeter(METER_STEALTH)->Current() > detection_strength)
                     continue;
+
+                // fields are detectable if a detector is in range of any part
+                // of them, so the range is effectively extended by their size
                 double field_size = field->GetMeter(METER_SIZE)->Current();
-                const std::pair<double, double> object_pos(field->X(), field->Y());
+                if (!detectors.InRange(field->X(), field->Y(), field_size))
+                    continue;   // field out of range
 
-                // search through detector positions until one is found in range
-                for (std::map<std::pair<double, double>, float>::const_iterator
-                     detector_position_it = detector_position_ranges.begin();
-                     detector_position_it != detector_position_ranges.end();
-                     ++detector_position_it)
-                {
-                    // check range for this detector location, for field of this
-                    // size, against distance between field and detector
-                    float detector_range = detector_position_it->second;
-                    const std::pair<double, double>& detector_pos = detector_position_it->first;
-                    double x_dist = detector_pos.first - object_pos.first;
-                    double y_dist = detector_pos.second - object_pos.second;
-                    double dist = std::sqrt(x_dist*x_dist + y_dist*y_dist);
-                    double effective_dist = dist - field_size;
-                    if (effective_dist > detector_range)
-                        continue;   // object out of range
-
-                    universe.SetEmpireObjectVisibility(detecting_empire_id, field->ID(),
-                                                       VIS_PARTIAL_VISIBILITY);
-                }
+                universe.SetEmpireObjectVisibility(detecting_empire_id, field->ID(),
+                                                   VIS_PARTIAL_VISIBILITY);
             }
         }
     }
@@ -2431,22 +2794,20 @@ namespace {
       * potentially detectable objects (if in range) and and input empire
       * detection ranges at locations. */
     void SetEmpireObjectVisibilitiesFromRanges(
-        const std::map<int, std::map<std::pair<double, double>, float> >&
-            empire_location_detection_ranges,
+        const std::map<int, DetectorGrid>& empire_detector_grids,
         const std::map<int, std::map<std::pair<double, double>, std::vector<int> > >&
             empire_location_potentially_detectable_objects)
     {
         Universe& universe = GetUniverse();
 
-        for (std::map<int, std::map<std::pair<double, double>, float> >::const_iterator
-             detecting_empire_it = empire_location_detection_ranges.begin();
-             detecting_empire_it != empire_location_detection_ranges.end();
+        for (std::map<int, DetectorGrid>::const_iterator
+             detecting_empire_it = empire_detector_grids.begin();
+             detecting_empire_it != empire_detector_grids.end();
              ++detecting_empire_it)
         {
             int detecting_empire_id = detecting_empire_it->first;
             // get empire's locations of detection ability
-            const std::map<std::pair<double, double>, float>& detector_position_ranges =
-                detecting_empire_it->second;
+            const DetectorGrid& detectors = detecting_empire_it->second;
             // for this empire, get objects it could potentially detect
             const std::map<int, std::map<std::pair<double, double>, std::vector<int> > >::const_iterator
                 empire_detectable_objects_it = empire_location_potentially_detectable_objects.find(detecting_empire_id);
@@ -2461,7 +2822,7 @@ namespace {
             // of a detector
             std::vector<int> in_range_detectable_objects =
                 FilterObjectPositionsByDetectorPositionsAndRanges(detectable_position_objects,
-                                                                  detector_position_ranges);
+                                                                  detectors);
             if (in_range_detectable_objects.empty())
                 continue;
 
@@ -2563,8 +2924,10 @@ namespace {
     }
 
     void PropegateVisibilityToContainerObjects(const ObjectMap& objects,
-                                               Universe::EmpireObjectVisibilityMap& empire_object_visibility)
+                                               VisibilityTable& empire_object_visibility)
     {
+        const std::vector<int> empire_ids = empire_object_visibility.EmpireIDs();
+
         // propegate visibility from contained to container objects
         for (ObjectMap::const_iterator<> container_object_it = objects.const_begin();
              container_object_it != objects.const_end(); ++container_object_it)
@@ -2596,93 +2959,77 @@ namespace {
                 //Logger().debugStream() << " ... contained object (" << contained_obj_id << ")";
 
                 // for each empire with a visibility map
-                for (Universe::EmpireObjectVisibilityMap::iterator empire_it = empire_object_visibility.begin();
-                     empire_it != empire_object_visibility.end(); ++empire_it)
+                for (std::vector<int>::const_iterator empire_it = empire_ids.begin();
+                     empire_it != empire_ids.end(); ++empire_it)
                 {
-                    Universe::ObjectVisibilityMap& vis_map = empire_it->second;
+                    int empire_id = *empire_it;
 
-                    //Logger().debugStream() << " ... ... empire id " << empire_it->first;
+                    //Logger().debugStream() << " ... ... empire id " << empire_id;
 
-                    // find current empire's visibility entry for current container object
-                    Universe::ObjectVisibilityMap::iterator container_vis_it = vis_map.find(container_obj_id);
                     // if no entry yet stored for this object, default to not visible
-                    if (container_vis_it == vis_map.end()) {
-                        vis_map[container_obj_id] = VIS_NO_VISIBILITY;
+                    empire_object_visibility.Raise(empire_id, container_obj_id, VIS_NO_VISIBILITY);
 
-                        // get iterator pointing at newly-created entry
-                        container_vis_it = vis_map.find(container_obj_id);
-                    } else {
-                        // check whether having a contained object would change container's visibility
-                        if (container_fleet) {
-                            // special case for fleets: grant partial visibility if
-                            // a contained ship is seen with partial visibility or
-                            // higher visibilitly
-                            if (container_vis_it->second >= VIS_PARTIAL_VISIBILITY)
-                                continue;
-                        } else if (container_vis_it->second >= VIS_BASIC_VISIBILITY) {
-                            // general case: for non-fleets, having visible
-                            // contained object grants basic vis only.  if
-                            // container already has this or better for the current
-                            // empire, don't need to propegate anything
+                    // check whether having a contained object would change container's visibility
+                    Visibility container_vis = empire_object_visibility.Get(empire_id, container_obj_id);
+                    if (container_fleet) {
+                        // special case for fleets: grant partial visibility if
+                        // a contained ship is seen with partial visibility or
+                        // higher visibilitly
+                        if (container_vis >= VIS_PARTIAL_VISIBILITY)
                             continue;
-                        }
+                    } else if (container_vis >= VIS_BASIC_VISIBILITY) {
+                        // general case: for non-fleets, having visible
+                        // contained object grants basic vis only.  if
+                        // container already has this or better for the current
+                        // empire, don't need to propegate anything
+                        continue;
                     }
 
+                    // get contained object's visibility for current empire
+                    Visibility contained_obj_vis = empire_object_visibility.Get(empire_id, contained_obj_id);
 
-                    // find contained object's entry in visibility map
-                    Universe::ObjectVisibilityMap::iterator contained_vis_it = vis_map.find(contained_obj_id);
-                    if (contained_vis_it != vis_map.end()) {
-                        // get contained object's visibility for current empire
-                        Visibility contained_obj_vis = contained_vis_it->second;
-
-                        // no need to propegate if contained object isn't visible to current empire
-                        if (contained_obj_vis <= VIS_NO_VISIBILITY)
-                            continue;
-
-                        //Logger().debugStream() << " ... ... contained object vis: " << contained_obj_vis;
-
-                        // contained object is at least basically visible.
-                        // container should be at least partially visible, but don't
-                        // want to decrease visibility of container if it is already
-                        // higher than partially visible
-                        if (container_vis_it->second < VIS_BASIC_VISIBILITY)
-                            container_vis_it->second = VIS_BASIC_VISIBILITY;
+                    // no need to propegate if contained object isn't visible to current empire
+                    if (contained_obj_vis <= VIS_NO_VISIBILITY)
+                        continue;
 
-                        // special case for fleets: grant partial visibility if
-                        // visible contained object is partially or better visible
-                        // this way fleet ownership is known to players who can 
-                        // see ships with partial or better visibility (and thus
-                        // know the owner of the ships and thus should know the
-                        // owners of the fleet)
-                        if (container_fleet && contained_obj_vis >= VIS_PARTIAL_VISIBILITY &&
-                            container_vis_it->second < VIS_PARTIAL_VISIBILITY)
-                        { container_vis_it->second = VIS_PARTIAL_VISIBILITY; }
-                    }
+                    //Logger().debugStream() << " ... ... contained object vis: " << contained_obj_vis;
+
+                    // contained object is at least basically visible.
+                    // container should be at least partially visible, but don't
+                    // want to decrease visibility of container if it is already
+                    // higher than partially visible
+                    empire_object_visibility.Raise(empire_id, container_obj_id, VIS_BASIC_VISIBILITY);
+
+                    // special case for fleets: grant partial visibility if
+                    // visible contained object is partially or better visible
+                    // this way fleet ownership is known to players who can 
+                    // see ships with partial or better visibility (and thus
+                    // know the owner of the ships and thus should know the
+                    // owners of the fleet)
+                    if (container_fleet && contained_obj_vis >= VIS_PARTIAL_VISIBILITY)
+                        empire_object_visibility.Raise(empire_id, container_obj_id, VIS_PARTIAL_VISIBILITY);
                 }   // end for empire visibility entries
             }   // end for contained objects
         }   // end for container objects
     }
 
     void PropegateVisibilityToSystemsAlongStarlanes(const ObjectMap& objects,
-                                                    Universe::EmpireObjectVisibilityMap& empire_object_visibility) {
+                                                    VisibilityTable& empire_object_visibility) {
+        const std::vector<int> empire_ids = empire_object_visibility.EmpireIDs();
+
         const std::vector<TemporaryPtr<const System> > systems = objects.FindObjects<System>();
         for (std::vector<TemporaryPtr<const System> >::const_iterator it = systems.begin(); it != systems.end(); ++it) {
             TemporaryPtr<const System> system = *it;
             int system_id = system->ID();
 
             // for each empire with a visibility map
-            for (Universe::EmpireObjectVisibilityMap::iterator empire_it = empire_object_visibility.begin();
-                 empire_it != empire_object_visibility.end(); ++empire_it)
+            for (std::vector<int>::const_iterator empire_it = empire_ids.begin();
+                 empire_it != empire_ids.end(); ++empire_it)
             {
-                Universe::ObjectVisibilityMap& vis_map = empire_it->second;
-
-                // find current system's visibility
-                Universe::ObjectVisibilityMap::iterator system_vis_it = vis_map.find(system_id);
-                if (system_vis_it == vis_map.end())
-                    continue;
+                int empire_id = *empire_it;
 
                 // skip systems that aren't at least partially visible; they can't propegate visibility along starlanes
-                Visibility system_vis = system_vis_it->second;
+                Visibility system_vis = empire_object_visibility.Get(empire_id, system_id);
                 if (system_vis <= VIS_BASIC_VISIBILITY)
                     continue;
 
@@ -2695,16 +3042,11 @@ namespace {
                     if (is_wormhole)
                         continue;
 
-                    // find entry for system on other end of starlane in visibility
-                    // map, and upgrade to basic visibility if not already at that
-                    // leve, so that starlanes will be visible if either system it
-                    // ends at is partially visible or better
-                    int lane_end_sys_id = lane_it->first;
-                    Universe::ObjectVisibilityMap::iterator lane_end_vis_it = vis_map.find(lane_end_sys_id);
-                    if (lane_end_vis_it == vis_map.end())
-                        vis_map[lane_end_sys_id] = VIS_BASIC_VISIBILITY;
-                    else if (lane_end_vis_it->second < VIS_BASIC_VISIBILITY)
-                        lane_end_vis_it->second = VIS_BASIC_VISIBILITY;
+                    // upgrade system on other end of starlane to basic
+                    // visibility if not already at that level, so that
+                    // starlanes will be visible if either system it ends at
+                    // is partially visible or better
+                    empire_object_visibility.Raise(empire_id, lane_it->first, VIS_BASIC_VISIBILITY);
                 }
             }
         }
@@ -2712,7 +3054,7 @@ namespace {
     }
 
     void SetTravelledStarlaneEndpointsVisible(const ObjectMap& objects,
-                                              Universe::EmpireObjectVisibilityMap& empire_object_visibility)
+                                              VisibilityTable& empire_object_visibility)
     {
         // ensure systems on either side of a starlane along which a fleet is
         // moving are at least basically visible, so that the starlane itself can /
@@ -2734,28 +3076,13 @@ namespace {
 
             // ensure fleet's owner has at least basic visibility of the next
             // and previous systems on the fleet's path
-            Universe::ObjectVisibilityMap& vis_map = empire_object_visibility[fleet->Owner()];
-
-            Universe::ObjectVisibilityMap::iterator system_vis_it = vis_map.find(prev);
-            if (system_vis_it == vis_map.end()) {
-                vis_map[prev] = VIS_BASIC_VISIBILITY;
-            } else {
-                if (system_vis_it->second < VIS_BASIC_VISIBILITY)
-                    system_vis_it->second = VIS_BASIC_VISIBILITY;
-            }
-
-            system_vis_it = vis_map.find(next);
-            if (system_vis_it == vis_map.end()) {
-                vis_map[next] = VIS_BASIC_VISIBILITY;
-            } else {
-                if (system_vis_it->second < VIS_BASIC_VISIBILITY)
-                    system_vis_it->second = VIS_BASIC_VISIBILITY;
-            }
+            empire_object_visibility.Raise(fleet->Owner(), prev, VIS_BASIC_VISIBILITY);
+            empire_object_visibility.Raise(fleet->Owner(), next, VIS_BASIC_VISIBILITY);
         }
     }
 
     void SetEmpireSpecialVisibilities(const ObjectMap& objects,
-                                      Universe::EmpireObjectVisibilityMap& empire_object_visibility,
+                                      const VisibilityTable& empire_object_visibility,
                                       Universe::EmpireObjectSpecialsMap& empire_object_visible_specials)
     {
         // after setting object visibility, similarly set visibility of objects'
@@ -2764,7 +3091,6 @@ namespace {
              empire_it != Empires().end(); ++empire_it)
         {
             int empire_id = empire_it->first;
-            Universe::ObjectVisibilityMap& obj_vis_map = empire_object_visibility[empire_id];
             Universe::ObjectSpecialsMap& obj_specials_map = empire_object_visible_specials[empire_id];
 
             const Empire* empire = empire_it->second;
@@ -2774,13 +3100,11 @@ namespace {
             double detection_strength = detection_meter->Current();
 
             // every object empire has visibility of might have specials
-            for (Universe::ObjectVisibilityMap::const_iterator obj_it = obj_vis_map.begin();
-                 obj_it != obj_vis_map.end(); ++obj_it)
+            const std::vector<int> visible_object_ids = empire_object_visibility.VisibleObjectIDs(empire_id);
+            for (std::vector<int>::const_iterator obj_it = visible_object_ids.begin();
+                 obj_it != visible_object_ids.end(); ++obj_it)
             {
-                if (obj_it->second <= VIS_NO_VISIBILITY)
-                    continue;
-
-                int object_id = obj_it->first;
+                int object_id = *obj_it;
                 TemporaryPtr<const UniverseObject> obj = objects.Object(object_id);
                 if (!obj)
                     continue;
@@ -2824,7 +3148,7 @@ void Universe::UpdateEmpireObjectVisibilities() {
         { m_empire_known_ship_design_ids[empire_id].insert(*design_it); }
     }
 
-    m_empire_object_visibility.clear();
+    m_empire_object_visibility.Clear();
     m_empire_object_visible_specials.clear();
 
     if (m_all_objects_visible) {
@@ -2835,16 +3159,17 @@ void Universe::UpdateEmpireObjectVisibilities() {
 
     SetEmpireOwnedObjectVisibilities();
 
-    std::map<int, std::map<std::pair<double, double>, float> >
-        empire_position_detection_ranges = GetEmpiresPositionDetectionRanges();
+    // detector grids are built once and used for both object and field
+    // detection
+    std::map<int, DetectorGrid> empire_detector_grids = GetEmpiresDetectorGrids();
 
     std::map<int, std::map<std::pair<double, double>, std::vector<int> > >
         empire_position_potentially_detectable_objects =
             GetEmpiresPositionsPotentiallyDetectableObjects(Objects());
 
-    SetEmpireObjectVisibilitiesFromRanges(empire_position_detection_ranges,
+    SetEmpireObjectVisibilitiesFromRanges(empire_detector_grids,
                                           empire_position_potentially_detectable_objects);
-    SetEmpireFieldVisibilitiesFromRanges(empire_position_detection_ranges, Objects());
+    SetEmpireFieldVisibilitiesFromRanges(empire_detector_grids, Objects());
 
     SetSameSystemPlanetsVisible(Objects());
 
@@ -2857,8 +3182,54 @@ void Universe::UpdateEmpireObjectVisibilities() {
     SetEmpireSpecialVisibilities(Objects(), m_empire_object_visibility, m_empire_object_visible_specials);
 }
 
+namespace {
+    /** The information that UniverseObject::Copy and its overrides use that
+      * depends on the empire an object is copied for. */
+    struct EmpireObjectView {
+        EmpireObjectView(TemporaryPtr<const UniverseObject> obj, int empire_id) :
+            vis(GetUniverse().GetObjectVisibilityByEmpire(obj->ID(), empire_id)),
+            visible_specials(GetUniverse().GetObjectVisibleSpecialsByEmpire(obj->ID(), empire_id)),
+            visible_contained_objects(obj->VisibleContainedObjectIDs(empire_id))
+        {
+            if (TemporaryPtr<const System> system = boost::dynamic_pointer_cast<const System>(obj))
+                visible_starlanes_wormholes = system->VisibleStarlanesWormholes(empire_id);
+        }
+
+        bool operator==(const EmpireObjectView& rhs) const {
+            return vis == rhs.vis &&
+                   visible_specials == rhs.visible_specials &&
+                   visible_contained_objects == rhs.visible_contained_objects &&
+                   visible_starlanes_wormholes == rhs.visible_starlanes_wormholes;
+        }
+
+        Visibility              vis;
+        std::set<std::string>   visible_specials;
+        std::set<int>           visible_contained_objects;
+        std::map<int, bool>     visible_starlanes_wormholes;
+    };
+
+    /** An empire's updated latest known version of an object, and the
+      * version it was updated from. */
+    struct KnownObjectUpdate {
+        KnownObjectUpdate(int empire_id_, ObjectMap& known_object_map_, TemporaryPtr<UniverseObject> previous_,
+                          TemporaryPtr<UniverseObject> updated_) :
+            empire_id(empire_id_),
+            known_object_map(&known_object_map_),
+            previous(previous_),
+            updated(updated_)
+        {}
+
+        int                                 empire_id;
+        ObjectMap*                          known_object_map;
+        TemporaryPtr<UniverseObject>        previous;
+        TemporaryPtr<UniverseObject>        updated;
+        boost::shared_ptr<EmpireObjectView> view;       ///< determined only if another empire had the same previous version
+    };
+}
+
 void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
     //Logger().debugStream() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns()";
+    ScopedTimer timer("Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns", true);
 
     // assumes m_empire_object_visibility has been updated
 
@@ -2871,6 +3242,21 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
     if (current_turn == INVALID_GAME_TURN)
         return;
 
+    // look up each empire's latest known objects once, rather than for each
+    // object it can see
+    const std::vector<int>& empire_ids = m_empire_object_visibility.EmpireIDs();
+    std::vector<ObjectMap*> empire_known_object_maps;
+    for (std::vector<int>::const_iterator empire_it = empire_ids.begin(); empire_it != empire_ids.end(); ++empire_it)
+        empire_known_object_maps.push_back(&m_empire_latest_known_objects[*empire_it]); // creates empty map if none yet present
+
+    // empires that had the same latest known version of an object and have
+    // the same view of it now get the same updated version, which is shared
+    // between their latest known objects until one of them sees the object
+    // differently
+    std::vector<KnownObjectUpdate> object_updates;
+    int num_updated = 0;
+    int num_shared = 0;
+
     // for each object in universe
     for (ObjectMap::const_iterator<> it = m_objects.const_begin(); it != m_objects.const_end(); ++it) {
         int object_id = it->ID();
@@ -2879,17 +3265,13 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
             Logger().errorStream() << "UpdateEmpireLatestKnownObjectsAndVisibilityTurns found null object in m_objects with id " << object_id;
             continue;
         }
+        object_updates.clear();
 
         // for each empire with a visibility map
-        for (EmpireObjectVisibilityMap::const_iterator empire_it = m_empire_object_visibility.begin();
-             empire_it != m_empire_object_visibility.end(); ++empire_it)
-        {
+        for (std::size_t empire_index = 0; empire_index < empire_ids.size(); ++empire_index) {
             // can empire see object?
-            const ObjectVisibilityMap& vis_map = empire_it->second;    // stores level of visibility empire has for each object it can detect this turn
-            ObjectVisibilityMap::const_iterator vis_it = vis_map.find(object_id);
-            if (vis_it == vis_map.end())
-                continue;   // empire can't see current object, so move to next empire
-            const Visibility vis = vis_it->second;
+            int empire_id = empire_ids[empire_index];
+            const Visibility vis = m_empire_object_visibility.Get(empire_id, object_id);
             if (vis <= VIS_NO_VISIBILITY)
                 continue;   // empire can't see current object, so move to next empire
 
@@ -2897,41 +3279,67 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
             // information about object, and historical turns on which object
             // was seen at various visibility levels.
 
-            int empire_id = empire_it->first;
-
-            ObjectMap&                  known_object_map = m_empire_latest_known_objects[empire_id];        // creates empty map if none yet present
-            ObjectVisibilityTurnMap&    object_vis_turn_map = m_empire_object_visibility_turns[empire_id];  // creates empty map if none yet present
-            VisibilityTurnMap&          vis_turn_map = object_vis_turn_map[object_id];                      // creates empty map if none yet present
+            ObjectMap& known_object_map = *empire_known_object_maps[empire_index];
 
 
             // update empire's latest known data about object, based on current visibility and historical visibility and knowledge of object
+            TemporaryPtr<UniverseObject> known_obj = known_object_map.Object(object_id);
+
+            // did another empire have the same latest known version, and
+            // does it see the object the same way now?
+            boost::shared_ptr<EmpireObjectView> view;
+            std::vector<KnownObjectUpdate>::iterator update_it = object_updates.begin();
+            for (; update_it != object_updates.end(); ++update_it) {
+                if (!(update_it->previous == known_obj))
+                    continue;
+                if (!update_it->view)
+                    update_it->view.reset(new EmpireObjectView(full_object, update_it->empire_id));
+                if (!view)
+                    view.reset(new EmpireObjectView(full_object, empire_id));
+                if (*update_it->view == *view)
+                    break;
+            }
 
-            // is there already last known version of an UniverseObject stored for this empire?
-            if (TemporaryPtr<UniverseObject> known_obj = known_object_map.Object(object_id)) {
-                known_obj->Copy(full_object, empire_id);                    // already a stored version of this object for this empire.  update it, limited by visibility this empire has for this object this turn
-            } else {
-                if (UniverseObject* new_obj = full_object->Clone(empire_id))    // no previously-recorded version of this object for this empire.  create a new one, copying only the information limtied by visibility, leaving the rest as default values
-                    known_object_map.Insert(new_obj);
+            if (update_it != object_updates.end()) {
+                // share the other empire's updated version
+                if (!(update_it->updated == known_obj))
+                    known_object_map.Insert(update_it->updated, empire_id);
+                known_object_map.MarkShared(object_id);
+                update_it->known_object_map->MarkShared(object_id);
+                ++num_shared;
+
+            } else if (known_obj) {
+                // already a stored version of this object for this empire.
+                // update it, limited by visibility this empire has for this
+                // object this turn, copying it first if other empires share it
+                TemporaryPtr<UniverseObject> updated_obj = known_object_map.UnsharedObject(object_id, empire_id);
+                updated_obj->Copy(full_object, empire_id);
+                object_updates.push_back(KnownObjectUpdate(empire_id, known_object_map, known_obj, updated_obj));
+                ++num_updated;
+
+            } else if (UniverseObject* new_obj = full_object->Clone(empire_id)) {
+                // no previously-recorded version of this object for this
+                // empire.  create a new one, copying only the information
+                // limtied by visibility, leaving the rest as default values
+                object_updates.push_back(KnownObjectUpdate(empire_id, known_object_map, known_obj,
+                                                           known_object_map.Insert(new_obj, empire_id)));
+                ++num_updated;
             }
 
             //Logger().debugStream() << "Empire " << empire_id << " can see object " << object_id << " with vis level " << vis;
 
             // update empire's visibility turn history for current vis, and lesser vis levels
-            if (vis >= VIS_BASIC_VISIBILITY) {
-                vis_turn_map[VIS_BASIC_VISIBILITY] = current_turn;
-                if (vis >= VIS_PARTIAL_VISIBILITY) {
-                    vis_turn_map[VIS_PARTIAL_VISIBILITY] = current_turn;
-                    if (vis >= VIS_FULL_VISIBILITY) {
-                        vis_turn_map[VIS_FULL_VISIBILITY] = current_turn;
-                    }
-                }
-                //Logger().debugStream() << " ... Setting empire " << empire_id << " object " << full_object->Name() << " (" << object_id << ") vis " << vis << " (and higher) turn to " << current_turn;
-            } else {
-                Logger().errorStream() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() found invalid visibility for object with id " << object_id << " by empire with id " << empire_id;
-                continue;
-            }
+            m_empire_object_visibility_turns.SetSeen(empire_id, object_id, vis, current_turn);
+            //Logger().debugStream() << " ... Setting empire " << empire_id << " object " << full_object->Name() << " (" << object_id << ") vis " << vis << " (and higher) turn to " << current_turn;
         }
     }
+
+    Logger().debugStream() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns updated "
+                           << num_updated << " latest known objects and shared "
+                           << num_shared << " updated objects between empires";
+
+    // empires may now know of starlanes they didn't know of before
+    UpdateEmpireSystemAdjacencies();
 }
 
 void Universe::UpdateEmpireStaleObjectKnowledge() {
@@ -2941,22 +3349,20 @@ void Universe::UpdateEmpireStaleObjectKnowledge() {
     // detectable by that empire, then the latest known state of the objects
     // (including stealth and position) appears to be stale / out of date.
 
-    const std::map<int, std::map<std::pair<double, double>, float> >
-        empire_location_detection_ranges = GetEmpiresPositionDetectionRanges();
+    const std::map<int, DetectorGrid> empire_detector_grids = GetEmpiresDetectorGrids();
 
     for (EmpireObjectMap::iterator empire_it = m_empire_latest_known_objects.begin();
          empire_it != m_empire_latest_known_objects.end(); ++empire_it)
     {
         int empire_id = empire_it->first;
         const ObjectMap& latest_known_objects = empire_it->second;
-        const ObjectVisibilityMap& vis_map = m_empire_object_visibility[empire_id];
         std::set<int>& stale_set = m_empire_stale_knowledge_object_ids[empire_id];
         const std::set<int>& destroyed_set = m_empire_known_destroyed_object_ids[empire_id];
 
         // remove stale marking for any known destroyed or currently visible objects
         for (std::set<int>::iterator stale_it = stale_set.begin(); stale_it != stale_set.end();) {
             int object_id = *stale_it;
-            if (vis_map.find(object_id) != vis_map.end() ||
+            if (m_empire_object_visibility.Has(empire_id, object_id) ||
                 destroyed_set.find(object_id) != destroyed_set.end())
             {
                 stale_set.erase(stale_it++);
@@ -2976,19 +3382,17 @@ void Universe::UpdateEmpireStaleObjectKnowledge() {
                 empires_latest_known_objects_that_should_be_detectable[empire_id];
 
         // get empire detection ranges
-        std::map<int, std::map<std::pair<double, double>, float> >::const_iterator
-            empire_detectors_it = empire_location_detection_ranges.find(empire_id);
-        if (empire_detectors_it == empire_location_detection_ranges.end())
+        std::map<int, DetectorGrid>::const_iterator
+            empire_detectors_it = empire_detector_grids.find(empire_id);
+        if (empire_detectors_it == empire_detector_grids.end())
             continue;
-        const std::map<std::pair<double, double>, float>& empire_detector_positions_ranges =
-            empire_detectors_it->second;
 
         // filter should-be-still-detectable objects by whether they are
         // in range of a detector
         std::vector<int> should_still_be_detectable_latest_known_objects =
             FilterObjectPositionsByDetectorPositionsAndRanges(
                 empire_latest_known_should_be_still_detectable_objects,
-                empire_detector_positions_ranges);
+                empire_detectors_it->second);
 
         // filter to exclude objects that are known to have been destroyed
         FilterObjectIDsByKnownDestruction(should_still_be_detectable_latest_known_objects,
@@ -3003,8 +3407,7 @@ void Universe::UpdateEmpireStaleObjectKnowledge() {
              ++should_still_be_detectable_object_it)
         {
             int object_id = *should_still_be_detectable_object_it;
-            ObjectVisibilityMap::const_iterator vis_it = vis_map.find(object_id);
-            if (vis_it == vis_map.end() || vis_it->second < VIS_BASIC_VISIBILITY) {
+            if (m_empire_object_visibility.Get(empire_id, object_id) < VIS_BASIC_VISIBILITY) {
                 // object not visible even though the latest known info about it
                 // for this empire suggests it should be.  info is stale.
                 stale_set.insert(object_id);
@@ -3055,8 +3458,7 @@ void Universe::UpdateEmpireStaleObjectKnowledge() {
                     continue;
 
                 // is contained ship visible? If so, fleet is not stale.
-                ObjectVisibilityMap::const_iterator vis_it = vis_map.find(ship_id);
-                if (vis_it != vis_map.end() && vis_it->second > VIS_NO_VISIBILITY) {
+                if (m_empire_object_visibility.Get(empire_id, ship_id) > VIS_NO_VISIBILITY) {
                     fleet_stale = false;
                     break;
                 }
@@ -3129,6 +3531,7 @@ void Universe::Destroy(int object_id, bool update_destroyed_object_knowers/* = t
     // signal that an object has been deleted
     UniverseObjectDeleteSignal(obj);
     m_objects.Remove(object_id);
+    InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
 }
 
 std::set<int> Universe::RecursiveDestroy(int object_id) {
@@ -3259,6 +3662,7 @@ bool Universe::Delete(int object_id) {
     obj->MoveTo(UniverseObject::INVALID_POSITION, UniverseObject::INVALID_POSITION);
     // remove from existing objects set
     m_objects.Remove(object_id);
+    InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
 
     // TODO: Should this also remove the object from the latest known objects
     // and known destroyed objects for each empire?
@@ -3300,11 +3704,13 @@ void Universe::InitializeSystemGraph(int for_empire_id) {
         // add record of index in new_graph_impl->system_graph of this system
         m_system_id_to_graph_index[system_id] = system_index;
     }
+    new_graph_impl->system_ids = system_ids;
 
     // add edges for all starlanes
     for (size_t system1_index = 0; system1_index < system_ids.size(); ++system1_index) {
         int system1_id = system_ids[system1_index];
         TemporaryPtr<const System> system1 = GetEmpireKnownSystem(system1_id, for_empire_id);
+        new_graph_impl->system_positions.push_back(std::make_pair(system1->X(), system1->Y()));
 
         // add edges and edge weights
         for (std::map<int, bool>::const_iterator it = system1->StarlanesWormholes().begin();
@@ -3344,16 +3750,112 @@ void Universe::InitializeSystemGraph(int for_empire_id) {
 
     if (graph_changed) {
         new_graph_impl.swap(m_graph_impl);
-        // clear jumps distance cache
-        // NOTE: re-filling the cache is O(#vertices * (#vertices + #edges)) in the worst case!
-        m_system_jumps.resize(system_ids.size());
+        // new_graph_impl now holds the previous graph
+        UpdateSystemJumps(*new_graph_impl);
     }
     UpdateEmpireVisibilityFilteredSystemGraphs(for_empire_id);
 }
 
+void Universe::UpdateSystemJumps(const GraphImpl& old_graph_impl) {
+    typedef boost::graph_traits<GraphImpl::SystemGraph>::edge_iterator EdgeIterator;
+    const GraphImpl::SystemGraph& old_graph = old_graph_impl.system_graph;
+    const GraphImpl::SystemGraph& new_graph = m_graph_impl->system_graph;
+    const size_t num_systems = boost::num_vertices(new_graph);
+
+    boost::unique_lock<boost::shared_mutex> guard(m_system_jumps.m_mutex);
+    std::vector<std::vector<short> >& rows = m_system_jumps.m_data;
+
+    // if the same systems are at the same indices in both graphs, only
+    // starlanes were added or removed, so only the rows of systems whose
+    // jumps distances those lanes could change need to be cleared
+    bool same_systems = num_systems == boost::num_vertices(old_graph) && num_systems == m_system_jumps.size();
+    if (same_systems) {
+        GraphImpl::ConstSystemIDPropertyMap old_ids = boost::get(vertex_system_id_t(), old_graph);
+        GraphImpl::ConstSystemIDPropertyMap new_ids = boost::get(vertex_system_id_t(), new_graph);
+        for (size_t i = 0; i < num_systems && same_systems; ++i)
+            same_systems = old_ids[i] == new_ids[i];
+    }
+
+    if (!same_systems) {
+        // NOTE: re-filling the cache is O(#vertices * (#vertices + #edges)) in the worst case!
+        m_system_jumps.resize(num_systems);
+    } else {
+        std::vector<std::pair<size_t, size_t> > removed_lanes;
+        std::vector<std::pair<size_t, size_t> > added_lanes;
+        EdgeIterator edge_it, edge_end;
+        for (boost::tie(edge_it, edge_end) = boost::edges(old_graph); edge_it != edge_end; ++edge_it) {
+            size_t u = boost::source(*edge_it, old_graph), v = boost::target(*edge_it, old_graph);
+            if (!boost::edge(u, v, new_graph).second)
+                removed_lanes.push_back(std::make_pair(u, v));
+        }
+        for (boost::tie(edge_it, edge_end) = boost::edges(new_graph); edge_it != edge_end; ++edge_it) {
+            size_t u = boost::source(*edge_it, new_graph), v = boost::target(*edge_it, new_graph);
+            if (!boost::edge(u, v, old_graph).second)
+                added_lanes.push_back(std::make_pair(u, v));
+        }
+
+        // a removed lane can only lengthen paths from a system if it is on
+        // a shortest path from it, which needs its ends to be at different
+        // distances.  an added lane can only shorten paths from a system if
+        // its ends are more than one jump apart from its point of view
+        size_t num_cleared = 0;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            std::vector<short>& row = rows[i];
+            if (row.empty())
+                continue;
+            bool affected = false;
+            for (size_t j = 0; j < removed_lanes.size() && !affected; ++j)
+                affected = row[removed_lanes[j].first] != row[removed_lanes[j].second];
+            for (size_t j = 0; j < added_lanes.size() && !affected; ++j)
+            {
+                int difference = int(row[added_lanes[j].first]) - int(row[added_lanes[j].second]);
+                affected = difference > 1 || difference < -1;
+            }
+            if (affected) {
+                std::vector<short>().swap(row);
+                ++num_cleared;
+            }
+        }
+        Logger().debugStream() << "Universe::UpdateSystemJumps: " << removed_lanes.size() << " lanes removed and "
+                               << added_lanes.size() << " lanes added; cleared " << num_cleared << " of "
+                               << num_systems << " cached jumps rows";
+    }
+
+    // for small enough galaxies, fill the whole cache now, in parallel,
+    // instead of one row at a time on first use during turn processing.
+    // clients only need a few rows, so they keep filling them as needed
+    if (!m_precompute_system_jumps || num_systems == 0 ||
+        num_systems > static_cast<size_t>(GetOptionsDB().Get<int>("jump-table-precompute-max-systems")))
+    { return; }
+
+    std::vector<size_t> empty_rows;
+    for (size_t i = 0; i < rows.size(); ++i)
+        if (rows[i].empty())
+            empty_rows.push_back(i);
+    if (empty_rows.empty())
+        return;
+
+    ScopedTimer timer("Universe::UpdateSystemJumps filling " + boost::lexical_cast<std::string>(empty_rows.size()) +
+                      " of " + boost::lexical_cast<std::string>(num_systems) + " rows", true);
+
+    unsigned int num_threads = static_cast<unsigned int>(std::max(1, GetOptionsDB().Get<int>("jump-table-threads")));
+    // a few more work items than threads, to even out the load
+    const size_t num_items = std::min(empty_rows.size(), static_cast<size_t>(num_threads) * 4);
+    RunQueue<FillSystemJumpsRowsWorkItem<GraphImpl::SystemGraph> > run_queue(num_threads);
+    for (size_t item = 0; item < num_items; ++item) {
+        std::vector<size_t> item_rows;
+        for (size_t i = item; i < empty_rows.size(); i += num_items)
+            item_rows.push_back(empty_rows[i]);
+        run_queue.AddWork(new FillSystemJumpsRowsWorkItem<GraphImpl::SystemGraph>(new_graph, rows, item_rows));
+    }
+    run_queue.Wait();
+}
+
 void Universe::UpdateEmpireVisibilityFilteredSystemGraphs(int for_empire_id) {
     m_graph_impl->empire_system_graph_views.clear();
 
+    BuildSystemAdjacency(m_graph_impl->system_graph, m_graph_impl->system_positions, m_graph_impl->system_adjacency);
+
     // if building system graph views for all empires, then each empire's graph
     // should accurately filter for that empire's visibility.  if building
     // graphs for one empire, that empire won't know what systems other empires
@@ -3384,10 +3886,36 @@ void Universe::UpdateEmpireVisibilityFilteredSystemGraphs(int for_empire_id) {
             m_graph_impl->empire_system_graph_views[empire_id] = filtered_graph_ptr;
         }
     }
+
+    UpdateEmpireSystemAdjacencies();
 }
 
-int& Universe::EncodingEmpire()
-{ return m_encoding_empire; }
+void Universe::UpdateEmpireSystemAdjacencies() {
+    m_graph_impl->empire_system_adjacencies.clear();
+    m_graph_impl->shortest_path_cache.Clear();
+
+    // the lanes empires know about are stored when the arrays are built, so
+    // they are rebuilt whenever empires' knowledge of systems changes.
+    // empires that share a view of the system graph share its arrays too
+    std::map<const GraphImpl::EmpireViewSystemGraph*, boost::shared_ptr<const SystemAdjacency> > view_adjacencies;
+    for (GraphImpl::EmpireViewSystemGraphMap::const_iterator it = m_graph_impl->empire_system_graph_views.begin();
+         it != m_graph_impl->empire_system_graph_views.end(); ++it)
+    {
+        boost::shared_ptr<const SystemAdjacency>& adjacency_ptr = view_adjacencies[it->second.get()];
+        if (!adjacency_ptr) {
+            boost::shared_ptr<SystemAdjacency> new_adjacency_ptr(new SystemAdjacency());
+            BuildSystemAdjacency(*it->second, m_graph_impl->system_positions, *new_adjacency_ptr);
+            adjacency_ptr = new_adjacency_ptr;
+        }
+        m_graph_impl->empire_system_adjacencies[it->first] = adjacency_ptr;
+    }
+}
+
+int& Universe::EncodingEmpire() {
+    if (!m_encoding_empire.get())
+        m_encoding_empire.reset(new int(ALL_EMPIRES));
+    return *m_encoding_empire;
+}
 
 double Universe::UniverseWidth() const
 { return m_universe_width; }
@@ -3398,6 +3926,16 @@ const bool& Universe::UniverseObjectSignalsInhibited()
 void Universe::InhibitUniverseObjectSignals(bool inhibit)
 { m_inhibit_universe_object_signals = inhibit; }
 
+void Universe::InvalidateObjectCaches(unsigned int changed_dependencies) {
+    if (changed_dependencies & (Condition::DEPENDS_ON_OWNER | Condition::DEPENDS_ON_SPECIES))
+        m_objects.InvalidateObjectIndexes();
+    if (changed_dependencies == Condition::DEPENDS_ON_ANYTHING) {
+        m_effects_targets_cache.clear();
+        m_effects_targets_cache_valid = false;
+    }
+    m_effects_targets_cache_changes |= changed_dependencies;
+}
+
 namespace {
     // Looks like there are at least 4 SourceForEmpire functions lying around:
     // one in ShipDesign, one in Tech, one in Building, one here...
@@ -3531,7 +4069,42 @@ void Universe::GetObjectsToSerialize(ObjectMap& objects, int encoding_empire) co
         bool map_avail = (destroyed_ids_it != m_empire_known_destroyed_object_ids.end());
         const std::set<int>& destroyed_object_ids = map_avail ? destroyed_ids_it->second : std::set<int>();
 
-        objects.AuditContainment(destroyed_object_ids);
+        // objects holds the empire's latest known objects themselves, which
+        // may be serialized for other empires at the same time, so any that
+        // are inconsistent are copied before they are fixed
+        objects.AuditContainment(destroyed_object_ids, true, encoding_empire);
+    }
+}
+
+void Universe::MarkSharedEmpireKnownObjects() {
+    // count the empires that hold each object
+    std::map<const UniverseObject*, int> num_holders;
+    for (EmpireObjectMap::const_iterator it = m_empire_latest_known_objects.begin();
+         it != m_empire_latest_known_objects.end(); ++it)
+    {
+        for (ObjectMap::const_iterator<> obj_it = it->second.const_begin(); obj_it != it->second.const_end(); ++obj_it)
+            ++num_holders[(*obj_it).get()];
+    }
+
+    for (EmpireObjectMap::iterator it = m_empire_latest_known_objects.begin();
+         it != m_empire_latest_known_objects.end(); ++it)
+    {
+        for (ObjectMap::const_iterator<> obj_it = it->second.const_begin(); obj_it != it->second.const_end(); ++obj_it)
+            if (num_holders[(*obj_it).get()] > 1)
+                it->second.MarkShared(obj_it->ID());
+    }
+}
+
+void Universe::AuditEmpireLatestKnownObjects() {
+    for (EmpireObjectMap::iterator it = m_empire_latest_known_objects.begin();
+         it != m_empire_latest_known_objects.end(); ++it)
+    {
+        ObjectKnowledgeMap::const_iterator destroyed_ids_it =
+            m_empire_known_destroyed_object_ids.find(it->first);
+        bool map_avail = (destroyed_ids_it != m_empire_known_destroyed_object_ids.end());
+        const std::set<int>& destroyed_object_ids = map_avail ? destroyed_ids_it->second : std::set<int>();
+
+        it->second.AuditContainment(destroyed_object_ids, false, it->first);
     }
 }
 
@@ -3580,7 +4153,7 @@ void Universe::GetEmpireKnownObjectsToSerialize(EmpireObjectMap& empire_latest_k
 
 void Universe::GetEmpireObjectVisibilityMap(EmpireObjectVisibilityMap& empire_object_visibility, int encoding_empire) const {
     if (encoding_empire == ALL_EMPIRES) {
-        empire_object_visibility = m_empire_object_visibility;
+        empire_object_visibility = m_empire_object_visibility.ToMap(ALL_EMPIRES);
         return;
     }
 
@@ -3597,16 +4170,8 @@ void Universe::GetEmpireObjectVisibilityMap(EmpireObjectVisibilityMap& empire_ob
 }
 
 void Universe::GetEmpireObjectVisibilityTurnMap(EmpireObjectVisibilityTurnMap& empire_object_visibility_turns, int encoding_empire) const {
-    if (encoding_empire == ALL_EMPIRES) {
-        empire_object_visibility_turns = m_empire_object_visibility_turns;
-        return;
-    }
-
-    // include just requested empire's visibility turn information
-    empire_object_visibility_turns.clear();
-    EmpireObjectVisibilityTurnMap::const_iterator it = m_empire_object_visibility_turns.find(encoding_empire);
-    if (it != m_empire_object_visibility_turns.end())
-        empire_object_visibility_turns[encoding_empire] = it->second;
+    // include all empires' or just requested empire's visibility turn information
+    empire_object_visibility_turns = m_empire_object_visibility_turns.ToMap(encoding_empire);
 }
 
 void Universe::GetEmpireKnownDestroyedObjects(ObjectKnowledgeMap& empire_known_destroyed_object_ids, int encoding_empire) const {
@@ -3645,6 +4210,7 @@ void Universe::GetEmpireStaleKnowledgeObjects(ObjectKnowledgeMap& empire_stale_k
 
 template <class T>
 TemporaryPtr<T> Universe::InsertNewObject(T* object) {
+    InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
     m_objects.Insert(object);
     return m_objects.Object<T>(object->ID());
 }
@@ -3693,7 +4259,8 @@ TemporaryPtr<Field> Universe::CreateField(const std::string& field_type, double
 
 void Universe::ResetUniverse() {
     m_objects.Clear();  // wipe out anything present in the object map
-    
+    InvalidateObjectCaches(Condition::DEPENDS_ON_ANYTHING);
+
     // these happen to be equal to INVALID_OBJECT_ID and INVALID_DESIGN_ID,
     // but the point here is that the latest used ID is incremented before
     // being assigned, so using -1 here means the first assigned ID will be 0,
@@ -4,13 +4,15 @@
 
 #include "Enums.h"
 #include "ObjectMap.h"
-#include "TemporaryPtr.h"
+#include "ObjectHandle.h"
+#include "VisibilityTable.h"
 
 #include <boost/signals2/signal.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/tss.hpp>
 
 #include <vector>
 #include <list>
@@ -34,7 +36,7 @@ class UniverseObject;
 class System;
 namespace Condition {
     struct ConditionBase;
-    typedef std::vector<TemporaryPtr<const UniverseObject> > ObjectSet;
+    typedef std::vector<ObjectHandle<const UniverseObject> > ObjectSet;
 }
 
 namespace Effect {
@@ -42,10 +44,11 @@ namespace Effect {
     struct TargetsAndCause;
     struct SourcedEffectsGroup;
     class EffectsGroup;
-    typedef std::vector<TemporaryPtr<UniverseObject> > TargetSet;
+    typedef std::vector<ObjectHandle<UniverseObject> > TargetSet;
     typedef std::map<int, std::map<MeterType, std::vector<AccountingInfo> > > AccountingMap;
     typedef std::vector<std::pair<SourcedEffectsGroup, TargetsAndCause> > TargetsCauses;
     typedef std::map<int, std::map<MeterType, double> > DiscrepancyMap;
+    typedef std::map<std::pair<const EffectsGroup*, int>, TargetSet> TargetsCache;
 }
 
 /** The Universe class contains the majority of FreeOrion gamestate: All the
@@ -142,8 +145,7 @@ public:
       * UniverseObject with id \a object_id .  The returned map may be empty or
       * not have entries for all visibility levels, if the empire has not seen
       * the object at that visibility level yet. */
-    const VisibilityTurnMap&
-                            GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const;
+    VisibilityTurnMap       GetObjectVisibilityTurnMapByEmpire(int object_id, int empire_id) const;
 
     /** Returns the set of specials attached to the object with id \a object_id
       * that the empire with id \a empire_id can see this turn. */
@@ -316,6 +318,12 @@ public:
       * be seen by the empire, updates the latest known state to note this. */
     void            UpdateEmpireStaleObjectKnowledge();
 
+    /** Makes the containment information of each empire's latest known
+      * objects consistent with the objects known to that empire.  Serializing
+      * the Universe for an empire otherwise fixes up copies of inconsistent
+      * objects each time. */
+    void            AuditEmpireLatestKnownObjects();
+
     /** Fills pathfinding data structure and determines least jumps distances
       * between systems for the empire with id \a for_empire_id or uses the
       * main / true / visible objects if \a for_empire_id is ALL_EMPIRES*/
@@ -375,6 +383,14 @@ public:
       * is true, and (re)enables UniverseObjectSignals if \a inhibit is false. */
     void            InhibitUniverseObjectSignals(bool inhibit = true);
 
+    /** Notes that object properties indicated by \a changed_dependencies (a
+      * combination of Condition::Dependency flags) have changed, so that
+      * effects targets depending on them are not reused from the last full
+      * meter estimate update, and the object indexes of the ObjectMap are
+      * rebuilt if owners or species changed.  Condition::DEPENDS_ON_ANYTHING
+      * drops all cached targets. */
+    void            InvalidateObjectCaches(unsigned int changed_dependencies);
+
     void            UpdateStatRecords();
     //@}
 
@@ -394,13 +410,21 @@ public:
       * Universe, so that only the relevant parts of the Universe are
       * serialized.  The use of this global variable is done just so I don't
       * have to rewrite any custom boost::serialization classes that implement
-      * empire-dependent visibility. */
+      * empire-dependent visibility.  The encoding empire is kept separately
+      * for each thread, so that several threads can serialize the Universe
+      * for different empires at the same time. */
     int&            EncodingEmpire();
 
     double          UniverseWidth() const;
     void            SetUniverseWidth(double width) { m_universe_width = width; }
     bool            AllObjectsVisible() const { return m_all_objects_visible; }
 
+    /** Sets whether the jumps between all pairs of systems are computed as
+      * soon as the system graph changes, for galaxies that aren't too big
+      * (see UpdateSystemJumps()), rather than as needed.  Only the server,
+      * which needs most of them each turn, does so. */
+    void            SetPrecomputeSystemJumps(bool precompute) { m_precompute_system_jumps = precompute; }
+
     /** \name Generators */ //@{
     TemporaryPtr<Ship> CreateShip(int id = INVALID_OBJECT_ID);
     TemporaryPtr<Ship> CreateShip(int empire_id, int design_id, const std::string& species_name,
@@ -467,6 +491,19 @@ private:
 
     struct GraphImpl;
 
+    /** Rebuilds the starlane arrays that ShortestPath searches for each
+      * empire's view of the system graph, and clears its cached results.
+      * The views depend on what empires know of systems, so this is done
+      * whenever that knowledge is updated. */
+    void    UpdateEmpireSystemAdjacencies();
+
+    /** Clears the rows of the jumps distance cache that the differences
+      * between \a old_graph_impl and the current system graph could have
+      * made wrong, and then, if jumps are precomputed (see
+      * SetPrecomputeSystemJumps()), fills the whole cache if there are few
+      * enough systems for that to be worthwhile. */
+    void    UpdateSystemJumps(const GraphImpl& old_graph_impl);
+
     /** Clears \a targets_causes, and then populates with all
       * EffectsGroups and their targets in the known universe. */
     void    GetEffectsAndTargets(Effect::TargetsCauses& targets_causes);
@@ -478,6 +515,15 @@ private:
     void    GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
                                  const std::vector<int>& target_objects);
 
+    /** As above.  If \a use_targets_cache is true and \a target_objects is
+      * empty, the targets found are stored in m_effects_targets_cache.  If
+      * \a use_targets_cache is true and \a target_objects is not empty, the
+      * cached targets of scopes that do not depend on anything changed since
+      * then are reused instead of evaluating the scopes again. */
+    void    GetEffectsAndTargets(Effect::TargetsCauses& targets_causes,
+                                 const std::vector<int>& target_objects,
+                                 bool use_targets_cache);
+
     /** Executes all effects.  For use on server when processing turns.
       * If \a only_meter_effects is true, then only SetMeter effects are
       * executed.  This is useful on server or clients to update meter
@@ -500,8 +546,8 @@ private:
 
     std::set<int>                   m_destroyed_object_ids;             ///< all ids of objects that have been destroyed (on server) or that a player knows were destroyed (on clients)
 
-    EmpireObjectVisibilityMap       m_empire_object_visibility;         ///< map from empire id to (map from object id to visibility of that object for that empire)
-    EmpireObjectVisibilityTurnMap   m_empire_object_visibility_turns;   ///< map from empire id to (map from object id to (map from Visibility rating to turn number on which the empire last saw the object at the indicated Visibility rating or higher)
+    VisibilityTable                 m_empire_object_visibility;         ///< visibility of each object for each empire
+    VisibilityTurnTable             m_empire_object_visibility_turns;   ///< for each empire and object, the turn numbers on which the empire last saw the object at each Visibility rating or higher
 
     EmpireObjectSpecialsMap         m_empire_object_visible_specials;   ///< map from empire id to (map from object id to (set of names of specials that empire can see are on that object) )
 
@@ -519,6 +565,10 @@ private:
     Effect::AccountingMap           m_effect_accounting_map;            ///< map from target object id, to map from target meter, to orderered list of structs with details of an effect and what it does to the meter
     Effect::DiscrepancyMap          m_effect_discrepancy_map;           ///< map from target object id, to map from target meter, to discrepancy between meter's actual initial value, and the initial value that this meter should have as far as the client can tell: the unknown factor affecting the meter
 
+    Effect::TargetsCache            m_effects_targets_cache;            ///< targets of all effects groups and sources as of the last full meter estimate update
+    bool                            m_effects_targets_cache_valid;      ///< false if m_effects_targets_cache must not be used at all
+    unsigned int                    m_effects_targets_cache_changes;    ///< Condition::Dependency flags of object properties changed since m_effects_targets_cache was filled
+
     int                             m_last_allocated_object_id;
     int                             m_last_allocated_design_id;
 
@@ -527,8 +577,9 @@ private:
 
     double                          m_universe_width;
     bool                            m_inhibit_universe_object_signals;
-    int                             m_encoding_empire;                  ///< used during serialization to globally set what empire knowledge to use
+    boost::thread_specific_ptr<int> m_encoding_empire;                  ///< used during serialization to set what empire knowledge to use, separately for each thread
     bool                            m_all_objects_visible;              ///< flag set to skip visibility tests and make everything visible to all players
+    bool                            m_precompute_system_jumps;          ///< flag set to fill the jumps distance cache whenever the system graph changes, instead of filling rows as they are needed
 
     std::map<std::string, std::map<int, std::map<int, double> > >
                                     m_stat_records;                     ///< storage for statistics calculated for empires. Indexed by stat name (string), contains a map indexed by empire id, contains a map from turn number (int) to stat value (double).
@@ -553,6 +604,12 @@ private:
       * knowledge is included. */
     void    GetEmpireKnownObjectsToSerialize(EmpireObjectMap& empire_latest_known_objects, int encoding_empire) const;
 
+    /** Marks objects that are held by more than one empire's latest known
+      * objects as shared in each of those ObjectMaps (see
+      * ObjectMap::MarkShared).  Saved games keep shared objects shared, so
+      * this is done after loading one. */
+    void    MarkSharedEmpireKnownObjects();
+
     /***/
     void    GetEmpireObjectVisibilityMap(EmpireObjectVisibilityMap& empire_object_visibility, int encoding_empire) const;
 
@@ -5,6 +5,7 @@
 #include "Meter.h"
 #include "System.h"
 #include "Special.h"
+#include "Condition.h"
 #include "Universe.h"
 #include "Predicates.h"
 
@@ -59,19 +60,17 @@ void UniverseObject::Copy(TemporaryPtr<const UniverseObject> copied_object, Visi
         return;
     }
 
-    std::map<MeterType, Meter> censored_meters = copied_object->CensoredMeters(vis);
-    for (std::map<MeterType, Meter>::const_iterator it = copied_object->m_meters.begin();
-         it != copied_object->m_meters.end(); ++it)
-    {
-        MeterType type = it->first;
+    MeterMap censored_meters = copied_object->CensoredMeters(vis);
+    for (MeterType type = MeterType(0); type != NUM_METER_TYPES; type = MeterType(type + 1)) {
+        if (!copied_object->m_meters.Has(type))
+            continue;
 
         // get existing meter in this object, or create a default one
         Meter& this_meter = this->m_meters[type];
 
         // if there is an update to meter from censored meters, update this object's copy
-        std::map<MeterType, Meter>::const_iterator censored_it = censored_meters.find(type);
-        if (censored_it != censored_meters.end())
-            this_meter = censored_it->second;
+        if (const Meter* censored_meter = censored_meters.Get(type))
+            this_meter = *censored_meter;
     }
 
     if (vis >= VIS_BASIC_VISIBILITY) {
@@ -169,9 +168,10 @@ std::string UniverseObject::Dump() const {
     for (std::map<std::string, int>::const_iterator it = m_specials.begin(); it != m_specials.end(); ++it)
         os << "(" << it->first << ", " << it->second << ") ";
     os << "  Meters: ";
-    for (std::map<MeterType, Meter>::const_iterator it = m_meters.begin(); it != m_meters.end(); ++it)
-        os << UserString(EnumToString(it->first))
-           << ": " << it->second.Dump() << "  ";
+    for (MeterType type = MeterType(0); type != NUM_METER_TYPES; type = MeterType(type + 1))
+        if (const Meter* meter = m_meters.Get(type))
+            os << UserString(EnumToString(type))
+               << ": " << meter->Dump() << "  ";
     return os.str();
 }
 
@@ -203,27 +203,23 @@ bool UniverseObject::Contains(int object_id) const
 bool UniverseObject::ContainedBy(int object_id) const
 { return false; }
 
-const Meter* UniverseObject::GetMeter(MeterType type) const {
-    std::map<MeterType, Meter>::const_iterator it = m_meters.find(type);
-    if (it != m_meters.end())
-        return &(it->second);
-    return 0;
-}
+const Meter* UniverseObject::GetMeter(MeterType type) const
+{ return m_meters.Get(type); }
 
 float UniverseObject::CurrentMeterValue(MeterType type) const {
-    std::map<MeterType, Meter>::const_iterator it = m_meters.find(type);
-    if (it == m_meters.end())
+    const Meter* meter = m_meters.Get(type);
+    if (!meter)
         throw std::invalid_argument("UniverseObject::CurrentMeterValue was passed a MeterType that this UniverseObject does not have");
 
-    return it->second.Current();
+    return meter->Current();
 }
 
 float UniverseObject::InitialMeterValue(MeterType type) const {
-    std::map<MeterType, Meter>::const_iterator it = m_meters.find(type);
-    if (it == m_meters.end())
+    const Meter* meter = m_meters.Get(type);
+    if (!meter)
         throw std::invalid_argument("UniverseObject::InitialMeterValue was passed a MeterType that this UniverseObject does not have");
 
-    return it->second.Initial();
+    return meter->Initial();
 }
 
 float UniverseObject::NextTurnCurrentMeterValue(MeterType type) const
@@ -285,15 +281,12 @@ void UniverseObject::MoveTo(double x, double y) {
     m_x = x;
     m_y = y;
 
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_LOCATION);
     StateChangedSignal();
 }
 
-Meter* UniverseObject::GetMeter(MeterType type) {
-    std::map<MeterType, Meter>::iterator it = m_meters.find(type);
-    if (it != m_meters.end())
-        return &(it->second);
-    return 0;
-}
+Meter* UniverseObject::GetMeter(MeterType type)
+{ return m_meters.Get(type); }
 
 void UniverseObject::BackPropegateMeters() {
     for (MeterType i = MeterType(0); i != NUM_METER_TYPES; i = MeterType(i + 1))
@@ -304,6 +297,7 @@ void UniverseObject::BackPropegateMeters() {
 void UniverseObject::SetOwner(int id) {
     if (m_owner_empire_id != id) {
         m_owner_empire_id = id;
+        GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_OWNER);
         StateChangedSignal();
     }
     /* TODO: if changing object ownership gives an the new owner an
@@ -315,18 +309,23 @@ void UniverseObject::SetSystem(int sys) {
     //Logger().debugStream() << "UniverseObject::SetSystem(int sys)";
     if (sys != m_system_id) {
         m_system_id = sys;
+        GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_LOCATION);
         StateChangedSignal();
     }
 }
 
-void UniverseObject::AddSpecial(const std::string& name)
-{ m_specials[name] = CurrentTurn(); }
+void UniverseObject::AddSpecial(const std::string& name) {
+    m_specials[name] = CurrentTurn();
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_SPECIALS);
+}
 
-void UniverseObject::RemoveSpecial(const std::string& name)
-{ m_specials.erase(name); }
+void UniverseObject::RemoveSpecial(const std::string& name) {
+    m_specials.erase(name);
+    GetUniverse().InvalidateObjectCaches(Condition::DEPENDS_ON_SPECIALS);
+}
 
-std::map<MeterType, Meter> UniverseObject::CensoredMeters(Visibility vis) const {
-    std::map<MeterType, Meter> retval;
+MeterMap UniverseObject::CensoredMeters(Visibility vis) const {
+    MeterMap retval;
     if (vis >= VIS_PARTIAL_VISIBILITY)
         retval = m_meters;
     return retval;
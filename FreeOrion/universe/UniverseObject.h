@@ -4,6 +4,7 @@
 
 
 #include "Enums.h"
+#include "MeterMap.h"
 #include "TemporaryPtr.h"
 #include "EnableTemporaryFromThis.h"
 #include "../util/Export.h"
@@ -18,7 +19,6 @@
 #include <string>
 #include <vector>
 
-class Meter;
 class System;
 class SitRepEntry;
 struct UniverseObjectVisitor;
@@ -77,7 +77,7 @@ public:
 
     std::set<int>               VisibleContainedObjectIDs(int empire_id) const; ///< returns the subset of contained object IDs that is visible to empire with id \a empire_id
 
-    const std::map<MeterType, Meter>&   Meters() const { return m_meters; }     ///< returns this UniverseObject's meters
+    const MeterMap&             Meters() const { return m_meters; }             ///< returns this UniverseObject's meters
     const Meter*                GetMeter(MeterType type) const;                 ///< returns the requested Meter, or 0 if no such Meter of that type is found in this object
     float                       CurrentMeterValue(MeterType type) const;        ///< returns current value of the specified meter \a type
     float                       InitialMeterValue(MeterType type) const;        ///< returns this turn's initial value for the speicified meter \a type
@@ -117,8 +117,7 @@ public:
     void                    MoveTo(double x, double y);
 
 
-    std::map<MeterType, Meter>&
-                            Meters() { return m_meters; }           ///< returns this UniverseObject's meters
+    MeterMap&               Meters() { return m_meters; }           ///< returns this UniverseObject's meters
     Meter*                  GetMeter(MeterType type);               ///< returns the requested Meter, or 0 if no such Meter of that type is found in this object
     void                    BackPropegateMeters();                  ///< sets all this UniverseObject's meters' initial values equal to their current values
 
@@ -183,7 +182,7 @@ protected:
     std::string                 m_name;
 
 private:
-    std::map<MeterType, Meter>  CensoredMeters(Visibility vis) const;   ///< returns set of meters of this object that are censored based on the specified Visibility \a vis
+    MeterMap                    CensoredMeters(Visibility vis) const;   ///< returns set of meters of this object that are censored based on the specified Visibility \a vis
 
     int                         m_id;
     double                      m_x;
@@ -191,7 +190,7 @@ private:
     int                         m_owner_empire_id;
     int                         m_system_id;
     std::map<std::string, int>  m_specials;
-    std::map<MeterType, Meter>  m_meters;
+    MeterMap                    m_meters;
     int                         m_created_on_turn;
 
     friend class boost::serialization::access;
@@ -21,13 +21,40 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/thread/once.hpp>
+#include <boost/thread/tss.hpp>
 
 
 std::string DoubleToString(double val, int digits, bool always_show_sign);
 
 namespace {
-    TemporaryPtr<const UniverseObject> FollowReference(std::vector<std::string>::const_iterator first,
-                                                       std::vector<std::string>::const_iterator last,
+    // counted separately for each thread, as content files may be parsed in
+    // several threads at once
+    boost::thread_specific_ptr<unsigned int>    s_folded_operations;
+
+    /** Evaluates \a operand of a double Operation for all of \a targets, as
+      * ValueRefBase::EvalForTargets does, but avoids doing so separately for
+      * each target when that isn't necessary. */
+    void EvalOperandForTargets(const ValueRef::ValueRefBase<double>* operand,
+                               const ScriptingContext& context,
+                               const std::vector<ObjectHandle<UniverseObject> >& targets,
+                               std::vector<double>& values)
+    {
+        // the "Value" variable evaluates to the values already in the buffer
+        if (typeid(*operand) == typeid(ValueRef::Variable<double>) &&
+            static_cast<const ValueRef::Variable<double>*>(operand)->GetReferenceType() == ValueRef::EFFECT_TARGET_VALUE_REFERENCE)
+        { return; }
+
+        if (operand->TargetInvariant()) {
+            std::fill(values.begin(), values.end(), operand->Eval(context));
+            return;
+        }
+
+        operand->EvalForTargets(context, targets, values);
+    }
+
+    ObjectHandle<const UniverseObject> FollowReference(std::vector<ValueRef::VariableProperty>::const_iterator first,
+                                                       std::vector<ValueRef::VariableProperty>::const_iterator last,
                                                        ValueRef::ReferenceType ref_type,
                                                        const ScriptingContext& context)
     {
@@ -36,7 +63,7 @@ namespace {
         //    << " local c: " << (context.condition_local_candidate ? context.condition_local_candidate->Name() : "0")
         //    << " root c: " << (context.condition_root_candidate ? context.condition_root_candidate->Name() : "0");
 
-        TemporaryPtr<const UniverseObject> obj;
+        ObjectHandle<const UniverseObject> obj;
         switch(ref_type) {
         case ValueRef::NON_OBJECT_REFERENCE:                    return context.condition_local_candidate;   break;
         case ValueRef::SOURCE_REFERENCE:                        obj = context.source;                       break;
@@ -47,32 +74,40 @@ namespace {
         }
 
         while (first != last) {
-            std::string property_name = *first;
-            if (property_name == "Planet") {
-                if (TemporaryPtr<const Building> b = boost::dynamic_pointer_cast<const Building>(obj))
+            switch (*first) {
+            case ValueRef::PROPERTY_PLANET:
+                if (ObjectHandle<const Building> b = boost::dynamic_pointer_cast<const Building>(obj))
                     obj = GetPlanet(b->PlanetID());
                 else
-                    obj = TemporaryPtr<const UniverseObject>();
-            } else if (property_name == "System") {
+                    obj = ObjectHandle<const UniverseObject>();
+                break;
+            case ValueRef::PROPERTY_SYSTEM:
                 if (obj)
                     obj = GetSystem(obj->SystemID());
-            } else if (property_name == "Fleet") {
-                if (TemporaryPtr<const Ship> s = boost::dynamic_pointer_cast<const Ship>(obj))
+                break;
+            case ValueRef::PROPERTY_FLEET:
+                if (ObjectHandle<const Ship> s = boost::dynamic_pointer_cast<const Ship>(obj))
                     obj = GetFleet(s->FleetID());
                 else
-                    obj = TemporaryPtr<const UniverseObject>();
+                    obj = ObjectHandle<const UniverseObject>();
+                break;
+            default:
+                break;
             }
             ++first;
         }
         return obj;
     }
 
+    ValueRef::VariableProperty LastProperty(const std::vector<ValueRef::VariableProperty>& properties)
+    { return properties.empty() ? ValueRef::INVALID_VARIABLE_PROPERTY : properties.back(); }
+
     // Generates a debug  trace that can be included in error logs, augmenting the ReconstructName() info with
     // additional info identifying the object references that were successfully followed.
     std::string TraceReference(const std::vector<std::string>& property_name, ValueRef::ReferenceType ref_type,
                                                        const ScriptingContext& context)
     {
-        TemporaryPtr<const UniverseObject> obj;
+        ObjectHandle<const UniverseObject> obj;
         std::string retval = ReconstructName(property_name, ref_type) + " :  ";
         switch(ref_type) {
         case ValueRef::NON_OBJECT_REFERENCE:
@@ -108,22 +143,22 @@ namespace {
             std::string property_name = *first;
             retval += " " + property_name;
             if (property_name == "Planet") {
-                if (TemporaryPtr<const Building> b = boost::dynamic_pointer_cast<const Building>(obj)) {
+                if (ObjectHandle<const Building> b = boost::dynamic_pointer_cast<const Building>(obj)) {
                     retval += " (" + boost::lexical_cast<std::string>(b->PlanetID()) + "): ";
                     obj = GetPlanet(b->PlanetID());
                 } else
-                    obj = TemporaryPtr<const UniverseObject>();
+                    obj = ObjectHandle<const UniverseObject>();
             } else if (property_name == "System") {
                 if (obj) {
                     retval += " (" + boost::lexical_cast<std::string>(obj->SystemID()) + "): ";
                     obj = GetSystem(obj->SystemID());
                 }
             } else if (property_name == "Fleet") {
-                if (TemporaryPtr<const Ship> s = boost::dynamic_pointer_cast<const Ship>(obj))  {
+                if (ObjectHandle<const Ship> s = boost::dynamic_pointer_cast<const Ship>(obj))  {
                     retval += " (" + boost::lexical_cast<std::string>(s->FleetID()) + "): ";
                     obj = GetFleet(s->FleetID());
                 } else
-                    obj = TemporaryPtr<const UniverseObject>();
+                    obj = ObjectHandle<const UniverseObject>();
             }
             ++first;
             if (obj) {
@@ -155,53 +190,139 @@ namespace {
 }
 
 namespace {
+    std::map<std::string, MeterType> meter_name_map;
+    boost::once_flag meter_name_map_once = BOOST_ONCE_INIT;
+
+    void InitMeterNameMap() {
+        meter_name_map["Population"] =         METER_POPULATION;
+        meter_name_map["TargetPopulation"] =   METER_TARGET_POPULATION;
+        meter_name_map["Industry"] =           METER_INDUSTRY;
+        meter_name_map["TargetIndustry"] =     METER_TARGET_INDUSTRY;
+        meter_name_map["Research"] =           METER_RESEARCH;
+        meter_name_map["TargetResearch"] =     METER_TARGET_RESEARCH;
+        meter_name_map["Trade"] =              METER_TRADE;
+        meter_name_map["TargetTrade"] =        METER_TARGET_TRADE;
+        meter_name_map["Construction"] =       METER_CONSTRUCTION;
+        meter_name_map["TargetConstruction"] = METER_TARGET_CONSTRUCTION;
+        meter_name_map["Happiness"] =          METER_HAPPINESS;
+        meter_name_map["TargetHappiness"] =    METER_TARGET_HAPPINESS;
+        meter_name_map["MaxFuel"] =            METER_MAX_FUEL;
+        meter_name_map["Fuel"] =               METER_FUEL;
+        meter_name_map["MaxStructure"] =       METER_MAX_STRUCTURE;
+        meter_name_map["Structure"] =          METER_STRUCTURE;
+        meter_name_map["MaxShield"] =          METER_MAX_SHIELD;
+        meter_name_map["Shield"] =             METER_SHIELD;
+        meter_name_map["MaxDefense"] =         METER_MAX_DEFENSE;
+        meter_name_map["Defense"] =            METER_DEFENSE;
+        meter_name_map["MaxTroops"] =          METER_MAX_TROOPS;
+        meter_name_map["Troops"] =             METER_TROOPS;
+        meter_name_map["RebelTroops"] =        METER_REBEL_TROOPS;
+        meter_name_map["Supply"] =             METER_SUPPLY;
+        meter_name_map["MaxSupply"] =          METER_MAX_SUPPLY;
+        meter_name_map["Stealth"] =            METER_STEALTH;
+        meter_name_map["Detection"] =          METER_DETECTION;
+        meter_name_map["BattleSpeed"] =        METER_BATTLE_SPEED;
+        meter_name_map["StarlaneSpeed"] =      METER_STARLANE_SPEED;
+        meter_name_map["Damage"] =             METER_DAMAGE;
+        meter_name_map["ROF"] =                METER_ROF;
+        meter_name_map["Range"] =              METER_RANGE;
+        meter_name_map["Speed"] =              METER_SPEED;
+        meter_name_map["Capacity"] =           METER_CAPACITY;
+        meter_name_map["AntiShipDamage"] =     METER_ANTI_SHIP_DAMAGE;
+        meter_name_map["AntiFighterDamage"] =  METER_ANTI_FIGHTER_DAMAGE;
+        meter_name_map["LaunchRate"] =         METER_LAUNCH_RATE;
+        meter_name_map["FighterWeaponRange"] = METER_FIGHTER_WEAPON_RANGE;
+        meter_name_map["Size"] =               METER_SIZE;
+    }
+
+    /** Variables are constructed concurrently by the parse workers, so the
+      * map is filled only once, before any of them reads it. */
     const std::map<std::string, MeterType>& GetMeterNameMap() {
-        static std::map<std::string, MeterType> meter_name_map;
-        if (meter_name_map.empty()) {
-            meter_name_map["Population"] =         METER_POPULATION;
-            meter_name_map["TargetPopulation"] =   METER_TARGET_POPULATION;
-            meter_name_map["Industry"] =           METER_INDUSTRY;
-            meter_name_map["TargetIndustry"] =     METER_TARGET_INDUSTRY;
-            meter_name_map["Research"] =           METER_RESEARCH;
-            meter_name_map["TargetResearch"] =     METER_TARGET_RESEARCH;
-            meter_name_map["Trade"] =              METER_TRADE;
-            meter_name_map["TargetTrade"] =        METER_TARGET_TRADE;
-            meter_name_map["Construction"] =       METER_CONSTRUCTION;
-            meter_name_map["TargetConstruction"] = METER_TARGET_CONSTRUCTION;
-            meter_name_map["Happiness"] =          METER_HAPPINESS;
-            meter_name_map["TargetHappiness"] =    METER_TARGET_HAPPINESS;
-            meter_name_map["MaxFuel"] =            METER_MAX_FUEL;
-            meter_name_map["Fuel"] =               METER_FUEL;
-            meter_name_map["MaxStructure"] =       METER_MAX_STRUCTURE;
-            meter_name_map["Structure"] =          METER_STRUCTURE;
-            meter_name_map["MaxShield"] =          METER_MAX_SHIELD;
-            meter_name_map["Shield"] =             METER_SHIELD;
-            meter_name_map["MaxDefense"] =         METER_MAX_DEFENSE;
-            meter_name_map["Defense"] =            METER_DEFENSE;
-            meter_name_map["MaxTroops"] =          METER_MAX_TROOPS;
-            meter_name_map["Troops"] =             METER_TROOPS;
-            meter_name_map["RebelTroops"] =        METER_REBEL_TROOPS;
-            meter_name_map["Supply"] =             METER_SUPPLY;
-            meter_name_map["MaxSupply"] =          METER_MAX_SUPPLY;
-            meter_name_map["Stealth"] =            METER_STEALTH;
-            meter_name_map["Detection"] =          METER_DETECTION;
-            meter_name_map["BattleSpeed"] =        METER_BATTLE_SPEED;
-            meter_name_map["StarlaneSpeed"] =      METER_STARLANE_SPEED;
-            meter_name_map["Damage"] =             METER_DAMAGE;
-            meter_name_map["ROF"] =                METER_ROF;
-            meter_name_map["Range"] =              METER_RANGE;
-            meter_name_map["Speed"] =              METER_SPEED;
-            meter_name_map["Capacity"] =           METER_CAPACITY;
-            meter_name_map["AntiShipDamage"] =     METER_ANTI_SHIP_DAMAGE;
-            meter_name_map["AntiFighterDamage"] =  METER_ANTI_FIGHTER_DAMAGE;
-            meter_name_map["LaunchRate"] =         METER_LAUNCH_RATE;
-            meter_name_map["FighterWeaponRange"] = METER_FIGHTER_WEAPON_RANGE;
-            meter_name_map["Size"] =               METER_SIZE;
-        }
+        boost::call_once(&InitMeterNameMap, meter_name_map_once);
         return meter_name_map;
     }
 }
 
+namespace {
+    std::map<std::string, ValueRef::VariableProperty> property_name_map;
+    boost::once_flag property_name_map_once = BOOST_ONCE_INIT;
+
+    void InitVariablePropertyNameMap() {
+        property_name_map["Planet"] =                           ValueRef::PROPERTY_PLANET;
+        property_name_map["System"] =                           ValueRef::PROPERTY_SYSTEM;
+        property_name_map["Fleet"] =                            ValueRef::PROPERTY_FLEET;
+        property_name_map["UniverseCentreX"] =                  ValueRef::PROPERTY_UNIVERSE_CENTRE_X;
+        property_name_map["UniverseCentreY"] =                  ValueRef::PROPERTY_UNIVERSE_CENTRE_Y;
+        property_name_map["CurrentTurn"] =                      ValueRef::PROPERTY_CURRENT_TURN;
+        property_name_map["GalaxySize"] =                       ValueRef::PROPERTY_GALAXY_SIZE;
+        property_name_map["GalaxyShape"] =                      ValueRef::PROPERTY_GALAXY_SHAPE;
+        property_name_map["GalaxyAge"] =                        ValueRef::PROPERTY_GALAXY_AGE;
+        property_name_map["GalaxyStarlaneFrequency"] =          ValueRef::PROPERTY_GALAXY_STARLANE_FREQUENCY;
+        property_name_map["GalaxyPlanetDensity"] =              ValueRef::PROPERTY_GALAXY_PLANET_DENSITY;
+        property_name_map["GalaxySpecialFrequency"] =           ValueRef::PROPERTY_GALAXY_SPECIAL_FREQUENCY;
+        property_name_map["GalaxyMonsterFrequency"] =           ValueRef::PROPERTY_GALAXY_MONSTER_FREQUENCY;
+        property_name_map["GalaxyNativeFrequency"] =            ValueRef::PROPERTY_GALAXY_NATIVE_FREQUENCY;
+        property_name_map["GalaxyMaxAIAggression"] =            ValueRef::PROPERTY_GALAXY_MAX_AI_AGGRESSION;
+        property_name_map["GalaxySeed"] =                       ValueRef::PROPERTY_GALAXY_SEED;
+        property_name_map["PlanetSize"] =                       ValueRef::PROPERTY_PLANET_SIZE;
+        property_name_map["NextLargerPlanetSize"] =             ValueRef::PROPERTY_NEXT_LARGER_PLANET_SIZE;
+        property_name_map["NextSmallerPlanetSize"] =            ValueRef::PROPERTY_NEXT_SMALLER_PLANET_SIZE;
+        property_name_map["PlanetType"] =                       ValueRef::PROPERTY_PLANET_TYPE;
+        property_name_map["OriginalType"] =                     ValueRef::PROPERTY_ORIGINAL_TYPE;
+        property_name_map["NextCloserToOriginalPlanetType"] =   ValueRef::PROPERTY_NEXT_CLOSER_TO_ORIGINAL_PLANET_TYPE;
+        property_name_map["NextBetterPlanetType"] =             ValueRef::PROPERTY_NEXT_BETTER_PLANET_TYPE;
+        property_name_map["ClockwiseNextPlanetType"] =          ValueRef::PROPERTY_CLOCKWISE_NEXT_PLANET_TYPE;
+        property_name_map["CounterClockwiseNextPlanetType"] =   ValueRef::PROPERTY_COUNTER_CLOCKWISE_NEXT_PLANET_TYPE;
+        property_name_map["PlanetEnvironment"] =                ValueRef::PROPERTY_PLANET_ENVIRONMENT;
+        property_name_map["ObjectType"] =                       ValueRef::PROPERTY_OBJECT_TYPE;
+        property_name_map["StarType"] =                         ValueRef::PROPERTY_STAR_TYPE;
+        property_name_map["NextOlderStarType"] =                ValueRef::PROPERTY_NEXT_OLDER_STAR_TYPE;
+        property_name_map["NextYoungerStarType"] =              ValueRef::PROPERTY_NEXT_YOUNGER_STAR_TYPE;
+        property_name_map["TradeStockpile"] =                   ValueRef::PROPERTY_TRADE_STOCKPILE;
+        property_name_map["DistanceToSource"] =                 ValueRef::PROPERTY_DISTANCE_TO_SOURCE;
+        property_name_map["X"] =                                ValueRef::PROPERTY_X;
+        property_name_map["Y"] =                                ValueRef::PROPERTY_Y;
+        property_name_map["SizeAsDouble"] =                     ValueRef::PROPERTY_SIZE_AS_DOUBLE;
+        property_name_map["DistanceFromOriginalType"] =         ValueRef::PROPERTY_DISTANCE_FROM_ORIGINAL_TYPE;
+        property_name_map["NextTurnPopGrowth"] =                ValueRef::PROPERTY_NEXT_TURN_POP_GROWTH;
+        property_name_map["Owner"] =                            ValueRef::PROPERTY_OWNER;
+        property_name_map["ID"] =                               ValueRef::PROPERTY_ID;
+        property_name_map["CreationTurn"] =                     ValueRef::PROPERTY_CREATION_TURN;
+        property_name_map["Age"] =                              ValueRef::PROPERTY_AGE;
+        property_name_map["TurnsSinceFocusChange"] =            ValueRef::PROPERTY_TURNS_SINCE_FOCUS_CHANGE;
+        property_name_map["ProducedByEmpireID"] =               ValueRef::PROPERTY_PRODUCED_BY_EMPIRE_ID;
+        property_name_map["DesignID"] =                         ValueRef::PROPERTY_DESIGN_ID;
+        property_name_map["Species"] =                          ValueRef::PROPERTY_SPECIES;
+        property_name_map["FleetID"] =                          ValueRef::PROPERTY_FLEET_ID;
+        property_name_map["PlanetID"] =                         ValueRef::PROPERTY_PLANET_ID;
+        property_name_map["SystemID"] =                         ValueRef::PROPERTY_SYSTEM_ID;
+        property_name_map["FinalDestinationID"] =               ValueRef::PROPERTY_FINAL_DESTINATION_ID;
+        property_name_map["NextSystemID"] =                     ValueRef::PROPERTY_NEXT_SYSTEM_ID;
+        property_name_map["PreviousSystemID"] =                 ValueRef::PROPERTY_PREVIOUS_SYSTEM_ID;
+        property_name_map["NumShips"] =                         ValueRef::PROPERTY_NUM_SHIPS;
+        property_name_map["LastTurnBattleHere"] =               ValueRef::PROPERTY_LAST_TURN_BATTLE_HERE;
+        property_name_map["LastTurnActiveInBattle"] =           ValueRef::PROPERTY_LAST_TURN_ACTIVE_IN_BATTLE;
+        property_name_map["Orbit"] =                            ValueRef::PROPERTY_ORBIT;
+        property_name_map["Name"] =                             ValueRef::PROPERTY_NAME;
+        property_name_map["OwnerName"] =                        ValueRef::PROPERTY_OWNER_NAME;
+        property_name_map["TypeName"] =                         ValueRef::PROPERTY_TYPE_NAME;
+        property_name_map["BuildingType"] =                     ValueRef::PROPERTY_BUILDING_TYPE;
+        property_name_map["Focus"] =                            ValueRef::PROPERTY_FOCUS;
+        property_name_map["PreferredFocus"] =                   ValueRef::PROPERTY_PREFERRED_FOCUS;
+        property_name_map["OwnerLeastExpensiveEnqueuedTech"] =  ValueRef::PROPERTY_OWNER_LEAST_EXPENSIVE_ENQUEUED_TECH;
+        property_name_map["OwnerMostExpensiveEnqueuedTech"] =   ValueRef::PROPERTY_OWNER_MOST_EXPENSIVE_ENQUEUED_TECH;
+        property_name_map["OwnerMostRPCostLeftEnqueuedTech"] =  ValueRef::PROPERTY_OWNER_MOST_RP_COST_LEFT_ENQUEUED_TECH;
+        property_name_map["OwnerMostRPSpentEnqueuedTech"] =     ValueRef::PROPERTY_OWNER_MOST_RP_SPENT_ENQUEUED_TECH;
+        property_name_map["OwnerTopPriorityEnqueuedTech"] =     ValueRef::PROPERTY_OWNER_TOP_PRIORITY_ENQUEUED_TECH;
+    }
+
+    /** Filled only once, like the meter name map. */
+    const std::map<std::string, ValueRef::VariableProperty>& GetVariablePropertyNameMap() {
+        boost::call_once(&InitVariablePropertyNameMap, property_name_map_once);
+        return property_name_map;
+    }
+}
+
 MeterType ValueRef::NameToMeter(std::string name) {
     MeterType retval = INVALID_METER_TYPE;
     std::map<std::string, MeterType>::const_iterator it = GetMeterNameMap().find(name);
@@ -220,6 +341,23 @@ std::string ValueRef::MeterToName(MeterType meter) {
     return "";
 }
 
+ValueRef::VariableProperty ValueRef::NameToVariableProperty(const std::string& name) {
+    std::map<std::string, VariableProperty>::const_iterator it = GetVariablePropertyNameMap().find(name);
+    if (it != GetVariablePropertyNameMap().end())
+        return it->second;
+    return INVALID_VARIABLE_PROPERTY;
+}
+
+void ValueRef::CountFoldedOperations(unsigned int operations) {
+    if (!s_folded_operations.get())
+        s_folded_operations.reset(new unsigned int(0));
+    *s_folded_operations += operations;
+}
+
+unsigned int ValueRef::FoldedOperations() {
+    return s_folded_operations.get() ? *s_folded_operations : 0;
+}
+
 std::string ValueRef::ReconstructName(const std::vector<std::string>& property_name,
                                       ValueRef::ReferenceType ref_type)
 {
@@ -408,23 +546,21 @@ namespace ValueRef {
     template <>
     PlanetSize Variable<PlanetSize>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(PlanetSize)
 
-        TemporaryPtr<const UniverseObject> object = FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        ObjectHandle<const UniverseObject> object = FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
         if (!object) {
             Logger().errorStream() << "Variable<PlanetSize>::Eval unable to follow reference: " << TraceReference(m_property_name, m_ref_type, context);
             return INVALID_PLANET_SIZE;
         }
 
-        if (TemporaryPtr<const Planet> p = boost::dynamic_pointer_cast<const Planet>(object)) {
-            if (property_name == "PlanetSize")
-                return p->Size();
-            else if (property_name == "NextLargerPlanetSize")
-                return p->NextLargerPlanetSize();
-            else if (property_name == "NextSmallerPlanetSize")
-                return p->NextSmallerPlanetSize();
+        if (ObjectHandle<const Planet> p = boost::dynamic_pointer_cast<const Planet>(object)) {
+            switch (LastProperty(m_properties)) {
+            case PROPERTY_PLANET_SIZE:              return p->Size();
+            case PROPERTY_NEXT_LARGER_PLANET_SIZE:  return p->NextLargerPlanetSize();
+            case PROPERTY_NEXT_SMALLER_PLANET_SIZE: return p->NextSmallerPlanetSize();
+            default:                                break;
+            }
         }
 
         Logger().errorStream() << "Variable<PlanetSize>::Eval unrecognized object property: " << TraceReference(m_property_name, m_ref_type, context);
@@ -434,29 +570,24 @@ namespace ValueRef {
     template <>
     PlanetType Variable<PlanetType>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(PlanetType)
 
-        TemporaryPtr<const UniverseObject> object = FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        ObjectHandle<const UniverseObject> object = FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
         if (!object) {
             Logger().errorStream() << "Variable<PlanetType>::Eval unable to follow reference: " << TraceReference(m_property_name, m_ref_type, context);
             return INVALID_PLANET_TYPE;
         }
 
-        if (TemporaryPtr<const Planet> p = boost::dynamic_pointer_cast<const Planet>(object)) {
-            if (property_name == "PlanetType")
-                return p->Type();
-            else if (property_name == "OriginalType")
-                return p->OriginalType();
-            else if (property_name == "NextCloserToOriginalPlanetType")
-                return p->NextCloserToOriginalPlanetType();
-            else if (property_name == "NextBetterPlanetType")
-                return p->NextBetterPlanetTypeForSpecies();
-            else if (property_name == "ClockwiseNextPlanetType")
-                return p->ClockwiseNextPlanetType();
-            else if (property_name == "CounterClockwiseNextPlanetType")
-                return p->CounterClockwiseNextPlanetType();
+        if (ObjectHandle<const Planet> p = boost::dynamic_pointer_cast<const Planet>(object)) {
+            switch (LastProperty(m_properties)) {
+            case PROPERTY_PLANET_TYPE:                          return p->Type();
+            case PROPERTY_ORIGINAL_TYPE:                        return p->OriginalType();
+            case PROPERTY_NEXT_CLOSER_TO_ORIGINAL_PLANET_TYPE:  return p->NextCloserToOriginalPlanetType();
+            case PROPERTY_NEXT_BETTER_PLANET_TYPE:              return p->NextBetterPlanetTypeForSpecies();
+            case PROPERTY_CLOCKWISE_NEXT_PLANET_TYPE:           return p->ClockwiseNextPlanetType();
+            case PROPERTY_COUNTER_CLOCKWISE_NEXT_PLANET_TYPE:   return p->CounterClockwiseNextPlanetType();
+            default:                                            break;
+            }
         }
 
         Logger().errorStream() << "Variable<PlanetType>::Eval unrecognized object property: " << TraceReference(m_property_name, m_ref_type, context);
@@ -466,17 +597,15 @@ namespace ValueRef {
     template <>
     PlanetEnvironment Variable<PlanetEnvironment>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(PlanetEnvironment)
 
-        if (property_name == "PlanetEnvironment") {
-            TemporaryPtr<const UniverseObject> object = FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        if (LastProperty(m_properties) == PROPERTY_PLANET_ENVIRONMENT) {
+            ObjectHandle<const UniverseObject> object = FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
             if (!object) {
                 Logger().errorStream() << "Variable<PlanetEnvironment>::Eval unable to follow reference: " << TraceReference(m_property_name, m_ref_type, context);
                 return INVALID_PLANET_ENVIRONMENT;
             }
-            if (TemporaryPtr<const Planet> p = boost::dynamic_pointer_cast<const Planet>(object))
+            if (ObjectHandle<const Planet> p = boost::dynamic_pointer_cast<const Planet>(object))
                 return p->EnvironmentForSpecies();
         }
 
@@ -487,12 +616,10 @@ namespace ValueRef {
     template <>
     UniverseObjectType Variable<UniverseObjectType>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(UniverseObjectType)
 
-        if (property_name == "ObjectType") {
-            TemporaryPtr<const UniverseObject> object = FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        if (LastProperty(m_properties) == PROPERTY_OBJECT_TYPE) {
+            ObjectHandle<const UniverseObject> object = FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
             if (!object) {
                 Logger().errorStream() << "Variable<UniverseObjectType>::Eval unable to follow reference: " << TraceReference(m_property_name, m_ref_type, context);
                 return INVALID_UNIVERSE_OBJECT_TYPE;
@@ -513,23 +640,21 @@ namespace ValueRef {
     template <>
     StarType Variable<StarType>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(StarType)
 
-        TemporaryPtr<const UniverseObject> object = FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        ObjectHandle<const UniverseObject> object = FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
         if (!object) {
             Logger().errorStream() << "Variable<StarType>::Eval unable to follow reference: " << TraceReference(m_property_name, m_ref_type, context);
             return INVALID_STAR_TYPE;
         }
 
-        if (TemporaryPtr<const System> s = boost::dynamic_pointer_cast<const System>(object)) {
-            if (property_name == "StarType")
-                return s->GetStarType();
-            else if (property_name == "NextOlderStarType")
-                return s->NextOlderStarType();
-            else if (property_name == "NextYoungerStarType")
-                return s->NextYoungerStarType();
+        if (ObjectHandle<const System> s = boost::dynamic_pointer_cast<const System>(object)) {
+            switch (LastProperty(m_properties)) {
+            case PROPERTY_STAR_TYPE:            return s->GetStarType();
+            case PROPERTY_NEXT_OLDER_STAR_TYPE: return s->NextOlderStarType();
+            case PROPERTY_NEXT_YOUNGER_STAR_TYPE:return s->NextYoungerStarType();
+            default:                            break;
+            }
         }
 
         Logger().errorStream() << "Variable<StarType>::Eval unrecognized object property: " << TraceReference(m_property_name, m_ref_type, context);
@@ -539,13 +664,13 @@ namespace ValueRef {
     template <>
     double Variable<double>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(float)
 
+        VariableProperty property = LastProperty(m_properties);
+
         if (m_ref_type == ValueRef::NON_OBJECT_REFERENCE) {
-            if (property_name == "UniverseCentreX" |
-                property_name == "UniverseCentreY")
+            if (property == PROPERTY_UNIVERSE_CENTRE_X ||
+                property == PROPERTY_UNIVERSE_CENTRE_Y)
             {
                 return GetUniverse().UniverseWidth() / 2;
             }
@@ -555,53 +680,62 @@ namespace ValueRef {
             return 0.0;
         }
 
-        TemporaryPtr<const UniverseObject> object =
-            FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        ObjectHandle<const UniverseObject> object =
+            FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
         if (!object) {
             Logger().errorStream() << "Variable<double>::Eval unable to follow reference: "
                                    << TraceReference(m_property_name, m_ref_type, context);
             return 0.0;
         }
 
-        MeterType meter_type = NameToMeter(property_name);
-        if (object && meter_type != INVALID_METER_TYPE) {
-            if (object->GetMeter(meter_type))
-                return object->InitialMeterValue(meter_type);
+        if (m_meter_type != INVALID_METER_TYPE) {
+            if (object->GetMeter(m_meter_type))
+                return object->InitialMeterValue(m_meter_type);
 
-        } else if (property_name == "TradeStockpile") {
-            if (const Empire* empire = Empires().Lookup(object->Owner()))
-                return empire->ResourceStockpile(RE_TRADE);
+        } else {
+            switch (property) {
+            case PROPERTY_TRADE_STOCKPILE:
+                if (const Empire* empire = Empires().Lookup(object->Owner()))
+                    return empire->ResourceStockpile(RE_TRADE);
+                break;
 
-        } else if (property_name == "DistanceToSource") {
-            if (!context.source) {
-                Logger().errorStream() << "ValueRef::Variable<double>::Eval can't find distance to source because no source was passed";
-                return 0.0;
+            case PROPERTY_DISTANCE_TO_SOURCE: {
+                if (!context.source) {
+                    Logger().errorStream() << "ValueRef::Variable<double>::Eval can't find distance to source because no source was passed";
+                    return 0.0;
+                }
+                double delta_x = object->X() - context.source->X();
+                double delta_y = object->Y() - context.source->Y();
+                return std::sqrt(delta_x * delta_x + delta_y * delta_y);
             }
-            double delta_x = object->X() - context.source->X();
-            double delta_y = object->Y() - context.source->Y();
-            return std::sqrt(delta_x * delta_x + delta_y * delta_y);
 
-        } else if (property_name == "X") {
-            return object->X();
+            case PROPERTY_X:
+                return object->X();
 
-        } else if (property_name == "Y") {
-            return object->Y();
+            case PROPERTY_Y:
+                return object->Y();
 
-        } else if (property_name == "SizeAsDouble") {
-            if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
-                return planet->SizeAsInt();
+            case PROPERTY_SIZE_AS_DOUBLE:
+                if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
+                    return planet->SizeAsInt();
+                break;
 
-        } else if (property_name == "DistanceFromOriginalType") {
-            if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
-                return planet->DistanceFromOriginalType();
+            case PROPERTY_DISTANCE_FROM_ORIGINAL_TYPE:
+                if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
+                    return planet->DistanceFromOriginalType();
+                break;
 
-        } else if (property_name == "NextTurnPopGrowth") {
-            if (TemporaryPtr<const PopCenter> pop = boost::dynamic_pointer_cast<const PopCenter>(object))
-                return pop->NextTurnPopGrowth();
+            case PROPERTY_NEXT_TURN_POP_GROWTH:
+                if (ObjectHandle<const PopCenter> pop = boost::dynamic_pointer_cast<const PopCenter>(object))
+                    return pop->NextTurnPopGrowth();
+                break;
 
-        } else if (property_name == "CurrentTurn") {
-            return CurrentTurn();
+            case PROPERTY_CURRENT_TURN:
+                return CurrentTurn();
 
+            default:
+                break;
+            }
         }
 
         Logger().errorStream() << "Variable<double>::Eval unrecognized object property: " << TraceReference(m_property_name, m_ref_type, context);
@@ -611,126 +745,128 @@ namespace ValueRef {
     template <>
     int Variable<int>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(int)
 
+        VariableProperty property = LastProperty(m_properties);
+
         if (m_ref_type == ValueRef::NON_OBJECT_REFERENCE) {
-            if (property_name == "CurrentTurn")
-                return CurrentTurn();
-            if (property_name == "GalaxySize")
-                return GetGalaxySetupData().m_size;
-            if (property_name == "GalaxyShape")
-                return static_cast<int>(GetGalaxySetupData().m_shape);
-            if (property_name == "GalaxyAge")
-                return static_cast<int>(GetGalaxySetupData().m_age);
-            if (property_name == "GalaxyStarlaneFrequency")
-                return static_cast<int>(GetGalaxySetupData().m_starlane_freq);
-            if (property_name == "GalaxyPlanetDensity")
-                return static_cast<int>(GetGalaxySetupData().m_planet_density);
-            if (property_name == "GalaxySpecialFrequency")
-                return static_cast<int>(GetGalaxySetupData().m_specials_freq);
-            if (property_name == "GalaxyMonsterFrequency")
-                return static_cast<int>(GetGalaxySetupData().m_monster_freq);
-            if (property_name == "GalaxyNativeFrequency")
-                return static_cast<int>(GetGalaxySetupData().m_native_freq);
-            if (property_name == "GalaxyMaxAIAggression")
-                return static_cast<int>(GetGalaxySetupData().m_ai_aggr);
+            switch (property) {
+            case PROPERTY_CURRENT_TURN:                 return CurrentTurn();
+            case PROPERTY_GALAXY_SIZE:                  return GetGalaxySetupData().m_size;
+            case PROPERTY_GALAXY_SHAPE:                 return static_cast<int>(GetGalaxySetupData().m_shape);
+            case PROPERTY_GALAXY_AGE:                   return static_cast<int>(GetGalaxySetupData().m_age);
+            case PROPERTY_GALAXY_STARLANE_FREQUENCY:    return static_cast<int>(GetGalaxySetupData().m_starlane_freq);
+            case PROPERTY_GALAXY_PLANET_DENSITY:        return static_cast<int>(GetGalaxySetupData().m_planet_density);
+            case PROPERTY_GALAXY_SPECIAL_FREQUENCY:     return static_cast<int>(GetGalaxySetupData().m_specials_freq);
+            case PROPERTY_GALAXY_MONSTER_FREQUENCY:     return static_cast<int>(GetGalaxySetupData().m_monster_freq);
+            case PROPERTY_GALAXY_NATIVE_FREQUENCY:      return static_cast<int>(GetGalaxySetupData().m_native_freq);
+            case PROPERTY_GALAXY_MAX_AI_AGGRESSION:     return static_cast<int>(GetGalaxySetupData().m_ai_aggr);
+            default:                                    break;
+            }
 
             // add more non-object reference int functions here
             Logger().errorStream() << "Variable<int>::Eval unrecognized non-object property: " << TraceReference(m_property_name, m_ref_type, context);
             return 0;
         }
 
-        TemporaryPtr<const UniverseObject> object =
-            FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        ObjectHandle<const UniverseObject> object =
+            FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
         if (!object) {
             Logger().errorStream() << "Variable<int>::Eval unable to follow reference: " << TraceReference(m_property_name, m_ref_type, context);
             return 0;
         }
 
-        if (property_name == "Owner") {
+        switch (property) {
+        case PROPERTY_OWNER:
             return object->Owner();
-        } else if (property_name == "ID") {
+
+        case PROPERTY_ID:
             return object->ID();
-        } else if (property_name == "CreationTurn") {
+
+        case PROPERTY_CREATION_TURN:
             return object->CreationTurn();
-        } else if (property_name == "Age") {
+
+        case PROPERTY_AGE:
             return object->AgeInTurns();
-        } else if (property_name == "TurnsSinceFocusChange") {
-            if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
+
+        case PROPERTY_TURNS_SINCE_FOCUS_CHANGE:
+            if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
                 return planet->TurnsSinceFocusChange();
-            else
-                return 0;
-        } else if (property_name == "ProducedByEmpireID") {
-            if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
+            return 0;
+
+        case PROPERTY_PRODUCED_BY_EMPIRE_ID:
+            if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
                 return ship->ProducedByEmpireID();
-            else if (TemporaryPtr<const Building> building = boost::dynamic_pointer_cast<const Building>(object))
+            else if (ObjectHandle<const Building> building = boost::dynamic_pointer_cast<const Building>(object))
                 return building->ProducedByEmpireID();
-            else
-                return ALL_EMPIRES;
-        } else if (property_name == "DesignID") {
-            if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
+            return ALL_EMPIRES;
+
+        case PROPERTY_DESIGN_ID:
+            if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
                 return ship->DesignID();
-            else
-                return ShipDesign::INVALID_DESIGN_ID;
-        } else if (property_name == "Species") {
-            if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
+            return ShipDesign::INVALID_DESIGN_ID;
+
+        case PROPERTY_SPECIES:
+            if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
                 return GetSpeciesManager().GetSpeciesID(planet->SpeciesName());
-            else if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
+            else if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
                 return GetSpeciesManager().GetSpeciesID(ship->SpeciesName());
-            else
-                return -1;
-        } else if (property_name == "FleetID") {
-            if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
+            return -1;
+
+        case PROPERTY_FLEET_ID:
+            if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
                 return ship->FleetID();
-            else if (TemporaryPtr<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
+            else if (ObjectHandle<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
                 return fleet->ID();
-            else
-                return INVALID_OBJECT_ID;
-        } else if (property_name == "PlanetID") {
-            if (TemporaryPtr<const Building> building = boost::dynamic_pointer_cast<const Building>(object))
+            return INVALID_OBJECT_ID;
+
+        case PROPERTY_PLANET_ID:
+            if (ObjectHandle<const Building> building = boost::dynamic_pointer_cast<const Building>(object))
                 return building->PlanetID();
-            else if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
+            else if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
                 return planet->ID();
-            else
-                return INVALID_OBJECT_ID;
-        } else if (property_name == "SystemID") {
+            return INVALID_OBJECT_ID;
+
+        case PROPERTY_SYSTEM_ID:
             return object->SystemID();
-        } else if (property_name == "FinalDestinationID") {
-            if (TemporaryPtr<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
+
+        case PROPERTY_FINAL_DESTINATION_ID:
+            if (ObjectHandle<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
                 return fleet->FinalDestinationID();
-            else
-                return INVALID_OBJECT_ID;
-        } else if (property_name == "NextSystemID") {
-            if (TemporaryPtr<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
+            return INVALID_OBJECT_ID;
+
+        case PROPERTY_NEXT_SYSTEM_ID:
+            if (ObjectHandle<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
                 return fleet->NextSystemID();
-            else
-                return INVALID_OBJECT_ID;
-        } else if (property_name == "PreviousSystemID") {
-            if (TemporaryPtr<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
+            return INVALID_OBJECT_ID;
+
+        case PROPERTY_PREVIOUS_SYSTEM_ID:
+            if (ObjectHandle<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
                 return fleet->PreviousSystemID();
-            else
-                return INVALID_OBJECT_ID;
-        } else if (property_name == "NumShips") {
-            if (TemporaryPtr<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
+            return INVALID_OBJECT_ID;
+
+        case PROPERTY_NUM_SHIPS:
+            if (ObjectHandle<const Fleet> fleet = boost::dynamic_pointer_cast<const Fleet>(object))
                 return fleet->NumShips();
-            else
-                return 0;
-        } else if (property_name == "LastTurnBattleHere") {
-            if (TemporaryPtr<const System> system = boost::dynamic_pointer_cast<const System>(object))
+            return 0;
+
+        case PROPERTY_LAST_TURN_BATTLE_HERE:
+            if (ObjectHandle<const System> system = boost::dynamic_pointer_cast<const System>(object))
                 return system->LastTurnBattleHere();
-            else
-                return INVALID_GAME_TURN;
-        } else if (property_name == "LastTurnActiveInBattle") {
-            if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
+            return INVALID_GAME_TURN;
+
+        case PROPERTY_LAST_TURN_ACTIVE_IN_BATTLE:
+            if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
                 return ship->LastTurnActiveInCombat();
-            else
-                return INVALID_GAME_TURN;
-        } else if (property_name == "Orbit") {
+            return INVALID_GAME_TURN;
+
+        case PROPERTY_ORBIT:
             if (TemporaryPtr<const System> system = GetSystem(object->SystemID()))
                 return system->OrbitOfPlanet(object->ID());
             return -1;
+
+        default:
+            break;
         }
 
         Logger().errorStream() << "Variable<int>::Eval unrecognized object property: " << TraceReference(m_property_name, m_ref_type, context);
@@ -740,91 +876,93 @@ namespace ValueRef {
     template <>
     std::string Variable<std::string>::Eval(const ScriptingContext& context) const
     {
-        const std::string& property_name = m_property_name.back();
-
         IF_CURRENT_VALUE(std::string)
 
+        VariableProperty property = LastProperty(m_properties);
+
         if (m_ref_type == ValueRef::NON_OBJECT_REFERENCE) {
-            if (property_name == "GalaxySeed")
+            if (property == PROPERTY_GALAXY_SEED)
                 return GetGalaxySetupData().m_seed;
 
             Logger().errorStream() << "Variable<std::string>::Eval unrecognized non-object property: " << TraceReference(m_property_name, m_ref_type, context);
             return "";
         }
 
-        TemporaryPtr<const UniverseObject> object =
-            FollowReference(m_property_name.begin(), m_property_name.end(), m_ref_type, context);
+        ObjectHandle<const UniverseObject> object =
+            FollowReference(m_properties.begin(), m_properties.end(), m_ref_type, context);
         if (!object) {
             Logger().errorStream() << "Variable<std::string>::Eval unable to follow reference: " << TraceReference(m_property_name, m_ref_type, context);
             return "";
         }
 
-        if (property_name == "Name") {
+        switch (property) {
+        case PROPERTY_NAME:
             return object->Name();
 
-        } else if (property_name == "OwnerName") {
-            int owner_empire_id = object->Owner();
-            if (Empire* empire = Empires().Lookup(owner_empire_id))
+        case PROPERTY_OWNER_NAME:
+            if (Empire* empire = Empires().Lookup(object->Owner()))
                 return empire->Name();
             return "";
 
-        } else if (property_name == "TypeName") {
+        case PROPERTY_TYPE_NAME:
             return boost::lexical_cast<std::string>(object->ObjectType());
 
-        } else if (property_name == "Species") {
-            if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
+        case PROPERTY_SPECIES:
+            if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
                 return planet->SpeciesName();
-            else if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
+            else if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object))
                 return ship->SpeciesName();
+            break;
 
-        } else if (property_name == "BuildingType") {
-            if (TemporaryPtr<const Building> building = boost::dynamic_pointer_cast<const Building>(object))
+        case PROPERTY_BUILDING_TYPE:
+            if (ObjectHandle<const Building> building = boost::dynamic_pointer_cast<const Building>(object))
                 return building->BuildingTypeName();
+            break;
 
-        } else if (property_name == "Focus") {
-            if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
+        case PROPERTY_FOCUS:
+            if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object))
                 return planet->Focus();
+            break;
 
-        } else if (property_name == "PreferredFocus") {
+        case PROPERTY_PREFERRED_FOCUS: {
             const Species* species = 0;
-            if (TemporaryPtr<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object)) {
+            if (ObjectHandle<const Planet> planet = boost::dynamic_pointer_cast<const Planet>(object)) {
                 species = GetSpecies(planet->SpeciesName());
-            } else if (TemporaryPtr<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object)) {
+            } else if (ObjectHandle<const Ship> ship = boost::dynamic_pointer_cast<const Ship>(object)) {
                 species = GetSpecies(ship->SpeciesName());
             }
             if (species)
                 return species->PreferredFocus();
             return "";
+        }
 
-        } else if (property_name == "OwnerMostExpensiveEnqueuedTech") {
-            const Empire* empire = Empires().Lookup(object->Owner());
-            if (!empire)
-                return "";
-            return empire->LeastExpensiveEnqueuedTech(true);
+        case PROPERTY_OWNER_LEAST_EXPENSIVE_ENQUEUED_TECH:
+            if (const Empire* empire = Empires().Lookup(object->Owner()))
+                return empire->LeastExpensiveEnqueuedTech(true);
+            return "";
 
-        } else if (property_name == "OwnerMostExpensiveEnqueuedTech") {
-            const Empire* empire = Empires().Lookup(object->Owner());
-            if (!empire)
-                return "";
-            return empire->MostExpensiveEnqueuedTech(true);
+        case PROPERTY_OWNER_MOST_EXPENSIVE_ENQUEUED_TECH:
+            if (const Empire* empire = Empires().Lookup(object->Owner()))
+                return empire->MostExpensiveEnqueuedTech(true);
+            return "";
 
-        } else if (property_name == "OwnerMostRPCostLeftEnqueuedTech") {
-            const Empire* empire = Empires().Lookup(object->Owner());
-            if (!empire)
-                return "";
-            return empire->MostRPCostLeftEnqueuedTech(true);
+        case PROPERTY_OWNER_MOST_RP_COST_LEFT_ENQUEUED_TECH:
+            if (const Empire* empire = Empires().Lookup(object->Owner()))
+                return empire->MostRPCostLeftEnqueuedTech(true);
+            return "";
 
-        } else if (property_name == "OwnerMostRPSpentEnqueuedTech") {
-            const Empire* empire = Empires().Lookup(object->Owner());
-            if (!empire)
-                return "";
-            return empire->MostRPSpentEnqueuedTech(true);
+        case PROPERTY_OWNER_MOST_RP_SPENT_ENQUEUED_TECH:
+            if (const Empire* empire = Empires().Lookup(object->Owner()))
+                return empire->MostRPSpentEnqueuedTech(true);
+            return "";
 
-        } else if (property_name == "OwnerTopPriorityEnqueuedTech") {
-            const Empire* empire = Empires().Lookup(object->Owner());
-            if (!empire)
-                return "";
-            return empire->TopPriorityEnqueuedTech(true);
+        case PROPERTY_OWNER_TOP_PRIORITY_ENQUEUED_TECH:
+            if (const Empire* empire = Empires().Lookup(object->Owner()))
+                return empire->TopPriorityEnqueuedTech(true);
+            return "";
+
+        default:
+            break;
         }
 
         Logger().errorStream() << "Variable<std::string>::Eval unrecognized object property: " << TraceReference(m_property_name, m_ref_type, context);
@@ -852,7 +990,7 @@ namespace ValueRef {
             return condition_matches.empty() ? 0.0 : 1.0;
 
         // evaluate property for each condition-matched object
-        std::map<TemporaryPtr<const UniverseObject>, double> object_property_values;
+        std::map<ObjectHandle<const UniverseObject>, double> object_property_values;
         GetObjectPropertyValues(context, condition_matches, object_property_values);
 
         return ReduceData(object_property_values);
@@ -872,7 +1010,7 @@ namespace ValueRef {
             return condition_matches.empty() ? 0 : 1;
 
         // evaluate property for each condition-matched object
-        std::map<TemporaryPtr<const UniverseObject>, int> object_property_values;
+        std::map<ObjectHandle<const UniverseObject>, int> object_property_values;
         GetObjectPropertyValues(context, condition_matches, object_property_values);
 
         return ReduceData(object_property_values);
@@ -893,7 +1031,7 @@ namespace ValueRef {
             return "";
 
         // evaluate property for each condition-matched object
-        std::map<TemporaryPtr<const UniverseObject>, std::string> object_property_values;
+        std::map<ObjectHandle<const UniverseObject>, std::string> object_property_values;
         GetObjectPropertyValues(context, condition_matches, object_property_values);
 
         // count number of each result, tracking which has the most occurances
@@ -901,7 +1039,7 @@ namespace ValueRef {
         std::map<std::string, unsigned int>::const_iterator most_common_property_value_it = histogram.begin();
         unsigned int max_seen(0);
 
-        for (std::map<TemporaryPtr<const UniverseObject>, std::string>::const_iterator it = object_property_values.begin();
+        for (std::map<ObjectHandle<const UniverseObject>, std::string>::const_iterator it = object_property_values.begin();
              it != object_property_values.end(); ++it)
         {
             const std::string& property_value = it->second;
@@ -1507,6 +1645,65 @@ namespace ValueRef {
         }
     }
 
+    template <>
+    void        Operation<double>::EvalForTargets(const ScriptingContext& context,
+                                                  const std::vector<ObjectHandle<UniverseObject> >& targets,
+                                                  std::vector<double>& values) const
+    {
+        switch (m_op_type) {
+        case PLUS: case MINUS: case TIMES: case DIVIDE: case NEGATE:
+        case MINIMUM: case MAXIMUM:
+            break;
+        default:
+            // other operations gain nothing from being done for all targets at once
+            ValueRefBase<double>::EvalForTargets(context, targets, values);
+            return;
+        }
+
+        // evaluate each operand for all targets, then combine them in loops
+        // over contiguous buffers
+        std::vector<double> rhs_values;
+        if (m_operand2) {
+            rhs_values = values;
+            EvalOperandForTargets(m_operand2, context, targets, rhs_values);
+        }
+        EvalOperandForTargets(m_operand1, context, targets, values);
+
+        std::size_t num_values = values.size();
+        switch (m_op_type) {
+        case PLUS:
+            for (std::size_t i = 0; i < num_values; ++i)
+                values[i] += rhs_values[i];
+            break;
+        case MINUS:
+            for (std::size_t i = 0; i < num_values; ++i)
+                values[i] -= rhs_values[i];
+            break;
+        case TIMES:
+            for (std::size_t i = 0; i < num_values; ++i)
+                values[i] *= rhs_values[i];
+            break;
+        case DIVIDE:
+            for (std::size_t i = 0; i < num_values; ++i)
+                values[i] = rhs_values[i] == 0.0 ? 0.0 : values[i] / rhs_values[i];
+            break;
+        case NEGATE:
+            for (std::size_t i = 0; i < num_values; ++i)
+                values[i] = -values[i];
+            break;
+        case MINIMUM:
+            for (std::size_t i = 0; i < num_values; ++i)
+                values[i] = std::min(values[i], rhs_values[i]);
+            break;
+        case MAXIMUM:
+            for (std::size_t i = 0; i < num_values; ++i)
+                values[i] = std::max(values[i], rhs_values[i]);
+            break;
+        default:
+            break;
+        }
+    }
+
     template <>
     int         Operation<int>::Eval(const ScriptingContext& context) const
     {
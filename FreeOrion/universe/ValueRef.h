@@ -18,6 +18,9 @@ class UniverseObject;
 const std::string& UserString(const std::string& str);
 boost::format FlexibleFormat(const std::string& string_to_format);
 
+/** The objects a ValueRef or Condition is evaluated for.  Contexts only exist
+  * while a condition, value or effect is evaluated, so they hold the objects
+  * with ObjectHandle. */
 struct ScriptingContext {
     /** Empty context.  Useful for evaluating ValueRef::Constant that don't
       * depend on their context. */
@@ -27,16 +30,16 @@ struct ScriptingContext {
     /** Context with only a source object.  Useful for evaluating effectsgroup
       * scope and activation conditions that have no external candidates or
       * effect target to propegate. */
-    explicit ScriptingContext(TemporaryPtr<const UniverseObject> source_) :
+    explicit ScriptingContext(ObjectHandle<const UniverseObject> source_) :
         source(source_)
     {}
 
-    ScriptingContext(TemporaryPtr<const UniverseObject> source_, TemporaryPtr<UniverseObject> target_) :
+    ScriptingContext(ObjectHandle<const UniverseObject> source_, ObjectHandle<UniverseObject> target_) :
         source(source_),
         effect_target(target_)
     {}
 
-    ScriptingContext(TemporaryPtr<const UniverseObject> source_, TemporaryPtr<UniverseObject> target_,
+    ScriptingContext(ObjectHandle<const UniverseObject> source_, ObjectHandle<UniverseObject> target_,
                      const boost::any& current_value_) :
         source(source_),
         effect_target(target_),
@@ -59,7 +62,7 @@ struct ScriptingContext {
       * there is no root candidate in the parent context, then the input object
       * becomes the root candidate. */
     ScriptingContext(const ScriptingContext& parent_context,
-                     TemporaryPtr<const UniverseObject> condition_local_candidate) :
+                     ObjectHandle<const UniverseObject> condition_local_candidate) :
         source(                     parent_context.source),
         effect_target(              parent_context.effect_target),
         condition_root_candidate(   parent_context.condition_root_candidate ?
@@ -69,20 +72,32 @@ struct ScriptingContext {
         current_value(              parent_context.current_value)
     {}
 
-    ScriptingContext(TemporaryPtr<const UniverseObject> source_, TemporaryPtr<UniverseObject> target_,
+    /** As above; needed as the any overload would also take a TemporaryPtr. */
+    ScriptingContext(const ScriptingContext& parent_context,
+                     TemporaryPtr<const UniverseObject> condition_local_candidate) :
+        source(                     parent_context.source),
+        effect_target(              parent_context.effect_target),
+        condition_root_candidate(   parent_context.condition_root_candidate ?
+                                        parent_context.condition_root_candidate :
+                                        ObjectHandle<const UniverseObject>(condition_local_candidate)),
+        condition_local_candidate(  condition_local_candidate),
+        current_value(              parent_context.current_value)
+    {}
+
+    ScriptingContext(ObjectHandle<const UniverseObject> source_, ObjectHandle<UniverseObject> target_,
                      const boost::any& current_value_,
-                     TemporaryPtr<const UniverseObject> condition_root_candidate_,
-                     TemporaryPtr<const UniverseObject> condition_local_candidate_) :
+                     ObjectHandle<const UniverseObject> condition_root_candidate_,
+                     ObjectHandle<const UniverseObject> condition_local_candidate_) :
         source(source_),
         condition_root_candidate(condition_root_candidate_),
         condition_local_candidate(condition_local_candidate_),
         current_value(current_value_)
     {}
 
-    TemporaryPtr<const UniverseObject>  source;
-    TemporaryPtr<UniverseObject>        effect_target;
-    TemporaryPtr<const UniverseObject>  condition_root_candidate;
-    TemporaryPtr<const UniverseObject>  condition_local_candidate;
+    ObjectHandle<const UniverseObject>  source;
+    ObjectHandle<UniverseObject>        effect_target;
+    ObjectHandle<const UniverseObject>  condition_root_candidate;
+    ObjectHandle<const UniverseObject>  condition_local_candidate;
     const boost::any                    current_value;
 };
 
@@ -106,6 +121,15 @@ struct ValueRef::ValueRefBase
       * evaluating expressions that do not depend on context. */
     T                   Eval() const { return Eval(::ScriptingContext()); }
 
+    /** Evaluates the expression tree once for each of \a targets as the
+      * effect target, with the corresponding element of \a values as the
+      * "Value" variable, and replaces that element with the result.  This
+      * gives the same results as evaluating each target separately, but
+      * lets nodes that can do so process all the targets in one loop. */
+    virtual void        EvalForTargets(const ScriptingContext& context,
+                                       const std::vector<ObjectHandle<UniverseObject> >& targets,
+                                       std::vector<T>& values) const;
+
     virtual bool        RootCandidateInvariant() const { return false; }
     virtual bool        LocalCandidateInvariant() const { return false; }
     virtual bool        TargetInvariant() const { return false; }
@@ -138,6 +162,8 @@ struct FO_COMMON_API ValueRef::Constant : public ValueRef::ValueRefBase<T>
     virtual std::string Dump() const;
 
 private:
+    Constant() : m_value() {}
+
     T m_value;
 
     friend class boost::serialization::access;
@@ -165,10 +191,19 @@ struct FO_COMMON_API ValueRef::Variable : public ValueRef::ValueRefBase<T>
     virtual std::string             Dump() const;
 
 protected:
-    mutable ReferenceType       m_ref_type;
-    std::vector<std::string>    m_property_name;
+    Variable() :
+        m_ref_type(INVALID_REFERENCE_TYPE),
+        m_meter_type(INVALID_METER_TYPE)
+    {}
+
+    mutable ReferenceType           m_ref_type;
+    std::vector<std::string>        m_property_name;
+    std::vector<VariableProperty>   m_properties;   ///< m_property_name resolved to the properties and object references it names
+    MeterType                       m_meter_type;   ///< meter named by the last element of m_property_name, or INVALID_METER_TYPE
 
 private:
+    void                            ResolvePropertyName();
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -211,12 +246,14 @@ protected:
     /** Evaluates the property for the specified objects. */
     void    GetObjectPropertyValues(const ScriptingContext& context,
                                     const Condition::ObjectSet& objects,
-                                    std::map<TemporaryPtr<const UniverseObject>, T>& object_property_values) const;
+                                    std::map<ObjectHandle<const UniverseObject>, T>& object_property_values) const;
 
     /** Computes the statistic from the specified set of property values. */
-    T       ReduceData(const std::map<TemporaryPtr<const UniverseObject>, T>& object_property_values) const;
+    T       ReduceData(const std::map<ObjectHandle<const UniverseObject>, T>& object_property_values) const;
 
 private:
+    Statistic() : m_sampling_condition(0) {}
+
     StatisticType                   m_stat_type;
     const Condition::ConditionBase* m_sampling_condition;
 
@@ -258,6 +295,13 @@ protected:
     const ValueRefBase<std::string>*m_string_ref2;
 
 private:
+    ComplexVariable() :
+        m_int_ref1(0),
+        m_int_ref2(0),
+        m_string_ref1(0),
+        m_string_ref2(0)
+    {}
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -283,6 +327,8 @@ struct FO_COMMON_API ValueRef::StaticCast : public ValueRef::Variable<ToType>
     const ValueRefBase<FromType>*   GetValueRef() const { return m_value_ref; }
 
 private:
+    StaticCast() : m_value_ref(0) {}
+
     const ValueRefBase<FromType>* m_value_ref;
 
     friend class boost::serialization::access;
@@ -310,6 +356,8 @@ struct FO_COMMON_API ValueRef::StringCast : public ValueRef::Variable<std::strin
     const ValueRefBase<FromType>*   GetValueRef() const { return m_value_ref; }
 
 private:
+    StringCast() : m_value_ref(0) {}
+
     const ValueRefBase<FromType>* m_value_ref;
 
     friend class boost::serialization::access;
@@ -332,6 +380,8 @@ struct FO_COMMON_API ValueRef::UserStringLookup : public ValueRef::Variable<std:
     const ValueRefBase<std::string>*    GetValueRef() const { return m_value_ref; }
 
 private:
+    UserStringLookup() : m_value_ref(0) {}
+
     const ValueRefBase<std::string>* m_value_ref;
 
     friend class boost::serialization::access;
@@ -355,6 +405,9 @@ struct FO_COMMON_API ValueRef::Operation : public ValueRef::ValueRefBase<T>
     const ValueRefBase<T>*  LHS() const;
     const ValueRefBase<T>*  RHS() const;
     virtual T               Eval(const ScriptingContext& context) const;
+    virtual void            EvalForTargets(const ScriptingContext& context,
+                                           const std::vector<ObjectHandle<UniverseObject> >& targets,
+                                           std::vector<T>& values) const;
     virtual bool            RootCandidateInvariant() const;
     virtual bool            LocalCandidateInvariant() const;
     virtual bool            TargetInvariant() const;
@@ -363,10 +416,28 @@ struct FO_COMMON_API ValueRef::Operation : public ValueRef::ValueRefBase<T>
     virtual std::string     Dump() const;
 
 private:
+    Operation() :
+        m_operand1(0),
+        m_operand2(0)
+    {}
+
+    void                    DetermineInvariance();
+    void                    FoldOperands();
+
     OpType                  m_op_type;
     const ValueRefBase<T>*  m_operand1;
     const ValueRefBase<T>*  m_operand2;
 
+    // whether the whole subtree is invariant, determined once when the
+    // operands are set instead of on every query
+    bool                    m_root_candidate_invariant;
+    bool                    m_local_candidate_invariant;
+    bool                    m_target_invariant;
+    bool                    m_source_invariant;
+
+    template <class U>
+    friend const ValueRefBase<U>* ValueRef::FoldConstants(const ValueRefBase<U>* expr);
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -376,8 +447,30 @@ namespace ValueRef {
     FO_COMMON_API MeterType     NameToMeter(std::string name);
     FO_COMMON_API std::string   MeterToName(MeterType meter);
 
+    /** Returns the property or object reference that \a name refers to in a
+      * ValueRef::Variable, or INVALID_VARIABLE_PROPERTY if there is none. */
+    FO_COMMON_API VariableProperty  NameToVariableProperty(const std::string& name);
+
     FO_COMMON_API std::string   ReconstructName(const std::vector<std::string>& property_name,
                                                 ReferenceType ref_type);
+
+    /** Adds \a operations to the number of Operations that FoldConstants has
+      * replaced with Constants in the calling thread. */
+    FO_COMMON_API void          CountFoldedOperations(unsigned int operations);
+
+    /** Returns the number of Operations that FoldConstants has replaced with
+      * Constants so far in the calling thread. */
+    FO_COMMON_API unsigned int  FoldedOperations();
+
+    /** Returns \a value as the current value for a ScriptingContext.  Meter
+      * values are floats, which is what double ValueRefs expect the "Value"
+      * variable to hold. */
+    template <class T>
+    boost::any                  CurrentValue(const T& value)
+    { return boost::any(value); }
+
+    inline boost::any           CurrentValue(double value)
+    { return boost::any(static_cast<float>(value)); }
 }
 
 // Template Implementations
@@ -394,6 +487,15 @@ bool ValueRef::ValueRefBase<T>::operator==(const ValueRef::ValueRefBase<T>& rhs)
     return true;
 }
 
+template <class T>
+void ValueRef::ValueRefBase<T>::EvalForTargets(const ScriptingContext& context,
+                                               const std::vector<ObjectHandle<UniverseObject> >& targets,
+                                               std::vector<T>& values) const
+{
+    for (std::size_t i = 0; i < targets.size(); ++i)
+        values[i] = Eval(::ScriptingContext(context.source, targets[i], CurrentValue(values[i])));
+}
+
 template <class T>
 template <class Archive>
 void ValueRef::ValueRefBase<T>::serialize(Archive& ar, const unsigned int version)
@@ -470,7 +572,7 @@ template <class T>
 template <class Archive>
 void ValueRef::Constant<T>::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase<T>)
         & BOOST_SERIALIZATION_NVP(m_value);
 }
 
@@ -480,15 +582,20 @@ void ValueRef::Constant<T>::serialize(Archive& ar, const unsigned int version)
 template <class T>
 ValueRef::Variable<T>::Variable(ReferenceType ref_type, const std::vector<std::string>& property_name) :
     m_ref_type(ref_type),
-    m_property_name(property_name.begin(), property_name.end())
-{}
+    m_property_name(property_name.begin(), property_name.end()),
+    m_properties(),
+    m_meter_type(INVALID_METER_TYPE)
+{ ResolvePropertyName(); }
 
 template <class T>
 ValueRef::Variable<T>::Variable(ReferenceType ref_type, const std::string& property_name) :
     m_ref_type(ref_type),
-    m_property_name()
+    m_property_name(),
+    m_properties(),
+    m_meter_type(INVALID_METER_TYPE)
 {
     m_property_name.push_back(property_name);
+    ResolvePropertyName();
 }
 
 template <class T>
@@ -539,6 +646,15 @@ template <class T>
 std::string ValueRef::Variable<T>::Dump() const
 { return ReconstructName(m_property_name, m_ref_type); }
 
+template <class T>
+void ValueRef::Variable<T>::ResolvePropertyName()
+{
+    m_properties.clear();
+    for (std::vector<std::string>::const_iterator it = m_property_name.begin(); it != m_property_name.end(); ++it)
+        m_properties.push_back(NameToVariableProperty(*it));
+    m_meter_type = m_property_name.empty() ? INVALID_METER_TYPE : NameToMeter(m_property_name.back());
+}
+
 namespace ValueRef {
     template <>
     PlanetSize Variable<PlanetSize>::Eval(const ScriptingContext& context) const;
@@ -566,9 +682,12 @@ template <class T>
 template <class Archive>
 void ValueRef::Variable<T>::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase<T>)
         & BOOST_SERIALIZATION_NVP(m_ref_type)
         & BOOST_SERIALIZATION_NVP(m_property_name);
+
+    if (Archive::is_loading::value)
+        ResolvePropertyName();
 }
 
 ///////////////////////////////////////////////////////////
@@ -627,7 +746,7 @@ void ValueRef::Statistic<T>::GetConditionMatches(const ScriptingContext& context
 template <class T>
 void ValueRef::Statistic<T>::GetObjectPropertyValues(const ScriptingContext& context,
                                                      const Condition::ObjectSet& objects,
-                                                     std::map<TemporaryPtr<const UniverseObject>, T>& object_property_values) const
+                                                     std::map<ObjectHandle<const UniverseObject>, T>& object_property_values) const
 {
     object_property_values.clear();
     //Logger().debugStream() << "ValueRef::Statistic<T>::GetObjectPropertyValues source: " << source->Dump()
@@ -686,7 +805,7 @@ T ValueRef::Statistic<T>::Eval(const ScriptingContext& context) const
         return T(-1);   // should be INVALID_T of enum types
 
     // evaluate property for each condition-matched object
-    std::map<TemporaryPtr<const UniverseObject>, T> object_property_values;
+    std::map<ObjectHandle<const UniverseObject>, T> object_property_values;
     GetObjectPropertyValues(context, condition_matches, object_property_values);
 
     // count number of each result, tracking which has the most occurances
@@ -694,7 +813,7 @@ T ValueRef::Statistic<T>::Eval(const ScriptingContext& context) const
     typename std::map<T, unsigned int>::const_iterator most_common_property_value_it = histogram.begin();
     unsigned int max_seen(0);
 
-    for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+    for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
          it != object_property_values.end(); ++it)
     {
         const T& property_value = it->second;
@@ -728,7 +847,7 @@ namespace ValueRef {
 }
 
 template <class T>
-T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseObject>, T>& object_property_values) const
+T ValueRef::Statistic<T>::ReduceData(const std::map<ObjectHandle<const UniverseObject>, T>& object_property_values) const
 {
     if (object_property_values.empty())
         return T(0);
@@ -740,7 +859,7 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
         }
         case UNIQUE_COUNT: {
             std::set<T> observed_values;
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             { observed_values.insert(it->second); }
             return T(observed_values.size());
@@ -754,7 +873,7 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
         }
         case SUM: {
             T accumulator(0);
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             { accumulator += it->second; }
             return accumulator;
@@ -763,7 +882,7 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
 
         case MEAN: {
             T accumulator(0);
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             { accumulator += it->second; }
             return accumulator / static_cast<T>(object_property_values.size());
@@ -772,7 +891,7 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
 
         case RMS: {
             T accumulator(0);
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             { accumulator += (it->second * it->second); }
             accumulator /= static_cast<T>(object_property_values.size());
@@ -788,7 +907,7 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
             typename std::map<T, unsigned int>::const_iterator most_common_property_value_it = histogram.begin();
             unsigned int max_seen(0);
 
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             {
                 const T& property_value = it->second;
@@ -812,9 +931,9 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
         }
 
         case MAX: {
-            typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator max_it = object_property_values.begin();
+            typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator max_it = object_property_values.begin();
 
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             {
                 const T& property_value = it->second;
@@ -828,9 +947,9 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
         }
 
         case MIN: {
-            typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator min_it = object_property_values.begin();
+            typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator min_it = object_property_values.begin();
 
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             {
                 const T& property_value = it->second;
@@ -844,10 +963,10 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
         }
 
         case SPREAD: {
-            typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator max_it = object_property_values.begin();
-            typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator min_it = object_property_values.begin();
+            typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator max_it = object_property_values.begin();
+            typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator min_it = object_property_values.begin();
 
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             {
                 const T& property_value = it->second;
@@ -868,14 +987,14 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
 
             // find sample mean
             T accumulator(0);
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             { accumulator += it->second; }
             const T MEAN(accumulator / static_cast<T>(object_property_values.size()));
 
             // find average of squared deviations from sample mean
             accumulator = T(0);
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             { accumulator += (it->second - MEAN) * (it->second - MEAN); }
             const T MEAN_DEV2(accumulator / static_cast<T>(static_cast<int>(object_property_values.size()) - 1));
@@ -886,7 +1005,7 @@ T ValueRef::Statistic<T>::ReduceData(const std::map<TemporaryPtr<const UniverseO
 
         case PRODUCT: {
             T accumulator(1);
-            for (typename std::map<TemporaryPtr<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
+            for (typename std::map<ObjectHandle<const UniverseObject>, T>::const_iterator it = object_property_values.begin();
                  it != object_property_values.end(); ++it)
             { accumulator *= it->second; }
             return accumulator;
@@ -905,7 +1024,7 @@ template <class T>
 template <class Archive>
 void ValueRef::Statistic<T>::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Variable)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Variable<T>)
         & BOOST_SERIALIZATION_NVP(m_stat_type)
         & BOOST_SERIALIZATION_NVP(m_sampling_condition);
 }
@@ -1078,7 +1197,7 @@ template <class T>
 template <class Archive>
 void ValueRef::ComplexVariable<T>::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Variable)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Variable<T>)
         & BOOST_SERIALIZATION_NVP(m_int_ref1)
         & BOOST_SERIALIZATION_NVP(m_int_ref2)
         & BOOST_SERIALIZATION_NVP(m_string_ref1)
@@ -1152,7 +1271,7 @@ template <class FromType, class ToType>
 template <class Archive>
 void ValueRef::StaticCast<FromType, ToType>::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Variable<ToType>)
         & BOOST_SERIALIZATION_NVP(m_value_ref);
 }
 
@@ -1231,7 +1350,7 @@ template <class FromType>
 template <class Archive>
 void ValueRef::StringCast<FromType>::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Variable<std::string>)
         & BOOST_SERIALIZATION_NVP(m_value_ref);
 }
 
@@ -1241,7 +1360,7 @@ void ValueRef::StringCast<FromType>::serialize(Archive& ar, const unsigned int v
 template <class Archive>
 void ValueRef::UserStringLookup::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase<std::string>)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Variable<std::string>)
         & BOOST_SERIALIZATION_NVP(m_value_ref);
 }
 
@@ -1253,14 +1372,14 @@ ValueRef::Operation<T>::Operation(OpType op_type, const ValueRefBase<T>* operand
     m_op_type(op_type),
     m_operand1(operand1),
     m_operand2(operand2)
-{}
+{ DetermineInvariance(); }
 
 template <class T>
 ValueRef::Operation<T>::Operation(OpType op_type, const ValueRefBase<T>* operand) :
     m_op_type(op_type),
     m_operand1(operand),
     m_operand2(0)
-{}
+{ DetermineInvariance(); }
 
 template <class T>
 ValueRef::Operation<T>::~Operation()
@@ -1341,51 +1460,61 @@ namespace ValueRef {
 }
 
 template <class T>
-bool ValueRef::Operation<T>::RootCandidateInvariant() const
-{
-    if (m_op_type == RANDOM_UNIFORM)
-        return false;
-    if (m_operand1 && !m_operand1->RootCandidateInvariant())
-        return false;
-    if (m_operand2 && !m_operand2->RootCandidateInvariant())
-        return false;
-    return true;
+void ValueRef::Operation<T>::EvalForTargets(const ScriptingContext& context,
+                                            const std::vector<ObjectHandle<UniverseObject> >& targets,
+                                            std::vector<T>& values) const
+{ ValueRefBase<T>::EvalForTargets(context, targets, values); }
+
+namespace ValueRef {
+    template <>
+    void        Operation<double>::EvalForTargets(const ScriptingContext& context,
+                                                  const std::vector<ObjectHandle<UniverseObject> >& targets,
+                                                  std::vector<double>& values) const;
 }
 
+template <class T>
+bool ValueRef::Operation<T>::RootCandidateInvariant() const
+{ return m_root_candidate_invariant; }
+
 template <class T>
 bool ValueRef::Operation<T>::LocalCandidateInvariant() const
-{
-    if (m_op_type == RANDOM_UNIFORM)
-        return false;
-    if (m_operand1 && !m_operand1->LocalCandidateInvariant())
-        return false;
-    if (m_operand2 && !m_operand2->LocalCandidateInvariant())
-        return false;
-    return true;
-}
+{ return m_local_candidate_invariant; }
 
 template <class T>
 bool ValueRef::Operation<T>::TargetInvariant() const
+{ return m_target_invariant; }
+
+template <class T>
+bool ValueRef::Operation<T>::SourceInvariant() const
+{ return m_source_invariant; }
+
+template <class T>
+void ValueRef::Operation<T>::DetermineInvariance()
 {
-    if (m_op_type == RANDOM_UNIFORM)
-        return false;
-    if (m_operand1 && !m_operand1->TargetInvariant())
-        return false;
-    if (m_operand2 && !m_operand2->TargetInvariant())
-        return false;
-    return true;
+    // random values differ on each evaluation, so are never invariant
+    bool random = m_op_type == RANDOM_UNIFORM;
+    m_root_candidate_invariant = !random
+        && (!m_operand1 || m_operand1->RootCandidateInvariant())
+        && (!m_operand2 || m_operand2->RootCandidateInvariant());
+    m_local_candidate_invariant = !random
+        && (!m_operand1 || m_operand1->LocalCandidateInvariant())
+        && (!m_operand2 || m_operand2->LocalCandidateInvariant());
+    m_target_invariant = !random
+        && (!m_operand1 || m_operand1->TargetInvariant())
+        && (!m_operand2 || m_operand2->TargetInvariant());
+    m_source_invariant = !random
+        && (!m_operand1 || m_operand1->SourceInvariant())
+        && (!m_operand2 || m_operand2->SourceInvariant());
 }
 
 template <class T>
-bool ValueRef::Operation<T>::SourceInvariant() const
+void ValueRef::Operation<T>::FoldOperands()
 {
-    if (m_op_type == RANDOM_UNIFORM)
-        return false;
-    if (m_operand1 && !m_operand1->SourceInvariant())
-        return false;
-    if (m_operand2 && !m_operand2->SourceInvariant())
-        return false;
-    return true;
+    if (m_operand1)
+        m_operand1 = FoldConstants(m_operand1);
+    if (m_operand2)
+        m_operand2 = FoldConstants(m_operand2);
+    DetermineInvariance();
 }
 
 template <class T>
@@ -1560,10 +1689,12 @@ template <class T>
 template <class Archive>
 void ValueRef::Operation<T>::serialize(Archive& ar, const unsigned int version)
 {
-    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase)
+    ar  & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ValueRefBase<T>)
         & BOOST_SERIALIZATION_NVP(m_op_type)
         & BOOST_SERIALIZATION_NVP(m_operand1)
         & BOOST_SERIALIZATION_NVP(m_operand2);
+    if (Archive::is_loading::value)
+        DetermineInvariance();
 }
 
 template <class T>
@@ -1575,9 +1706,37 @@ bool ValueRef::ConstantExpr(const ValueRefBase<T>* expr)
     else if (dynamic_cast<const Variable<T>*>(expr))
         return false;
     else if (const Operation<T>* op = dynamic_cast<const Operation<T>*>(expr))
-        return ConstantExpr(op->LHS()) && ConstantExpr(op->RHS());
+        return op->GetOpType() != RANDOM_UNIFORM
+            && ConstantExpr(op->LHS())
+            && (!op->RHS() || ConstantExpr(op->RHS()));
     return false;
 }
 
+/** Replaces the Operations in \a expr whose operands are all constant with
+  * Constants holding their values, deleting the replaced nodes, and returns
+  * the resulting expression, which is \a expr itself unless \a expr was
+  * folded entirely.  \a expr must not be referenced by anything other than
+  * its caller, which takes ownership of the returned expression.  Intended
+  * to be run once on parsed content, so that constant parts of expressions
+  * aren't recalculated on every evaluation. */
+template <class T>
+const ValueRef::ValueRefBase<T>* ValueRef::FoldConstants(const ValueRefBase<T>* expr)
+{
+    const Operation<T>* op = dynamic_cast<const Operation<T>*>(expr);
+    if (!op)
+        return expr;
+
+    const_cast<Operation<T>*>(op)->FoldOperands();
+
+    // after folding, the operands of a constant operation are Constants
+    if (!ConstantExpr(op))
+        return expr;
+
+    const ValueRefBase<T>* retval = new Constant<T>(op->Eval(::ScriptingContext()));
+    delete op;
+    CountFoldedOperations(1);
+    return retval;
+}
+
 
 #endif // _ValueRef_h_
@@ -15,6 +15,82 @@ namespace ValueRef {
         CONDITION_LOCAL_CANDIDATE_REFERENCE,// ValueRef::Variable is evaluated on an object that is a candidate to be matched by a condition.  In a subcondition, this will reference the local candidate, and not the candidate of an enclosing condition.
         CONDITION_ROOT_CANDIDATE_REFERENCE  // ValueRef::Variable is evaluated on an object that is a candidate to be matched by a condition.  In a subcondition, this will still reference the root candidate, and not the candidate of the local condition.
     };
+    /** The properties a ValueRef::Variable can refer to, and the references
+      * to related objects that can precede them.  ValueRef::Variable resolves
+      * its property names to these once, so that evaluating it doesn't need
+      * to compare names.  Meters are referred to by their MeterType instead. */
+    enum VariableProperty {
+        INVALID_VARIABLE_PROPERTY = -1,
+        // references to related objects
+        PROPERTY_PLANET,
+        PROPERTY_SYSTEM,
+        PROPERTY_FLEET,
+        // non-object properties
+        PROPERTY_UNIVERSE_CENTRE_X,
+        PROPERTY_UNIVERSE_CENTRE_Y,
+        PROPERTY_CURRENT_TURN,
+        PROPERTY_GALAXY_SIZE,
+        PROPERTY_GALAXY_SHAPE,
+        PROPERTY_GALAXY_AGE,
+        PROPERTY_GALAXY_STARLANE_FREQUENCY,
+        PROPERTY_GALAXY_PLANET_DENSITY,
+        PROPERTY_GALAXY_SPECIAL_FREQUENCY,
+        PROPERTY_GALAXY_MONSTER_FREQUENCY,
+        PROPERTY_GALAXY_NATIVE_FREQUENCY,
+        PROPERTY_GALAXY_MAX_AI_AGGRESSION,
+        PROPERTY_GALAXY_SEED,
+        // object properties
+        PROPERTY_PLANET_SIZE,
+        PROPERTY_NEXT_LARGER_PLANET_SIZE,
+        PROPERTY_NEXT_SMALLER_PLANET_SIZE,
+        PROPERTY_PLANET_TYPE,
+        PROPERTY_ORIGINAL_TYPE,
+        PROPERTY_NEXT_CLOSER_TO_ORIGINAL_PLANET_TYPE,
+        PROPERTY_NEXT_BETTER_PLANET_TYPE,
+        PROPERTY_CLOCKWISE_NEXT_PLANET_TYPE,
+        PROPERTY_COUNTER_CLOCKWISE_NEXT_PLANET_TYPE,
+        PROPERTY_PLANET_ENVIRONMENT,
+        PROPERTY_OBJECT_TYPE,
+        PROPERTY_STAR_TYPE,
+        PROPERTY_NEXT_OLDER_STAR_TYPE,
+        PROPERTY_NEXT_YOUNGER_STAR_TYPE,
+        PROPERTY_TRADE_STOCKPILE,
+        PROPERTY_DISTANCE_TO_SOURCE,
+        PROPERTY_X,
+        PROPERTY_Y,
+        PROPERTY_SIZE_AS_DOUBLE,
+        PROPERTY_DISTANCE_FROM_ORIGINAL_TYPE,
+        PROPERTY_NEXT_TURN_POP_GROWTH,
+        PROPERTY_OWNER,
+        PROPERTY_ID,
+        PROPERTY_CREATION_TURN,
+        PROPERTY_AGE,
+        PROPERTY_TURNS_SINCE_FOCUS_CHANGE,
+        PROPERTY_PRODUCED_BY_EMPIRE_ID,
+        PROPERTY_DESIGN_ID,
+        PROPERTY_SPECIES,
+        PROPERTY_FLEET_ID,
+        PROPERTY_PLANET_ID,
+        PROPERTY_SYSTEM_ID,
+        PROPERTY_FINAL_DESTINATION_ID,
+        PROPERTY_NEXT_SYSTEM_ID,
+        PROPERTY_PREVIOUS_SYSTEM_ID,
+        PROPERTY_NUM_SHIPS,
+        PROPERTY_LAST_TURN_BATTLE_HERE,
+        PROPERTY_LAST_TURN_ACTIVE_IN_BATTLE,
+        PROPERTY_ORBIT,
+        PROPERTY_NAME,
+        PROPERTY_OWNER_NAME,
+        PROPERTY_TYPE_NAME,
+        PROPERTY_BUILDING_TYPE,
+        PROPERTY_FOCUS,
+        PROPERTY_PREFERRED_FOCUS,
+        PROPERTY_OWNER_LEAST_EXPENSIVE_ENQUEUED_TECH,
+        PROPERTY_OWNER_MOST_EXPENSIVE_ENQUEUED_TECH,
+        PROPERTY_OWNER_MOST_RP_COST_LEFT_ENQUEUED_TECH,
+        PROPERTY_OWNER_MOST_RP_SPENT_ENQUEUED_TECH,
+        PROPERTY_OWNER_TOP_PRIORITY_ENQUEUED_TECH
+    };
     template <class T> struct ValueRefBase;
     template <class T> struct Constant;
     template <class T> struct Variable;
@@ -55,6 +131,7 @@ namespace ValueRef {
         RANDOM_UNIFORM
     };
     template <class T> bool ConstantExpr(const ValueRefBase<T>* expr);
+    template <class T> const ValueRefBase<T>* FoldConstants(const ValueRefBase<T>* expr);
 }
 
 #endif // _ValueRefFwd_h_
@@ -0,0 +1,208 @@
+#include "VisibilityTable.h"
+
+#include "../util/AppInterface.h"
+
+#include <algorithm>
+
+namespace {
+    const int OBJECTS_PER_BYTE = 2;
+    const int BITS_PER_OBJECT = 4;
+    const boost::uint8_t ENTRY_MASK = 15;
+
+    // entries store Visibility + 1, so that 0 means no entry
+    const boost::uint8_t NO_ENTRY = 0;
+}
+
+///////////////////////////////////////////////////////////
+// VisibilityTable                                       //
+///////////////////////////////////////////////////////////
+Visibility VisibilityTable::Get(int empire_id, int object_id) const {
+    boost::uint8_t entry = GetEntry(empire_id, object_id);
+    if (entry == NO_ENTRY)
+        return VIS_NO_VISIBILITY;
+    return Visibility(entry - 1);
+}
+
+bool VisibilityTable::Has(int empire_id, int object_id) const
+{ return GetEntry(empire_id, object_id) != NO_ENTRY; }
+
+const std::vector<int>& VisibilityTable::EmpireIDs() const
+{ return m_empire_ids; }
+
+std::vector<int> VisibilityTable::VisibleObjectIDs(int empire_id) const {
+    std::vector<int> retval;
+    const Row* row = FindRow(empire_id);
+    if (!row)
+        return retval;
+    for (std::size_t byte = 0; byte < row->size(); ++byte) {
+        boost::uint8_t entries = (*row)[byte];
+        if (!entries)
+            continue;   // skip two objects at once if neither has an entry
+        for (int i = 0; i < OBJECTS_PER_BYTE; ++i)
+            if (((entries >> (i * BITS_PER_OBJECT)) & ENTRY_MASK) > VIS_NO_VISIBILITY + 1)
+                retval.push_back(static_cast<int>(byte) * OBJECTS_PER_BYTE + i);
+    }
+    return retval;
+}
+
+std::map<int, std::map<int, Visibility> > VisibilityTable::ToMap(int empire_id) const {
+    std::map<int, std::map<int, Visibility> > retval;
+    for (std::size_t i = 0; i < m_empire_ids.size(); ++i) {
+        if (empire_id != ALL_EMPIRES && m_empire_ids[i] != empire_id)
+            continue;
+        std::map<int, Visibility>& empire_map = retval[m_empire_ids[i]];
+        const Row& row = m_rows[i];
+        for (std::size_t byte = 0; byte < row.size(); ++byte) {
+            if (!row[byte])
+                continue;
+            for (int j = 0; j < OBJECTS_PER_BYTE; ++j) {
+                boost::uint8_t entry = (row[byte] >> (j * BITS_PER_OBJECT)) & ENTRY_MASK;
+                if (entry == NO_ENTRY)
+                    continue;
+                int object_id = static_cast<int>(byte) * OBJECTS_PER_BYTE + j;
+                empire_map.insert(empire_map.end(), std::make_pair(object_id, Visibility(entry - 1)));
+            }
+        }
+    }
+    return retval;
+}
+
+bool VisibilityTable::Raise(int empire_id, int object_id, Visibility vis) {
+    if (object_id < 0)
+        return false;
+    Row& row = GetRow(empire_id);
+    if (vis < VIS_NO_VISIBILITY || vis >= NUM_VISIBILITIES)
+        return false;
+    std::size_t byte = object_id / OBJECTS_PER_BYTE;
+    if (byte >= row.size())
+        row.resize(byte + 1, NO_ENTRY);
+    int shift = (object_id % OBJECTS_PER_BYTE) * BITS_PER_OBJECT;
+    boost::uint8_t entry = vis + 1;
+    if (((row[byte] >> shift) & ENTRY_MASK) >= entry)
+        return false;
+    row[byte] = (row[byte] & ~(ENTRY_MASK << shift)) | (entry << shift);
+    return true;
+}
+
+void VisibilityTable::Clear() {
+    m_empire_ids.clear();
+    m_rows.clear();
+}
+
+void VisibilityTable::FromMap(const std::map<int, std::map<int, Visibility> >& visibilities) {
+    Clear();
+    for (std::map<int, std::map<int, Visibility> >::const_iterator empire_it = visibilities.begin();
+         empire_it != visibilities.end(); ++empire_it)
+    {
+        GetRow(empire_it->first);
+        for (std::map<int, Visibility>::const_iterator it = empire_it->second.begin();
+             it != empire_it->second.end(); ++it)
+        { Raise(empire_it->first, it->first, it->second); }
+    }
+}
+
+boost::uint8_t VisibilityTable::GetEntry(int empire_id, int object_id) const {
+    if (object_id < 0)
+        return NO_ENTRY;
+    const Row* row = FindRow(empire_id);
+    if (!row)
+        return NO_ENTRY;
+    std::size_t byte = object_id / OBJECTS_PER_BYTE;
+    if (byte >= row->size())
+        return NO_ENTRY;
+    int shift = (object_id % OBJECTS_PER_BYTE) * BITS_PER_OBJECT;
+    return ((*row)[byte] >> shift) & ENTRY_MASK;
+}
+
+const VisibilityTable::Row* VisibilityTable::FindRow(int empire_id) const {
+    std::vector<int>::const_iterator it = std::lower_bound(m_empire_ids.begin(), m_empire_ids.end(), empire_id);
+    if (it == m_empire_ids.end() || *it != empire_id)
+        return 0;
+    return &m_rows[it - m_empire_ids.begin()];
+}
+
+VisibilityTable::Row& VisibilityTable::GetRow(int empire_id) {
+    std::vector<int>::iterator it = std::lower_bound(m_empire_ids.begin(), m_empire_ids.end(), empire_id);
+    std::size_t index = it - m_empire_ids.begin();
+    if (it == m_empire_ids.end() || *it != empire_id) {
+        m_empire_ids.insert(it, empire_id);
+        m_rows.insert(m_rows.begin() + index, Row());
+    }
+    return m_rows[index];
+}
+
+///////////////////////////////////////////////////////////
+// VisibilityTurnTable                                   //
+///////////////////////////////////////////////////////////
+std::map<Visibility, int> VisibilityTurnTable::Get(int empire_id, int object_id) const {
+    std::map<Visibility, int> retval;
+    if (object_id < 0)
+        return retval;
+    std::map<int, Row>::const_iterator row_it = m_rows.find(empire_id);
+    if (row_it == m_rows.end())
+        return retval;
+    const Row& row = row_it->second;
+    std::size_t first = static_cast<std::size_t>(object_id) * NUM_SEEN_VISIBILITIES;
+    if (first >= row.size())
+        return retval;
+    for (int i = 0; i < NUM_SEEN_VISIBILITIES; ++i)
+        if (row[first + i] != INVALID_GAME_TURN)
+            retval[Visibility(VIS_BASIC_VISIBILITY + i)] = row[first + i];
+    return retval;
+}
+
+std::map<int, std::map<int, std::map<Visibility, int> > > VisibilityTurnTable::ToMap(int empire_id) const {
+    std::map<int, std::map<int, std::map<Visibility, int> > > retval;
+    for (std::map<int, Row>::const_iterator row_it = m_rows.begin(); row_it != m_rows.end(); ++row_it) {
+        if (empire_id != ALL_EMPIRES && row_it->first != empire_id)
+            continue;
+        std::map<int, std::map<Visibility, int> >& empire_map = retval[row_it->first];
+        const Row& row = row_it->second;
+        for (std::size_t first = 0; first < row.size(); first += NUM_SEEN_VISIBILITIES) {
+            // objects that were never seen have no entry
+            int object_id = static_cast<int>(first / NUM_SEEN_VISIBILITIES);
+            std::map<Visibility, int> object_turns = Get(row_it->first, object_id);
+            if (!object_turns.empty())
+                empire_map.insert(empire_map.end(), std::make_pair(object_id, object_turns));
+        }
+    }
+    return retval;
+}
+
+void VisibilityTurnTable::SetSeen(int empire_id, int object_id, Visibility vis, int turn) {
+    if (object_id < 0 || vis <= VIS_NO_VISIBILITY || vis >= NUM_VISIBILITIES)
+        return;
+    Row& row = m_rows[empire_id];
+    std::size_t first = static_cast<std::size_t>(object_id) * NUM_SEEN_VISIBILITIES;
+    if (first >= row.size())
+        row.resize(first + NUM_SEEN_VISIBILITIES, INVALID_GAME_TURN);
+    for (int i = 0; i < vis - VIS_NO_VISIBILITY; ++i)
+        row[first + i] = turn;
+}
+
+void VisibilityTurnTable::Clear()
+{ m_rows.clear(); }
+
+void VisibilityTurnTable::FromMap(const std::map<int, std::map<int, std::map<Visibility, int> > >& visibility_turns) {
+    Clear();
+    for (std::map<int, std::map<int, std::map<Visibility, int> > >::const_iterator empire_it = visibility_turns.begin();
+         empire_it != visibility_turns.end(); ++empire_it)
+    {
+        Row& row = m_rows[empire_it->first];
+        for (std::map<int, std::map<Visibility, int> >::const_iterator object_it = empire_it->second.begin();
+             object_it != empire_it->second.end(); ++object_it)
+        {
+            if (object_it->first < 0)
+                continue;
+            std::size_t first = static_cast<std::size_t>(object_it->first) * NUM_SEEN_VISIBILITIES;
+            if (first >= row.size())
+                row.resize(first + NUM_SEEN_VISIBILITIES, INVALID_GAME_TURN);
+            for (std::map<Visibility, int>::const_iterator it = object_it->second.begin();
+                 it != object_it->second.end(); ++it)
+            {
+                if (it->first > VIS_NO_VISIBILITY && it->first < NUM_VISIBILITIES)
+                    row[first + it->first - VIS_BASIC_VISIBILITY] = it->second;
+            }
+        }
+    }
+}
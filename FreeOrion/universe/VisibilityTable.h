@@ -0,0 +1,114 @@
+// -*- C++ -*-
+#ifndef _VisibilityTable_h_
+#define _VisibilityTable_h_
+
+#include "Enums.h"
+#include "../util/Export.h"
+
+#include <boost/cstdint.hpp>
+
+#include <map>
+#include <vector>
+
+/** The Visibility each empire has of each object.  For each empire, 4 bits
+  * are stored per object, in a vector indexed by object id.  Object ids are
+  * allocated sequentially, so the vectors are about as long as the number of
+  * objects, and getting or setting an object's visibility doesn't need to
+  * search for it.  An object can have an entry with VIS_NO_VISIBILITY, which
+  * is distinct from having no entry at all. */
+class FO_COMMON_API VisibilityTable {
+public:
+    /** \name Accessors */ //@{
+    /** Returns the Visibility of object with id \a object_id for the empire
+      * with id \a empire_id, or VIS_NO_VISIBILITY if none has been set. */
+    Visibility          Get(int empire_id, int object_id) const;
+
+    /** Returns true iff a Visibility, including VIS_NO_VISIBILITY, has been
+      * set for object with id \a object_id for the empire with id
+      * \a empire_id. */
+    bool                Has(int empire_id, int object_id) const;
+
+    /** Returns the ids of the empires that have visibilities in the table. */
+    const std::vector<int>&
+                        EmpireIDs() const;
+
+    /** Returns the ids of objects the empire with id \a empire_id has better
+      * than VIS_NO_VISIBILITY of, in increasing order. */
+    std::vector<int>    VisibleObjectIDs(int empire_id) const;
+
+    /** Returns the visibilities of the empire with id \a empire_id, or of all
+      * empires if \a empire_id is ALL_EMPIRES, as a map from empire id to map
+      * from object id to Visibility, which is how they are serialized.  All
+      * entries are included, including those with VIS_NO_VISIBILITY. */
+    std::map<int, std::map<int, Visibility> >
+                        ToMap(int empire_id) const;
+    //@}
+
+    /** \name Mutators */ //@{
+    /** Sets the Visibility of object with id \a object_id for the empire with
+      * id \a empire_id to \a vis, if none is set yet or \a vis is better than
+      * the Visibility already set.  The empire is included in EmpireIDs()
+      * afterwards, even if the Visibility wasn't changed.  Returns true iff
+      * the Visibility was changed. */
+    bool                Raise(int empire_id, int object_id, Visibility vis);
+
+    void                Clear();
+
+    /** Replaces the visibilities with those in \a visibilities. */
+    void                FromMap(const std::map<int, std::map<int, Visibility> >& visibilities);
+    //@}
+
+private:
+    typedef std::vector<boost::uint8_t> Row;    ///< 4 bits per object, 2 objects per byte
+
+    boost::uint8_t      GetEntry(int empire_id, int object_id) const;
+    const Row*          FindRow(int empire_id) const;
+    Row&                GetRow(int empire_id);
+
+    std::vector<int>    m_empire_ids;           ///< sorted ids of empires that have rows
+    std::vector<Row>    m_rows;                 ///< indexed in the same order as m_empire_ids
+};
+
+/** The most recent turns on which each empire has seen each object at each
+  * Visibility better than VIS_NO_VISIBILITY.  For each empire, a turn number
+  * is stored for each of those visibilities, per object, in a vector indexed
+  * by object id. */
+class FO_COMMON_API VisibilityTurnTable {
+public:
+    /** \name Accessors */ //@{
+    /** Returns the map from Visibility to most recent turn on which the
+      * object with id \a object_id was seen at that Visibility by the empire
+      * with id \a empire_id.  Visibilities at which the object hasn't been
+      * seen are not included. */
+    std::map<Visibility, int>
+                        Get(int empire_id, int object_id) const;
+
+    /** Returns the visibility turns of the empire with id \a empire_id, or of
+      * all empires if \a empire_id is ALL_EMPIRES, as a map from empire id to
+      * map from object id to map from Visibility to turn, which is how they
+      * are serialized. */
+    std::map<int, std::map<int, std::map<Visibility, int> > >
+                        ToMap(int empire_id) const;
+    //@}
+
+    /** \name Mutators */ //@{
+    /** Records that the empire with id \a empire_id saw the object with id
+      * \a object_id at \a vis, and thus also at any lower Visibility, on turn
+      * \a turn. */
+    void                SetSeen(int empire_id, int object_id, Visibility vis, int turn);
+
+    void                Clear();
+
+    /** Replaces the visibility turns with those in \a visibility_turns. */
+    void                FromMap(const std::map<int, std::map<int, std::map<Visibility, int> > >& visibility_turns);
+    //@}
+
+private:
+    typedef std::vector<int>    Row;            ///< NUM_SEEN_VISIBILITIES turns per object
+
+    static const int NUM_SEEN_VISIBILITIES = VIS_FULL_VISIBILITY - VIS_NO_VISIBILITY;
+
+    std::map<int, Row>  m_rows;                 ///< indexed by empire id
+};
+
+#endif // _VisibilityTable_h_
@@ -0,0 +1,345 @@
+#include "Compression.h"
+
+#include "OptionsDB.h"
+#include "Logger.h"
+#include "i18n.h"
+
+#include <boost/cstdint.hpp>
+#include <boost/timer.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace {
+    void AddOptions(OptionsDB& db) {
+        db.Add<std::string>("compression", UserStringNop("OPTIONS_DB_COMPRESSION_DESC"), "zlib-fast");
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    // Compressed data starts with COMPRESSED_DATA_MAGIC and a codec byte,
+    // followed by the uncompressed and the compressed size as 32 bit little
+    // endian numbers.  Binary and XML archives never start with these bytes,
+    // so compressed and uncompressed data can be told apart.
+    const char          COMPRESSED_DATA_MAGIC[] = { 'F', 'O', 'Z' };
+    const std::size_t   MAGIC_SIZE = sizeof(COMPRESSED_DATA_MAGIC);
+    const std::size_t   HEADER_SIZE = MAGIC_SIZE + 1 + 2 * 4;
+
+    enum Codec {
+        CODEC_STORED = 0,   // data is not compressed
+        CODEC_ZLIB = 1
+    };
+
+    // data smaller than this is not worth compressing
+    const std::size_t   MIN_COMPRESSED_DATA_SIZE = 4096;
+
+    /** Returns the zlib compression level for the codec selected in the
+      * options, or Z_NO_COMPRESSION if compression is disabled. */
+    int CompressionLevel() {
+        const std::string codec = GetOptionsDB().Get<std::string>("compression");
+        if (codec == "none")
+            return Z_NO_COMPRESSION;
+        if (codec == "zlib-fast")
+            return Z_BEST_SPEED;
+        if (codec != "zlib")
+            Logger().errorStream() << "CompressionLevel: unknown compression codec " << codec << ", using zlib";
+        return Z_DEFAULT_COMPRESSION;
+    }
+
+    void WriteSize(char* buffer, std::size_t size) {
+        for (std::size_t i = 0; i < 4; ++i)
+            buffer[i] = static_cast<char>((size >> (8 * i)) & 0xff);
+    }
+
+    std::size_t ReadSize(const char* buffer) {
+        std::size_t retval = 0;
+        for (std::size_t i = 0; i < 4; ++i)
+            retval |= static_cast<std::size_t>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+        return retval;
+    }
+
+    void WriteHeader(char* header, Codec codec, std::size_t uncompressed_size, std::size_t compressed_size) {
+        std::copy(COMPRESSED_DATA_MAGIC, COMPRESSED_DATA_MAGIC + MAGIC_SIZE, header);
+        header[MAGIC_SIZE] = static_cast<char>(codec);
+        WriteSize(header + MAGIC_SIZE + 1, uncompressed_size);
+        WriteSize(header + MAGIC_SIZE + 5, compressed_size);
+    }
+
+    /** Returns true if \a header is the header of compressed data, and sets
+      * \a codec, \a uncompressed_size and \a compressed_size from it. */
+    bool ReadHeader(const char* header, Codec& codec, std::size_t& uncompressed_size, std::size_t& compressed_size) {
+        if (!std::equal(COMPRESSED_DATA_MAGIC, COMPRESSED_DATA_MAGIC + MAGIC_SIZE, header))
+            return false;
+        codec = static_cast<Codec>(header[MAGIC_SIZE]);
+        uncompressed_size = ReadSize(header + MAGIC_SIZE + 1);
+        compressed_size = ReadSize(header + MAGIC_SIZE + 5);
+        return true;
+    }
+
+    void Decompress(const char* data, Codec codec, std::size_t uncompressed_size, std::size_t compressed_size,
+                    std::string& decompressed)
+    {
+        if (codec == CODEC_STORED) {
+            if (compressed_size != uncompressed_size)
+                throw std::runtime_error("Decompress: corrupt stored data");
+            decompressed.assign(data, compressed_size);
+            return;
+        }
+        if (codec != CODEC_ZLIB)
+            throw std::runtime_error("Decompress: unknown compression codec");
+
+        boost::timer timer;
+        std::string result(uncompressed_size, '\0');
+        uLongf result_size = uncompressed_size;
+        int status = uncompress(reinterpret_cast<Bytef*>(&result[0]), &result_size,
+                                reinterpret_cast<const Bytef*>(data), compressed_size);
+        if (status != Z_OK || result_size != uncompressed_size)
+            throw std::runtime_error("Decompress: corrupt compressed data");
+        decompressed.swap(result);
+        Logger().debugStream() << "Decompress: " << compressed_size << " -> " << uncompressed_size
+                               << " bytes in " << (timer.elapsed() * 1000.0) << " ms";
+    }
+
+    // A delta starts with DELTA_MAGIC, followed by the size and CRC-32 of the
+    // base and of the encoded data as 32 bit little endian numbers.  The rest
+    // is a sequence of operations, each a DeltaOp byte followed by variable
+    // length numbers: DELTA_COPY copies a range of the base, given by offset
+    // and length, DELTA_LITERAL inserts the given number of bytes that follow.
+    const char          DELTA_MAGIC[] = { 'F', 'O', 'D' };
+    const std::size_t   DELTA_MAGIC_SIZE = sizeof(DELTA_MAGIC);
+    const std::size_t   DELTA_HEADER_SIZE = DELTA_MAGIC_SIZE + 4 * 4;
+
+    enum DeltaOp {
+        DELTA_COPY = 0,
+        DELTA_LITERAL = 1
+    };
+
+    // matches between data and base are searched for by comparing hashes of
+    // blocks of this size.  the base is indexed at multiples of it, the data
+    // at every position.
+    const std::size_t       DELTA_BLOCK_SIZE = 64;
+    const boost::uint32_t   DELTA_HASH_FACTOR = 16777619u;
+    // number of base blocks with the same hash that are checked for a match
+    const std::size_t       MAX_DELTA_CANDIDATES = 8;
+
+    typedef std::vector<std::pair<boost::uint32_t, std::size_t> > BlockIndex;
+
+    boost::uint32_t BlockHash(const char* block) {
+        boost::uint32_t retval = 0;
+        for (std::size_t i = 0; i < DELTA_BLOCK_SIZE; ++i)
+            retval = retval * DELTA_HASH_FACTOR + static_cast<unsigned char>(block[i]);
+        return retval;
+    }
+
+    /** Returns DELTA_HASH_FACTOR ^ (DELTA_BLOCK_SIZE - 1), the factor of the
+      * first byte of a block in its hash. */
+    boost::uint32_t LeadingByteFactor() {
+        boost::uint32_t retval = 1;
+        for (std::size_t i = 1; i < DELTA_BLOCK_SIZE; ++i)
+            retval *= DELTA_HASH_FACTOR;
+        return retval;
+    }
+
+    boost::uint32_t Crc32(const std::string& data)
+    { return crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(data.data()), data.size()); }
+
+    void WriteVarSize(std::string& out, std::size_t size) {
+        while (size >= 0x80) {
+            out.push_back(static_cast<char>((size & 0x7f) | 0x80));
+            size >>= 7;
+        }
+        out.push_back(static_cast<char>(size));
+    }
+
+    std::size_t ReadVarSize(const std::string& in, std::size_t& pos) {
+        std::size_t retval = 0;
+        for (std::size_t shift = 0; pos < in.size() && shift < 8 * sizeof(std::size_t); shift += 7) {
+            unsigned char byte = static_cast<unsigned char>(in[pos++]);
+            retval |= static_cast<std::size_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return retval;
+        }
+        throw std::runtime_error("DecodeDelta: corrupt delta");
+    }
+
+    void WriteLiteral(std::string& delta, const std::string& data, std::size_t begin, std::size_t end) {
+        if (begin == end)
+            return;
+        delta.push_back(static_cast<char>(DELTA_LITERAL));
+        WriteVarSize(delta, end - begin);
+        delta.append(data, begin, end - begin);
+    }
+}
+
+void CompressData(const std::string& data, std::string& compressed) {
+    int level = data.size() < MIN_COMPRESSED_DATA_SIZE ? Z_NO_COMPRESSION : CompressionLevel();
+    if (level != Z_NO_COMPRESSION) {
+        boost::timer timer;
+        std::string result(HEADER_SIZE + compressBound(data.size()), '\0');
+        uLongf compressed_size = result.size() - HEADER_SIZE;
+        int status = compress2(reinterpret_cast<Bytef*>(&result[HEADER_SIZE]), &compressed_size,
+                               reinterpret_cast<const Bytef*>(data.data()), data.size(), level);
+        if (status == Z_OK) {
+            result.resize(HEADER_SIZE + compressed_size);
+            WriteHeader(&result[0], CODEC_ZLIB, data.size(), compressed_size);
+            compressed.swap(result);
+            Logger().debugStream() << "CompressData: " << data.size() << " -> " << compressed.size()
+                                   << " bytes (" << (100.0 * compressed.size() / data.size()) << "%) in "
+                                   << (timer.elapsed() * 1000.0) << " ms";
+            return;
+        }
+        Logger().errorStream() << "CompressData: compression failed with zlib error " << status;
+    }
+
+    std::string result(HEADER_SIZE, '\0');
+    WriteHeader(&result[0], CODEC_STORED, data.size(), data.size());
+    result.append(data);
+    compressed.swap(result);
+}
+
+bool DecompressData(const std::string& data, std::string& decompressed) {
+    Codec codec = CODEC_STORED;
+    std::size_t uncompressed_size = 0, compressed_size = 0;
+    if (data.size() < HEADER_SIZE || !ReadHeader(data.data(), codec, uncompressed_size, compressed_size))
+        return false;
+    if (data.size() - HEADER_SIZE < compressed_size)
+        throw std::runtime_error("DecompressData: truncated compressed data");
+    Decompress(data.data() + HEADER_SIZE, codec, uncompressed_size, compressed_size, decompressed);
+    return true;
+}
+
+bool DecompressData(std::istream& is, std::string& decompressed) {
+    std::streampos start = is.tellg();
+    char header[HEADER_SIZE];
+    Codec codec = CODEC_STORED;
+    std::size_t uncompressed_size = 0, compressed_size = 0;
+    if (!is.read(header, HEADER_SIZE) || !ReadHeader(header, codec, uncompressed_size, compressed_size)) {
+        is.clear();
+        is.seekg(start);
+        return false;
+    }
+
+    std::string data(compressed_size, '\0');
+    if (compressed_size && !is.read(&data[0], compressed_size))
+        throw std::runtime_error("DecompressData: truncated compressed data");
+    Decompress(data.data(), codec, uncompressed_size, compressed_size, decompressed);
+    return true;
+}
+
+void EncodeDelta(const std::string& base, const std::string& data, std::string& delta) {
+    boost::timer timer;
+    std::string result(DELTA_HEADER_SIZE, '\0');
+    std::copy(DELTA_MAGIC, DELTA_MAGIC + DELTA_MAGIC_SIZE, result.begin());
+    WriteSize(&result[DELTA_MAGIC_SIZE], base.size());
+    WriteSize(&result[DELTA_MAGIC_SIZE + 4], Crc32(base));
+    WriteSize(&result[DELTA_MAGIC_SIZE + 8], data.size());
+    WriteSize(&result[DELTA_MAGIC_SIZE + 12], Crc32(data));
+
+    BlockIndex base_blocks;
+    base_blocks.reserve(base.size() / DELTA_BLOCK_SIZE);
+    for (std::size_t offset = 0; offset + DELTA_BLOCK_SIZE <= base.size(); offset += DELTA_BLOCK_SIZE)
+        base_blocks.push_back(std::make_pair(BlockHash(&base[offset]), offset));
+    std::sort(base_blocks.begin(), base_blocks.end());
+
+    const boost::uint32_t leading_byte_factor = LeadingByteFactor();
+    std::size_t literal_begin = 0;
+    std::size_t pos = 0;
+    boost::uint32_t hash = data.size() >= DELTA_BLOCK_SIZE ? BlockHash(&data[0]) : 0;
+    while (pos + DELTA_BLOCK_SIZE <= data.size()) {
+        // find the longest match among the base blocks with the same hash
+        std::size_t match_offset = 0, match_length = 0;
+        BlockIndex::const_iterator it = std::lower_bound(base_blocks.begin(), base_blocks.end(),
+                                                         std::make_pair(hash, std::size_t(0)));
+        for (std::size_t candidates = 0;
+             it != base_blocks.end() && it->first == hash && candidates < MAX_DELTA_CANDIDATES;
+             ++it, ++candidates)
+        {
+            std::size_t offset = it->second;
+            if (std::memcmp(&base[offset], &data[pos], DELTA_BLOCK_SIZE) != 0)
+                continue;
+            std::size_t length = DELTA_BLOCK_SIZE;
+            while (offset + length < base.size() && pos + length < data.size() &&
+                   base[offset + length] == data[pos + length])
+            { ++length; }
+            if (length > match_length) {
+                match_offset = offset;
+                match_length = length;
+            }
+        }
+
+        if (!match_length) {
+            if (pos + DELTA_BLOCK_SIZE < data.size())
+                hash = (hash - static_cast<unsigned char>(data[pos]) * leading_byte_factor) * DELTA_HASH_FACTOR +
+                    static_cast<unsigned char>(data[pos + DELTA_BLOCK_SIZE]);
+            ++pos;
+            continue;
+        }
+
+        // the match may also cover the end of the pending literal bytes
+        while (pos > literal_begin && match_offset > 0 && base[match_offset - 1] == data[pos - 1]) {
+            --pos;
+            --match_offset;
+            ++match_length;
+        }
+
+        WriteLiteral(result, data, literal_begin, pos);
+        result.push_back(static_cast<char>(DELTA_COPY));
+        WriteVarSize(result, match_offset);
+        WriteVarSize(result, match_length);
+
+        pos += match_length;
+        literal_begin = pos;
+        if (pos + DELTA_BLOCK_SIZE <= data.size())
+            hash = BlockHash(&data[pos]);
+    }
+    WriteLiteral(result, data, literal_begin, data.size());
+    delta.swap(result);
+
+    Logger().debugStream() << "EncodeDelta: " << data.size() << " -> " << delta.size() << " bytes ("
+                           << (data.empty() ? 100.0 : 100.0 * delta.size() / data.size()) << "%) in "
+                           << (timer.elapsed() * 1000.0) << " ms";
+}
+
+bool DecodeDelta(const std::string& base, const std::string& delta, std::string& data) {
+    if (delta.size() < DELTA_HEADER_SIZE ||
+        !std::equal(DELTA_MAGIC, DELTA_MAGIC + DELTA_MAGIC_SIZE, delta.begin()))
+    { return false; }
+
+    if (ReadSize(&delta[DELTA_MAGIC_SIZE]) != base.size() ||
+        ReadSize(&delta[DELTA_MAGIC_SIZE + 4]) != Crc32(base))
+    { throw std::runtime_error("DecodeDelta: delta doesn't match its base"); }
+
+    std::string result;
+    result.reserve(ReadSize(&delta[DELTA_MAGIC_SIZE + 8]));
+    std::size_t pos = DELTA_HEADER_SIZE;
+    while (pos < delta.size()) {
+        char op = delta[pos++];
+        if (op == DELTA_COPY) {
+            std::size_t offset = ReadVarSize(delta, pos);
+            std::size_t length = ReadVarSize(delta, pos);
+            if (offset > base.size() || length > base.size() - offset)
+                throw std::runtime_error("DecodeDelta: corrupt delta");
+            result.append(base, offset, length);
+        } else if (op == DELTA_LITERAL) {
+            std::size_t length = ReadVarSize(delta, pos);
+            if (length > delta.size() - pos)
+                throw std::runtime_error("DecodeDelta: corrupt delta");
+            result.append(delta, pos, length);
+            pos += length;
+        } else {
+            throw std::runtime_error("DecodeDelta: corrupt delta");
+        }
+    }
+
+    if (result.size() != ReadSize(&delta[DELTA_MAGIC_SIZE + 8]) ||
+        Crc32(result) != ReadSize(&delta[DELTA_MAGIC_SIZE + 12]))
+    { throw std::runtime_error("DecodeDelta: corrupt delta"); }
+    data.swap(result);
+    return true;
+}
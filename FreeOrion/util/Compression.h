@@ -0,0 +1,41 @@
+// -*- C++ -*-
+#ifndef _Compression_h_
+#define _Compression_h_
+
+#include <iosfwd>
+#include <string>
+
+#include "Export.h"
+
+/** Compresses \a data into \a compressed, using the codec selected with the
+  * "compression" option.  The result starts with a header that identifies
+  * it as compressed data and records its codec and sizes.  If compression
+  * is disabled or \a data is too small to be worth compressing, \a data is
+  * stored as is after the header. */
+FO_COMMON_API void CompressData(const std::string& data, std::string& compressed);
+
+/** Decompresses \a data into \a decompressed, if \a data was produced by
+  * CompressData.  Returns false and leaves \a decompressed unchanged if
+  * \a data is not compressed.  Throws std::runtime_error if \a data is
+  * compressed but can't be decompressed. */
+FO_COMMON_API bool DecompressData(const std::string& data, std::string& decompressed);
+
+/** Reads data produced by CompressData from the current position of \a is
+  * and decompresses it into \a decompressed.  Returns false and leaves the
+  * position of \a is unchanged if the data there is not compressed.  Throws
+  * std::runtime_error if the compressed data can't be read or decompressed. */
+FO_COMMON_API bool DecompressData(std::istream& is, std::string& decompressed);
+
+/** Encodes \a data as the differences to \a base into \a delta.  Parts of
+  * \a data that also occur in \a base are replaced by references to them,
+  * so \a delta is small if \a data is mostly the same as \a base. */
+FO_COMMON_API void EncodeDelta(const std::string& base, const std::string& data, std::string& delta);
+
+/** Reconstructs the data encoded in \a delta against \a base into \a data,
+  * if \a delta was produced by EncodeDelta.  Returns false and leaves
+  * \a data unchanged if \a delta is not a delta.  Throws std::runtime_error
+  * if \a base is not what \a delta was encoded against, or \a delta is
+  * corrupt. */
+FO_COMMON_API bool DecodeDelta(const std::string& base, const std::string& delta, std::string& data);
+
+#endif // _Compression_h_
@@ -1,52 +1,70 @@
 #ifndef _Run_Queue_h_
 #define _Run_Queue_h_
 
+#include <boost/detail/atomic_count.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
-#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <deque>
 #include <vector>
 
 template <class WorkItem>
 class RunQueue;
 
+/** Per-thread work deque of a RunQueue.  New work is pushed and the owning
+  * thread pops at the back, idle threads steal from the front.  The mutex is
+  * only contended while work is added or another thread is stealing. */
 template <class WorkItem>
 struct ThreadQueue : public boost::noncopyable {
     RunQueue<WorkItem>*     global_queue;
-    volatile unsigned       running_queue_size;
-    volatile unsigned       schedule_queue_size;
-    std::vector<WorkItem*>* running_queue;
-    std::vector<WorkItem*>* schedule_queue;
-    std::vector<WorkItem*>  work_queue_1;
-    std::vector<WorkItem*>  work_queue_2;
+    unsigned                index;
+    boost::mutex            mutex;
+    std::deque<WorkItem*>   work_queue;
     boost::thread           thread;
 
-    ThreadQueue(RunQueue<WorkItem>* the_global_queue);
-    void operator ()();
+    ThreadQueue(RunQueue<WorkItem>* the_global_queue, unsigned the_index);
+    WorkItem*   PopBack();
+    WorkItem*   PopFront();
+    void        operator ()();
 };
 
+/** Work-stealing thread pool.  Work items are heap allocated callables that
+  * are handed over with AddWork(), executed once by one of the worker threads
+  * and deleted afterwards.  Items are distributed round-robin over the
+  * threads' deques; a thread that runs out of work steals from the others, so
+  * there is no global lock on the path of fetching and executing work. */
 template <class WorkItem>
 class RunQueue : public boost::noncopyable {
 public:
     RunQueue(unsigned n_threads);
     ~RunQueue();
+
+    /** Schedules \a item for execution. Takes ownership of \a item. */
     void AddWork(WorkItem* item);
-    void Wait(boost::unique_lock<boost::shared_mutex>& lock);
+
+    /** Blocks until all added work items have been executed. */
+    void Wait();
+
+    /** Returns the number of worker threads. */
+    unsigned NumThreads() const { return m_thread_queues.size(); }
 
 private:
     volatile bool                   m_terminate;
-    boost::shared_mutex             m_schedule_mutex;
-    boost::condition_variable_any   m_work_available;
-    boost::condition_variable_any   m_work_done;
+    boost::detail::atomic_count     m_queued_items;     // items waiting in any thread's deque
+    boost::detail::atomic_count     m_pending_items;    // items queued or currently executing
+    unsigned                        m_next_queue;       // round-robin position for AddWork
+    boost::mutex                    m_idle_mutex;
+    boost::condition_variable       m_work_available;
+    boost::condition_variable       m_work_done;
     std::vector< boost::shared_ptr< ThreadQueue<WorkItem> > > m_thread_queues;
-    std::vector<WorkItem*>          m_transfer_queue;
-    volatile unsigned               m_transfer_queue_size;
 
     friend struct ThreadQueue<WorkItem>;
-    void GetTotalWorkload(unsigned& total_workload, unsigned& scheduleable_workload);
-    bool Schedule(ThreadQueue<WorkItem>& requested_by);
+    WorkItem*   Steal(unsigned thief_index);
+    bool        WaitForWork();
+    void        WorkItemDone();
 };
 
 #include "RunQueue.tcc"
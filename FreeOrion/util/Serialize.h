@@ -18,11 +18,21 @@ typedef boost::archive::xml_oarchive freeorion_oarchive;
 #endif
 
 #include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "Export.h"
 
+class BuildingType;
+class HullType;
 class OrderSet;
+class PartType;
 class PathingEngine;
+class ShipDesign;
+class Species;
+class Tech;
+struct TechCategory;
 class Universe;
 class UniverseObject;
 template <class T> class TemporaryPtr;
@@ -42,6 +52,26 @@ void Serialize(freeorion_oarchive& oa, const OrderSet& order_set);
 /** Serializes \a pathing_engine to output archive \a oa. */
 void Serialize(freeorion_oarchive& oa, const PathingEngine& pathing_engine);
 
+/** Serializes \a building_types to output archive \a oa. */
+FO_COMMON_API void Serialize(freeorion_oarchive& oa, const std::map<std::string, BuildingType*>& building_types);
+
+/** Serializes \a species to output archive \a oa. */
+FO_COMMON_API void Serialize(freeorion_oarchive& oa, const std::map<std::string, Species*>& species);
+
+/** Serializes \a parts to output archive \a oa. */
+FO_COMMON_API void Serialize(freeorion_oarchive& oa, const std::map<std::string, PartType*>& parts);
+
+/** Serializes \a hulls to output archive \a oa. */
+FO_COMMON_API void Serialize(freeorion_oarchive& oa, const std::map<std::string, HullType*>& hulls);
+
+/** Serializes \a designs to output archive \a oa. */
+FO_COMMON_API void Serialize(freeorion_oarchive& oa, const std::map<std::string, ShipDesign*>& designs);
+
+/** Serializes \a techs, \a categories and \a categories_seen to output archive \a oa. */
+FO_COMMON_API void Serialize(freeorion_oarchive& oa, const std::vector<const Tech*>& techs,
+                             const std::map<std::string, TechCategory*>& categories,
+                             const std::set<std::string>& categories_seen);
+
 /** Deserializes \a universe from input archive \a ia. */
 FO_COMMON_API void Deserialize(freeorion_iarchive& ia, Universe& universe);
 
@@ -54,4 +84,24 @@ void Deserialize(freeorion_iarchive& ia, OrderSet& order_set);
 /** Deserializes \a pathing_engine from input archive \a ia. */
 void Deserialize(freeorion_iarchive& ia, PathingEngine& pathing_engine);
 
+/** Deserializes \a building_types from input archive \a ia. */
+FO_COMMON_API void Deserialize(freeorion_iarchive& ia, std::map<std::string, BuildingType*>& building_types);
+
+/** Deserializes \a species from input archive \a ia. */
+FO_COMMON_API void Deserialize(freeorion_iarchive& ia, std::map<std::string, Species*>& species);
+
+/** Deserializes \a parts from input archive \a ia. */
+FO_COMMON_API void Deserialize(freeorion_iarchive& ia, std::map<std::string, PartType*>& parts);
+
+/** Deserializes \a hulls from input archive \a ia. */
+FO_COMMON_API void Deserialize(freeorion_iarchive& ia, std::map<std::string, HullType*>& hulls);
+
+/** Deserializes \a designs from input archive \a ia. */
+FO_COMMON_API void Deserialize(freeorion_iarchive& ia, std::map<std::string, ShipDesign*>& designs);
+
+/** Deserializes \a techs, \a categories and \a categories_seen from input archive \a ia. */
+FO_COMMON_API void Deserialize(freeorion_iarchive& ia, std::vector<const Tech*>& techs,
+                               std::map<std::string, TechCategory*>& categories,
+                               std::set<std::string>& categories_seen);
+
 #endif // _Serialize_h_
@@ -0,0 +1,276 @@
+#include "Serialize.h"
+
+#include "Serialize.ipp"
+
+#include "../universe/Building.h"
+#include "../universe/Condition.h"
+#include "../universe/Effect.h"
+#include "../universe/ShipDesign.h"
+#include "../universe/Species.h"
+#include "../universe/Tech.h"
+#include "../universe/ValueRef.h"
+
+#include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/variant.hpp>
+
+// exports for boost serialization of polymorphic ValueRef hierarchy
+#define EXPORT_VALUE_REFS(T, NAME)                                                                  \
+    typedef ValueRef::Constant<T> Constant##NAME;                                                   \
+    typedef ValueRef::Variable<T> Variable##NAME;                                                   \
+    typedef ValueRef::Statistic<T> Statistic##NAME;                                                 \
+    BOOST_CLASS_EXPORT_GUID(Constant##NAME, "ValueRef::Constant<" #NAME ">")                        \
+    BOOST_CLASS_EXPORT_GUID(Variable##NAME, "ValueRef::Variable<" #NAME ">")                        \
+    BOOST_CLASS_EXPORT_GUID(Statistic##NAME, "ValueRef::Statistic<" #NAME ">")
+
+EXPORT_VALUE_REFS(int, int)
+EXPORT_VALUE_REFS(double, double)
+EXPORT_VALUE_REFS(std::string, string)
+EXPORT_VALUE_REFS(PlanetSize, PlanetSize)
+EXPORT_VALUE_REFS(PlanetType, PlanetType)
+EXPORT_VALUE_REFS(PlanetEnvironment, PlanetEnvironment)
+EXPORT_VALUE_REFS(StarType, StarType)
+EXPORT_VALUE_REFS(UniverseObjectType, UniverseObjectType)
+
+#undef EXPORT_VALUE_REFS
+
+typedef ValueRef::ComplexVariable<int> ComplexVariableint;
+typedef ValueRef::Operation<int> Operationint;
+typedef ValueRef::Operation<double> Operationdouble;
+typedef ValueRef::StaticCast<int, double> StaticCastintdouble;
+typedef ValueRef::StringCast<int> StringCastint;
+typedef ValueRef::StringCast<double> StringCastdouble;
+BOOST_CLASS_EXPORT_GUID(ComplexVariableint, "ValueRef::ComplexVariable<int>")
+BOOST_CLASS_EXPORT_GUID(Operationint, "ValueRef::Operation<int>")
+BOOST_CLASS_EXPORT_GUID(Operationdouble, "ValueRef::Operation<double>")
+BOOST_CLASS_EXPORT_GUID(StaticCastintdouble, "ValueRef::StaticCast<int, double>")
+BOOST_CLASS_EXPORT_GUID(StringCastint, "ValueRef::StringCast<int>")
+BOOST_CLASS_EXPORT_GUID(StringCastdouble, "ValueRef::StringCast<double>")
+BOOST_CLASS_EXPORT(ValueRef::UserStringLookup)
+
+// exports for boost serialization of polymorphic Condition hierarchy
+BOOST_CLASS_EXPORT(Condition::Number)
+BOOST_CLASS_EXPORT(Condition::Turn)
+BOOST_CLASS_EXPORT(Condition::SortedNumberOf)
+BOOST_CLASS_EXPORT(Condition::All)
+BOOST_CLASS_EXPORT(Condition::EmpireAffiliation)
+BOOST_CLASS_EXPORT(Condition::Source)
+BOOST_CLASS_EXPORT(Condition::RootCandidate)
+BOOST_CLASS_EXPORT(Condition::Target)
+BOOST_CLASS_EXPORT(Condition::Homeworld)
+BOOST_CLASS_EXPORT(Condition::Capital)
+BOOST_CLASS_EXPORT(Condition::Monster)
+BOOST_CLASS_EXPORT(Condition::Armed)
+BOOST_CLASS_EXPORT(Condition::Type)
+BOOST_CLASS_EXPORT(Condition::Building)
+BOOST_CLASS_EXPORT(Condition::HasSpecial)
+BOOST_CLASS_EXPORT(Condition::HasTag)
+BOOST_CLASS_EXPORT(Condition::CreatedOnTurn)
+BOOST_CLASS_EXPORT(Condition::Contains)
+BOOST_CLASS_EXPORT(Condition::ContainedBy)
+BOOST_CLASS_EXPORT(Condition::InSystem)
+BOOST_CLASS_EXPORT(Condition::ObjectID)
+BOOST_CLASS_EXPORT(Condition::PlanetType)
+BOOST_CLASS_EXPORT(Condition::PlanetSize)
+BOOST_CLASS_EXPORT(Condition::PlanetEnvironment)
+BOOST_CLASS_EXPORT(Condition::Species)
+BOOST_CLASS_EXPORT(Condition::Enqueued)
+BOOST_CLASS_EXPORT(Condition::FocusType)
+BOOST_CLASS_EXPORT(Condition::StarType)
+BOOST_CLASS_EXPORT(Condition::DesignHasHull)
+BOOST_CLASS_EXPORT(Condition::DesignHasPart)
+BOOST_CLASS_EXPORT(Condition::DesignHasPartClass)
+BOOST_CLASS_EXPORT(Condition::PredefinedShipDesign)
+BOOST_CLASS_EXPORT(Condition::NumberedShipDesign)
+BOOST_CLASS_EXPORT(Condition::ProducedByEmpire)
+BOOST_CLASS_EXPORT(Condition::Chance)
+BOOST_CLASS_EXPORT(Condition::MeterValue)
+BOOST_CLASS_EXPORT(Condition::ShipPartMeterValue)
+BOOST_CLASS_EXPORT(Condition::EmpireMeterValue)
+BOOST_CLASS_EXPORT(Condition::EmpireStockpileValue)
+BOOST_CLASS_EXPORT(Condition::OwnerHasTech)
+BOOST_CLASS_EXPORT(Condition::OwnerHasBuildingTypeAvailable)
+BOOST_CLASS_EXPORT(Condition::OwnerHasShipDesignAvailable)
+BOOST_CLASS_EXPORT(Condition::VisibleToEmpire)
+BOOST_CLASS_EXPORT(Condition::WithinDistance)
+BOOST_CLASS_EXPORT(Condition::WithinStarlaneJumps)
+BOOST_CLASS_EXPORT(Condition::ExploredByEmpire)
+BOOST_CLASS_EXPORT(Condition::Stationary)
+BOOST_CLASS_EXPORT(Condition::FleetSupplyableByEmpire)
+BOOST_CLASS_EXPORT(Condition::ResourceSupplyConnectedByEmpire)
+BOOST_CLASS_EXPORT(Condition::CanColonize)
+BOOST_CLASS_EXPORT(Condition::CanProduceShips)
+BOOST_CLASS_EXPORT(Condition::OrderedBombarded)
+BOOST_CLASS_EXPORT(Condition::ValueTest)
+BOOST_CLASS_EXPORT(Condition::Location)
+BOOST_CLASS_EXPORT(Condition::And)
+BOOST_CLASS_EXPORT(Condition::Or)
+BOOST_CLASS_EXPORT(Condition::Not)
+
+// exports for boost serialization of polymorphic Effect hierarchy
+BOOST_CLASS_EXPORT(Effect::SetMeter)
+BOOST_CLASS_EXPORT(Effect::SetShipPartMeter)
+BOOST_CLASS_EXPORT(Effect::SetEmpireMeter)
+BOOST_CLASS_EXPORT(Effect::SetEmpireStockpile)
+BOOST_CLASS_EXPORT(Effect::SetEmpireCapital)
+BOOST_CLASS_EXPORT(Effect::SetPlanetType)
+BOOST_CLASS_EXPORT(Effect::SetPlanetSize)
+BOOST_CLASS_EXPORT(Effect::SetSpecies)
+BOOST_CLASS_EXPORT(Effect::SetOwner)
+BOOST_CLASS_EXPORT(Effect::CreatePlanet)
+BOOST_CLASS_EXPORT(Effect::CreateBuilding)
+BOOST_CLASS_EXPORT(Effect::CreateShip)
+BOOST_CLASS_EXPORT(Effect::CreateField)
+BOOST_CLASS_EXPORT(Effect::CreateSystem)
+BOOST_CLASS_EXPORT(Effect::Destroy)
+BOOST_CLASS_EXPORT(Effect::AddSpecial)
+BOOST_CLASS_EXPORT(Effect::RemoveSpecial)
+BOOST_CLASS_EXPORT(Effect::AddStarlanes)
+BOOST_CLASS_EXPORT(Effect::RemoveStarlanes)
+BOOST_CLASS_EXPORT(Effect::SetStarType)
+BOOST_CLASS_EXPORT(Effect::MoveTo)
+BOOST_CLASS_EXPORT(Effect::MoveInOrbit)
+BOOST_CLASS_EXPORT(Effect::MoveTowards)
+BOOST_CLASS_EXPORT(Effect::SetDestination)
+BOOST_CLASS_EXPORT(Effect::SetAggression)
+BOOST_CLASS_EXPORT(Effect::Victory)
+BOOST_CLASS_EXPORT(Effect::SetEmpireTechProgress)
+BOOST_CLASS_EXPORT(Effect::GiveEmpireTech)
+BOOST_CLASS_EXPORT(Effect::GenerateSitRepMessage)
+BOOST_CLASS_EXPORT(Effect::SetOverlayTexture)
+BOOST_CLASS_EXPORT(Effect::SetTexture)
+
+
+namespace boost { namespace serialization {
+    template <class Archive>
+    void serialize(Archive& ar, ItemSpec& item_spec, const unsigned int version)
+    {
+        ar  & BOOST_SERIALIZATION_NVP(item_spec.type)
+            & BOOST_SERIALIZATION_NVP(item_spec.name);
+    }
+
+    template <class Archive>
+    void serialize(Archive& ar, TechCategory& category, const unsigned int version)
+    {
+        ar  & BOOST_SERIALIZATION_NVP(category.name)
+            & BOOST_SERIALIZATION_NVP(category.graphic)
+            & BOOST_SERIALIZATION_NVP(category.colour);
+    }
+
+    template <class Archive>
+    void serialize(Archive& ar, HullType::Slot& slot, const unsigned int version)
+    {
+        ar  & BOOST_SERIALIZATION_NVP(slot.type)
+            & BOOST_SERIALIZATION_NVP(slot.x)
+            & BOOST_SERIALIZATION_NVP(slot.y);
+    }
+} }
+
+template <class Archive>
+void Tech::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_NVP(m_name)
+        & BOOST_SERIALIZATION_NVP(m_description)
+        & BOOST_SERIALIZATION_NVP(m_short_description)
+        & BOOST_SERIALIZATION_NVP(m_category)
+        & BOOST_SERIALIZATION_NVP(m_type)
+        & BOOST_SERIALIZATION_NVP(m_research_cost)
+        & BOOST_SERIALIZATION_NVP(m_research_turns)
+        & BOOST_SERIALIZATION_NVP(m_researchable)
+        & BOOST_SERIALIZATION_NVP(m_effects)
+        & BOOST_SERIALIZATION_NVP(m_prerequisites)
+        & BOOST_SERIALIZATION_NVP(m_unlocked_items)
+        & BOOST_SERIALIZATION_NVP(m_graphic);
+}
+
+template <class Archive>
+void FocusType::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_NVP(m_name)
+        & BOOST_SERIALIZATION_NVP(m_description)
+        & BOOST_SERIALIZATION_NVP(m_location)
+        & BOOST_SERIALIZATION_NVP(m_graphic);
+}
+
+template <class Archive>
+void Species::serialize(Archive& ar, const unsigned int version)
+{
+    // only the content parsed from species definitions; homeworlds and
+    // opinions are game state, and are serialized by SpeciesManager
+    ar  & BOOST_SERIALIZATION_NVP(m_name)
+        & BOOST_SERIALIZATION_NVP(m_description)
+        & BOOST_SERIALIZATION_NVP(m_gameplay_description)
+        & BOOST_SERIALIZATION_NVP(m_foci)
+        & BOOST_SERIALIZATION_NVP(m_preferred_focus)
+        & BOOST_SERIALIZATION_NVP(m_planet_environments)
+        & BOOST_SERIALIZATION_NVP(m_effects)
+        & BOOST_SERIALIZATION_NVP(m_playable)
+        & BOOST_SERIALIZATION_NVP(m_native)
+        & BOOST_SERIALIZATION_NVP(m_can_colonize)
+        & BOOST_SERIALIZATION_NVP(m_can_produce_ships)
+        & BOOST_SERIALIZATION_NVP(m_tags)
+        & BOOST_SERIALIZATION_NVP(m_graphic);
+}
+
+template <class Archive>
+void BuildingType::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & BOOST_SERIALIZATION_NVP(m_name)
+        & BOOST_SERIALIZATION_NVP(m_description)
+        & BOOST_SERIALIZATION_NVP(m_production_cost)
+        & BOOST_SERIALIZATION_NVP(m_production_time)
+        & BOOST_SERIALIZATION_NVP(m_producible)
+        & BOOST_SERIALIZATION_NVP(m_capture_result)
+        & BOOST_SERIALIZATION_NVP(m_tags)
+        & BOOST_SERIALIZATION_NVP(m_location)
+        & BOOST_SERIALIZATION_NVP(m_enqueue_location)
+        & BOOST_SERIALIZATION_NVP(m_effects)
+        & BOOST_SERIALIZATION_NVP(m_icon);
+}
+
+void Serialize(freeorion_oarchive& oa, const std::map<std::string, BuildingType*>& building_types)
+{ oa << BOOST_SERIALIZATION_NVP(building_types); }
+
+void Serialize(freeorion_oarchive& oa, const std::map<std::string, Species*>& species)
+{ oa << BOOST_SERIALIZATION_NVP(species); }
+
+void Serialize(freeorion_oarchive& oa, const std::map<std::string, PartType*>& parts)
+{ oa << BOOST_SERIALIZATION_NVP(parts); }
+
+void Serialize(freeorion_oarchive& oa, const std::map<std::string, HullType*>& hulls)
+{ oa << BOOST_SERIALIZATION_NVP(hulls); }
+
+void Serialize(freeorion_oarchive& oa, const std::map<std::string, ShipDesign*>& designs)
+{ oa << BOOST_SERIALIZATION_NVP(designs); }
+
+void Serialize(freeorion_oarchive& oa, const std::vector<const Tech*>& techs,
+               const std::map<std::string, TechCategory*>& categories,
+               const std::set<std::string>& categories_seen)
+{
+    oa  << BOOST_SERIALIZATION_NVP(techs)
+        << BOOST_SERIALIZATION_NVP(categories)
+        << BOOST_SERIALIZATION_NVP(categories_seen);
+}
+
+void Deserialize(freeorion_iarchive& ia, std::map<std::string, BuildingType*>& building_types)
+{ ia >> BOOST_SERIALIZATION_NVP(building_types); }
+
+void Deserialize(freeorion_iarchive& ia, std::map<std::string, Species*>& species)
+{ ia >> BOOST_SERIALIZATION_NVP(species); }
+
+void Deserialize(freeorion_iarchive& ia, std::map<std::string, PartType*>& parts)
+{ ia >> BOOST_SERIALIZATION_NVP(parts); }
+
+void Deserialize(freeorion_iarchive& ia, std::map<std::string, HullType*>& hulls)
+{ ia >> BOOST_SERIALIZATION_NVP(hulls); }
+
+void Deserialize(freeorion_iarchive& ia, std::map<std::string, ShipDesign*>& designs)
+{ ia >> BOOST_SERIALIZATION_NVP(designs); }
+
+void Deserialize(freeorion_iarchive& ia, std::vector<const Tech*>& techs,
+                 std::map<std::string, TechCategory*>& categories,
+                 std::set<std::string>& categories_seen)
+{
+    ia  >> BOOST_SERIALIZATION_NVP(techs)
+        >> BOOST_SERIALIZATION_NVP(categories)
+        >> BOOST_SERIALIZATION_NVP(categories_seen);
+}
@@ -19,7 +19,8 @@ BOOST_CLASS_EXPORT(Planet)
 BOOST_CLASS_EXPORT(Building)
 BOOST_CLASS_EXPORT(Fleet)
 BOOST_CLASS_EXPORT(Ship)
-BOOST_CLASS_VERSION(Ship, 1)
+BOOST_CLASS_VERSION(Ship, 2)
+BOOST_CLASS_VERSION(UniverseObject, 1)
 //BOOST_CLASS_EXPORT(ShipDesign)
 //BOOST_CLASS_VERSION(ShipDesign, 1)
 
@@ -50,14 +51,15 @@ void Universe::serialize(Archive& ar, const unsigned int version)
 
     if (Archive::is_saving::value) {
         Logger().debugStream() << "Universe::serialize : Getting gamestate data";
-        GetObjectsToSerialize(              objects,                            m_encoding_empire);
-        GetDestroyedObjectsToSerialize(     destroyed_object_ids,               m_encoding_empire);
-        GetEmpireKnownObjectsToSerialize(   empire_latest_known_objects,        m_encoding_empire);
-        GetEmpireObjectVisibilityMap(       empire_object_visibility,           m_encoding_empire);
-        GetEmpireObjectVisibilityTurnMap(   empire_object_visibility_turns,     m_encoding_empire);
-        GetEmpireKnownDestroyedObjects(     empire_known_destroyed_object_ids,  m_encoding_empire);
-        GetEmpireStaleKnowledgeObjects(     empire_stale_knowledge_object_ids,  m_encoding_empire);
-        GetShipDesignsToSerialize(          ship_designs,                       m_encoding_empire);
+        int encoding_empire = EncodingEmpire();
+        GetObjectsToSerialize(              objects,                            encoding_empire);
+        GetDestroyedObjectsToSerialize(     destroyed_object_ids,               encoding_empire);
+        GetEmpireKnownObjectsToSerialize(   empire_latest_known_objects,        encoding_empire);
+        GetEmpireObjectVisibilityMap(       empire_object_visibility,           encoding_empire);
+        GetEmpireObjectVisibilityTurnMap(   empire_object_visibility_turns,     encoding_empire);
+        GetEmpireKnownDestroyedObjects(     empire_known_destroyed_object_ids,  encoding_empire);
+        GetEmpireStaleKnowledgeObjects(     empire_stale_knowledge_object_ids,  encoding_empire);
+        GetShipDesignsToSerialize(          ship_designs,                       encoding_empire);
     }
 
     if (Archive::is_loading::value) {
@@ -101,8 +103,9 @@ void Universe::serialize(Archive& ar, const unsigned int version)
         m_objects.swap(objects);
         m_destroyed_object_ids.swap(destroyed_object_ids);
         m_empire_latest_known_objects.swap(empire_latest_known_objects);
-        m_empire_object_visibility.swap(empire_object_visibility);
-        m_empire_object_visibility_turns.swap(empire_object_visibility_turns);
+        MarkSharedEmpireKnownObjects();
+        m_empire_object_visibility.FromMap(empire_object_visibility);
+        m_empire_object_visibility_turns.FromMap(empire_object_visibility_turns);
         m_empire_known_destroyed_object_ids.swap(empire_known_destroyed_object_ids);
         m_empire_stale_knowledge_object_ids.swap(empire_stale_knowledge_object_ids);
         m_ship_designs.swap(ship_designs);
@@ -119,6 +122,58 @@ void Universe::serialize(Archive& ar, const unsigned int version)
     }
 }
 
+namespace {
+    /** Serializes \a meters as their number followed by the type and Meter
+      * of each, directly from and into the MeterMap. */
+    template <class Archive>
+    void SerializeMeters(Archive& ar, MeterMap& meters) {
+        int num_meters = static_cast<int>(meters.Size());
+        ar  & BOOST_SERIALIZATION_NVP(num_meters);
+        if (Archive::is_saving::value) {
+            for (MeterType type = MeterType(0); type != NUM_METER_TYPES; type = MeterType(type + 1)) {
+                if (Meter* meter = meters.Get(type)) {
+                    ar  & boost::serialization::make_nvp("type", type)
+                        & boost::serialization::make_nvp("meter", *meter);
+                }
+            }
+        } else {
+            meters.Clear();
+            for (int i = 0; i < num_meters; ++i) {
+                MeterType type = INVALID_METER_TYPE;
+                ar  & boost::serialization::make_nvp("type", type);
+                ar  & boost::serialization::make_nvp("meter", meters[type]);
+            }
+        }
+    }
+
+    /** Serializes \a meters as their number followed by the type, part name
+      * and Meter of each.  Part names are written, as part name ids differ
+      * between runs of the program. */
+    template <class Archive>
+    void SerializePartMeters(Archive& ar, PartMeterMap& meters) {
+        int num_meters = static_cast<int>(meters.Size());
+        ar  & BOOST_SERIALIZATION_NVP(num_meters);
+        if (Archive::is_saving::value) {
+            for (PartMeterMap::iterator it = meters.begin(); it != meters.end(); ++it) {
+                MeterType type = it->first.first;
+                std::string part_name = PartNameFromID(it->first.second);
+                ar  & boost::serialization::make_nvp("type", type)
+                    & boost::serialization::make_nvp("part_name", part_name)
+                    & boost::serialization::make_nvp("meter", it->second);
+            }
+        } else {
+            meters = PartMeterMap();
+            for (int i = 0; i < num_meters; ++i) {
+                MeterType type = INVALID_METER_TYPE;
+                std::string part_name;
+                ar  & boost::serialization::make_nvp("type", type)
+                    & boost::serialization::make_nvp("part_name", part_name);
+                ar  & boost::serialization::make_nvp("meter", meters.Add(type, part_name));
+            }
+        }
+    }
+}
+
 template <class Archive>
 void UniverseObject::serialize(Archive& ar, const unsigned int version)
 {
@@ -128,9 +183,16 @@ void UniverseObject::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_y)
         & BOOST_SERIALIZATION_NVP(m_owner_empire_id)
         & BOOST_SERIALIZATION_NVP(m_system_id)
-        & BOOST_SERIALIZATION_NVP(m_specials)
-        & BOOST_SERIALIZATION_NVP(m_meters)
-        & BOOST_SERIALIZATION_NVP(m_created_on_turn);
+        & BOOST_SERIALIZATION_NVP(m_specials);
+    if (version >= 1) {
+        SerializeMeters(ar, m_meters);
+    } else {
+        // older saves have the meters as a map
+        std::map<MeterType, Meter> meters;
+        ar  & boost::serialization::make_nvp("m_meters", meters);
+        m_meters.FromMap(meters);
+    }
+    ar  & BOOST_SERIALIZATION_NVP(m_created_on_turn);
 }
 
 template <class Archive>
@@ -214,9 +276,16 @@ void Ship::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_ordered_invade_planet_id)
         & BOOST_SERIALIZATION_NVP(m_ordered_bombard_planet_id)
         & BOOST_SERIALIZATION_NVP(m_fighters)
-        & BOOST_SERIALIZATION_NVP(m_missiles)
-        & BOOST_SERIALIZATION_NVP(m_part_meters)
-        & BOOST_SERIALIZATION_NVP(m_species_name)
+        & BOOST_SERIALIZATION_NVP(m_missiles);
+    if (version >= 2) {
+        SerializePartMeters(ar, m_part_meters);
+    } else {
+        // older saves have the part meters as a map
+        std::map<std::pair<MeterType, std::string>, Meter> part_meters;
+        ar  & boost::serialization::make_nvp("m_part_meters", part_meters);
+        m_part_meters.FromMap(part_meters);
+    }
+    ar  & BOOST_SERIALIZATION_NVP(m_species_name)
         & BOOST_SERIALIZATION_NVP(m_produced_by_empire_id);
     if (version >= 1) {
         ar  & BOOST_SERIALIZATION_NVP(m_last_turn_active_in_combat);
@@ -240,6 +309,14 @@ void ShipDesign::serialize(Archive& ar, const unsigned int version)
         BuildStatCaches();
 }
 
+// explicit template initialization of ShipDesign::serialize, which is also
+// used by SerializeContent.cpp to cache premade and monster ship designs
+template
+void ShipDesign::serialize<freeorion_oarchive>(freeorion_oarchive& ar, const unsigned int version);
+
+template
+void ShipDesign::serialize<freeorion_iarchive>(freeorion_iarchive& ar, const unsigned int version);
+
 // explicit template initialization of System::serialize needed to avoid bug with GCC 4.5.2.
 template
 void SpeciesManager::serialize<freeorion_oarchive>(freeorion_oarchive& ar, const unsigned int version);